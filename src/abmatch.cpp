@@ -0,0 +1,151 @@
+/************************************************************
+* Plays computer A against computer B, each set up as the game sets up
+* its computer with -d and -p, to find out with as few games as it can
+* whether A is better. Both decide every move as the game's computer
+* does, with Computer::move() and getCardToDiscard(), so a match compares
+* difficulties (the searches, DiscardScorer, the opponent model, the
+* endgame solver) as well as strategies (see strategy.h). Deals are
+* played in batches across every core, each deal from both seats (see
+* selfPlay.h), and a sequential probability ratio test on the pairs'
+* score differences (see sprt.h) stops the match as soon as it's decided.
+* Above difficulty 0 the computers think until a deadline, so give such
+* matches a core per thread (-j) or they play weaker than in the game.
+* Games are scored and won by the game's rules (see winnerOf()).
+*
+* Usage: abmatch [-a setup] [-b setup] [-m margin] [-e alpha] [-f beta]
+*                [-n pairs] [-k pairs] [-s seed] [-j threads]
+*    -a setup        computer A, "difficulty=D,name=value,..." with the
+*                    difficulty 0 to 3 as the game's -d and the strategy's
+*                    parameters as its -p (default: the game's defaults,
+*                    difficulty 0)
+*    -b setup        computer B, as above
+*    -m margin       points a game A must score less to be better
+*                    (default: 2)
+*    -e alpha        chance of wrongly finding A better (default: 0.05)
+*    -f beta         chance of wrongly finding A no better (default: 0.05)
+*    -n pairs        most deals to play before giving up (default: 20000)
+*    -k pairs        deals per batch between checks (default: 100)
+*    -s seed         seed of the deals (default: 1)
+*    -j threads      number of threads to use (default: one per core)
+*
+* Exits with 0 if A is better, 1 if it's no better, and 2 if the match
+* ran out of deals first.
+************************************************************/
+
+#include "selfPlay.h"
+#include "sprt.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+   ComputerSetup setups[2];
+   double margin = 2;
+   double alpha = 0.05;
+   double beta = 0.05;
+   int maxPairs = 20000;
+   int batch = 100;
+   unsigned seed = 1;
+   unsigned threads = 0;
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if ((argument == "-a" || argument == "-b") && i + 1 < argc && !setups[argument == "-b"].parse(argv[i + 1]))
+      {
+         i++;
+      }
+      else if (argument == "-m" && i + 1 < argc)
+      {
+         margin = std::atof(argv[++i]);
+      }
+      else if (argument == "-e" && i + 1 < argc)
+      {
+         alpha = std::atof(argv[++i]);
+      }
+      else if (argument == "-f" && i + 1 < argc)
+      {
+         beta = std::atof(argv[++i]);
+      }
+      else if (argument == "-n" && i + 1 < argc)
+      {
+         maxPairs = std::atoi(argv[++i]);
+      }
+      else if (argument == "-k" && i + 1 < argc)
+      {
+         batch = std::max(1, std::atoi(argv[++i]));
+      }
+      else if (argument == "-s" && i + 1 < argc)
+      {
+         seed = std::strtoul(argv[++i], nullptr, 10);
+      }
+      else if (argument == "-j" && i + 1 < argc)
+      {
+         threads = std::atoi(argv[++i]);
+      }
+      else
+      {
+         std::cerr << "Usage: " << argv[0] << " [-a setup] [-b setup] [-m margin] [-e alpha] [-f beta] [-n pairs] [-k pairs]"
+            << " [-s seed] [-j threads]\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   if (margin <= 0 || alpha <= 0 || alpha >= 1 || beta <= 0 || beta >= 1)
+   {
+      std::cerr << "The margin must be above 0, and alpha and beta between 0 and 1\n";
+      return EXIT_FAILURE;
+   }
+
+   std::cout << "A: " << setups[0].toString() << "\n";
+   std::cout << "B: " << setups[1].toString() << "\n";
+
+   SelfPlay play(setups[0], setups[1]);
+   Sprt test(margin, alpha, beta);
+   int games = 0;
+   int wins = 0;
+   int losses = 0;
+   int draws = 0;
+   double seconds = 0;
+
+   // Each batch deals from its own seed, so no deal is played twice
+   Sprt::Decision decision = Sprt::Decision::CONTINUE;
+   for (unsigned b = 0; decision == Sprt::Decision::CONTINUE && test.count() < maxPairs; b++)
+   {
+      SelfPlay::MatchResult match = play.playMatch(std::min(batch, maxPairs - test.count()), seed + b, threads);
+      games += match.games;
+      wins += match.wins;
+      losses += match.losses;
+      draws += match.draws;
+      seconds += match.seconds;
+
+      for (double difference : match.pairDifferences)
+      {
+         test.add(difference);
+      }
+      decision = test.decide();
+
+      std::cout << std::fixed << std::setprecision(2) << games << " games: A " << wins << "-" << losses << "-" << draws
+         << ", A less B " << test.mean() << " +/- " << test.standardDeviation() / std::sqrt(std::max(test.count(), 1))
+         << " points a game, LLR " << test.logLikelihoodRatio() << " [" << test.lowerBound() << ", " << test.upperBound() << "], "
+         << games / seconds << " games/s\n";
+   }
+
+   switch (decision)
+   {
+      case Sprt::Decision::ACCEPT_H1:
+         std::cout << "A is better than B (tested for a margin of " << margin << " points a game)\n";
+         return 0;
+      case Sprt::Decision::ACCEPT_H0:
+         std::cout << "A is not better than B (tested for a margin of " << margin << " points a game)\n";
+         return 1;
+      default:
+         std::cout << "Undecided after " << games << " games\n";
+         return 2;
+   }
+}
@@ -0,0 +1,342 @@
+#include "anytimeSearch.h"
+#include "gameState.h"   // deadwoodScore()
+#include <algorithm>     // std::swap
+#include <limits>        // std::numeric_limits
+
+/* *********************************************************************
+Function Name: AnytimeSearch()
+Purpose: Create a search that stops at a deadline
+Parameters:
+         int round, the round (to know the wild card)
+         steady_clock::time_point deadline, when to stop sampling
+         const atomic<bool> *cancel, stops the search early when set
+            (may be null)
+         unsigned seed, the seed the samples are drawn with
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the round, an evaluator for it, the deadline, and the
+            cancel flag
+         2) Seed the generator
+Assistance Received: none
+********************************************************************* */
+AnytimeSearch::AnytimeSearch(int round, std::chrono::steady_clock::time_point deadline, const std::atomic<bool> *cancel, unsigned seed)
+   : round(round), evaluator(round), table(&SolutionTable::shared()), deadline(deadline), cancel(cancel), generator(seed)
+{
+}
+
+/* *********************************************************************
+Function Name: shouldDrawFromDiscard()
+Purpose: Check if the hand should draw the top of the discard pile
+Parameters:
+         const Hand &hand, the cards in the hand before drawing
+         const Card &topOfDiscard, the card on top of the discard pile
+         bool &decided, set to false if there was no time to sample
+Return Value: a bool, true if the discard pile should be drawn from
+Local Variables:
+         unsigned char ids[], the hand's card ids with room for the draw
+         int size, the number of cards in the hand
+         int discardScore, what's left after drawing the top of the
+            discard pile and making the best discard
+         long long deckTotal, the total left over every deck sample
+         int deckSamples, the number of deck samples
+Algorithm:
+         1) Score drawing the top of the discard pile, which is known
+         2) Until out of time, sample a card from the deck and score it
+         3) Draw from the discard pile if it leaves no more than the
+            deck's average
+Assistance Received: none
+********************************************************************* */
+bool AnytimeSearch::shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard, bool &decided)
+{
+   unsigned char ids[Hand::MAX_CARDS];
+   int size = 0;
+   for (const Card &card : hand)
+   {
+      ids[size++] = card.getId();
+   }
+
+   ids[size] = topOfDiscard.getId();
+   int discardScore = bestDiscardScore(ids, size + 1);
+
+   findUnseen(hand, topOfDiscard);
+
+   long long deckTotal = 0;
+   int deckSamples = 0;
+   while (!outOfTime() && this->unseenCount > 0)
+   {
+      ids[size] = drawUnseen();
+      deckTotal += bestDiscardScore(ids, size + 1);
+      deckSamples++;
+   }
+
+   decided = deckSamples > 0;
+   return decided && static_cast<long long>(discardScore) * deckSamples <= deckTotal;
+}
+
+/* *********************************************************************
+Function Name: chooseDiscard()
+Purpose: Find the card to discard from the hand
+Parameters:
+         const Hand &hand, the cards in the hand after drawing
+         const Card &topOfDiscard, the card on top of the discard pile
+            before discarding
+         const float *discardCost, points added to discarding each card
+            id (may be null)
+Return Value: an int, the index in the hand of the card to discard, -1
+   if there was no time to decide
+Local Variables:
+         int size, the number of cards in the hand
+         int candidates[], the index of the first copy of each card
+         int candidateCount, the number of different cards
+         long long totals[], the total left over every sample for each
+            discard
+         unsigned char kept[], the hand without a discard, with room for
+            the next draw
+         int iterations, the number of samples scored for every discard
+         double expected[], the average left by each discard plus its
+            cost
+Algorithm:
+         1) Take any discard that goes out
+         2) Until out of time, sample the next card drawn and score every
+            discard with it, so each discard is compared on the same cards
+         3) Return the discard with the least average plus its cost,
+            breaking ties by what's left right away
+Assistance Received: none
+********************************************************************* */
+int AnytimeSearch::chooseDiscard(const Hand &hand, const Card &topOfDiscard, const float *discardCost)
+{
+   int size = hand.size();
+   int candidates[Hand::MAX_CARDS];
+   int candidateCount = 0;
+   for (int i = 0; i < size; i++)
+   {
+      if (hand.indexOf(hand[i].getId()) == i)
+      {
+         candidates[candidateCount++] = i;
+      }
+   }
+
+   // The hand without each discard
+   unsigned char kept[Hand::MAX_CARDS][Hand::MAX_CARDS];
+   int immediate[Hand::MAX_CARDS];
+   for (int c = 0; c < candidateCount; c++)
+   {
+      int keptSize = 0;
+      for (int i = 0; i < size; i++)
+      {
+         if (i != candidates[c])
+         {
+            kept[c][keptSize++] = hand[i].getId();
+         }
+      }
+
+      immediate[c] = deadwoodScore(kept[c], keptSize, this->round);
+      if (immediate[c] == 0)
+      {
+         return candidates[c];
+      }
+   }
+
+   findUnseen(hand, topOfDiscard);
+
+   long long totals[Hand::MAX_CARDS] = { 0 };
+   int iterations = 0;
+   while (this->unseenCount > 0)
+   {
+      int card = drawUnseen();
+      long long scores[Hand::MAX_CARDS];
+      for (int c = 0; c < candidateCount; c++)
+      {
+         if (outOfTime())
+         {
+            break;
+         }
+
+         kept[c][size - 1] = card;
+         scores[c] = bestDiscardScore(kept[c], size);
+      }
+
+      // Only count samples every discard was scored on
+      if (outOfTime())
+      {
+         break;
+      }
+
+      for (int c = 0; c < candidateCount; c++)
+      {
+         totals[c] += scores[c];
+      }
+      iterations++;
+   }
+
+   if (iterations == 0)
+   {
+      return -1;
+   }
+
+   double expected[Hand::MAX_CARDS];
+   for (int c = 0; c < candidateCount; c++)
+   {
+      expected[c] = static_cast<double>(totals[c]) / iterations;
+      if (discardCost != nullptr)
+      {
+         expected[c] += discardCost[hand[candidates[c]].getId()];
+      }
+   }
+
+   int best = 0;
+   for (int c = 1; c < candidateCount; c++)
+   {
+      if (expected[c] < expected[best] || (expected[c] == expected[best] && immediate[c] < immediate[best]))
+      {
+         best = c;
+      }
+   }
+
+   return candidates[best];
+}
+
+/* *********************************************************************
+Function Name: getSamples()
+Purpose: Get the number of cards sampled so far
+Parameters:
+         none
+Return Value: an int, the number of samples
+Local Variables:
+         none
+Algorithm:
+         1) Return the count
+Assistance Received: none
+********************************************************************* */
+int AnytimeSearch::getSamples() const
+{
+   return this->samples;
+}
+
+/* *********************************************************************
+Function Name: outOfTime()
+Purpose: Check if the search has to stop
+Parameters:
+         none
+Return Value: a bool, true if the deadline passed or it was cancelled
+Local Variables:
+         none
+Algorithm:
+         1) Check the cancel flag, then the clock
+Assistance Received: none
+********************************************************************* */
+bool AnytimeSearch::outOfTime() const
+{
+   if (this->cancel != nullptr && *this->cancel)
+   {
+      return true;
+   }
+
+   return std::chrono::steady_clock::now() >= this->deadline;
+}
+
+/* *********************************************************************
+Function Name: findUnseen()
+Purpose: Find the cards the computer can't see
+Parameters:
+         const Hand &hand, the computer's hand
+         const Card &topOfDiscard, the card on top of the discard pile
+Return Value: none
+Local Variables:
+         int copies[], the copies of each card left
+Algorithm:
+         1) Start with two of every card
+         2) Take out the cards in the hand and on top of the discard pile
+         3) List a copy of every card left
+Assistance Received: none
+********************************************************************* */
+void AnytimeSearch::findUnseen(const Hand &hand, const Card &topOfDiscard)
+{
+   int copies[Card::NUMBER_OF_IDS];
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      copies[id] = COPIES_OF_EACH_CARD;
+   }
+
+   for (const Card &card : hand)
+   {
+      copies[card.getId()]--;
+   }
+
+   if (topOfDiscard.getId() >= 0)
+   {
+      copies[topOfDiscard.getId()]--;
+   }
+
+   this->unseenCount = 0;
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      for (int copy = 0; copy < copies[id]; copy++)
+      {
+         this->unseen[this->unseenCount++] = id;
+      }
+   }
+}
+
+/* *********************************************************************
+Function Name: drawUnseen()
+Purpose: Pick one of the unseen cards at random
+Parameters:
+         none
+Return Value: an int, the id of the card
+Local Variables:
+         none
+Algorithm:
+         1) Pick a card uniformly and count the sample
+Assistance Received: none
+********************************************************************* */
+int AnytimeSearch::drawUnseen()
+{
+   this->samples++;
+   return this->unseen[this->generator() % this->unseenCount];
+}
+
+/* *********************************************************************
+Function Name: bestDiscardScore()
+Purpose: Find the least left in a hand after discarding its best card
+Parameters:
+         unsigned char ids[], the card ids of the hand, reordered while
+            searching but put back before returning
+         int size, the number of cards
+Return Value: an int, the value of the cards left after the best discard
+Local Variables:
+         int index, the best discard in the solution table
+         int best, the least left so far
+Algorithm:
+         1) Look the hand up if the solution table covers it
+         2) Otherwise, for each card, swap it to the end and score the
+            rest, keeping the least and stopping early when a discard
+            goes out
+Assistance Received: none
+********************************************************************* */
+int AnytimeSearch::bestDiscardScore(unsigned char ids[], int size) const
+{
+   int index;
+   int best;
+   if (this->table->bestDiscard(ids, size, this->round, index, best))
+   {
+      return best;
+   }
+
+   best = std::numeric_limits<int>::max();
+   for (int i = 0; i < size && best > 0; i++)
+   {
+      std::swap(ids[i], ids[size - 1]);
+      int score = this->evaluator.deadwood(ids, size - 1);
+      std::swap(ids[i], ids[size - 1]);
+
+      if (score < best)
+      {
+         best = score;
+      }
+   }
+
+   return best;
+}
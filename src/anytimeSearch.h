@@ -0,0 +1,95 @@
+#ifndef ANYTIMESEARCH_H
+#define ANYTIMESEARCH_H
+
+#include "hand.h"
+#include "meldEvaluator.h"
+#include "solutionTable.h"
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::steady_clock
+#include <random>      // std::mt19937
+
+// How well the computer plays, as the time it may take for each decision
+// HEURISTIC is the rule of thumb it always used, answered right away
+enum class Difficulty {
+   HEURISTIC = 0,
+   EASY,
+   MEDIUM,
+   HARD
+};
+
+// Time the computer may take for each decision at a difficulty
+inline std::chrono::milliseconds getBudget(Difficulty difficulty)
+{
+   switch (difficulty)
+   {
+      case Difficulty::EASY:
+         return std::chrono::milliseconds(10);
+      case Difficulty::MEDIUM:
+         return std::chrono::milliseconds(100);
+      case Difficulty::HARD:
+         return std::chrono::milliseconds(1000);
+      default:
+         return std::chrono::milliseconds(0);
+   }
+}
+
+// Finds the computer's draw and discard by sampling the cards it could draw
+// next, until a deadline. Each sample is a card the computer can't see
+// (anything not in its hand or on top of the discard pile), and a choice is
+// scored by the cards left after drawing it and making the best discard
+// (found exactly by MeldEvaluator, which is fast enough to sample with).
+// More time means more samples and a better estimate; the best choice so far
+// is returned when the deadline passes, so a decision never takes much
+// longer than its budget.
+class AnytimeSearch
+{
+   public:
+      // Search until the deadline, or until cancel is set if it's given
+      AnytimeSearch(int round, std::chrono::steady_clock::time_point deadline, const std::atomic<bool> *cancel = nullptr, unsigned seed = 0);
+
+      // Check if the hand should draw the top of the discard pile: drawing
+      // it must leave no more than drawing from the deck is expected to
+      // Sets decided to false if there was no time for a single sample
+      bool shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard, bool &decided);
+
+      // Find the index in the hand (after drawing) of the card to discard, the
+      // one leaving the least expected after the next draw. discardCost, if
+      // given, adds points to discarding each card id (what it's expected to
+      // give the other player). A discard that goes out is taken right away.
+      // Returns -1 if there was no time to decide
+      int chooseDiscard(const Hand &hand, const Card &topOfDiscard, const float *discardCost = nullptr);
+
+      // Number of cards sampled so far
+      int getSamples() const;
+
+   private:
+      // Copies of each card in the two decks
+      static const int COPIES_OF_EACH_CARD = 2;
+
+      // Check if the deadline passed or the search was cancelled
+      bool outOfTime() const;
+
+      // Find the cards the computer can't see
+      void findUnseen(const Hand &hand, const Card &topOfDiscard);
+
+      // Pick one of the unseen cards at random
+      int drawUnseen();
+
+      // The least left in a hand (of size cards) after discarding its best card
+      int bestDiscardScore(unsigned char ids[], int size) const;
+
+      int round;
+      MeldEvaluator evaluator;
+      const SolutionTable *table;
+      std::chrono::steady_clock::time_point deadline;
+      const std::atomic<bool> *cancel;
+      std::mt19937 generator;
+
+      // Ids of the cards the computer can't see, one entry for each copy
+      unsigned char unseen[COPIES_OF_EACH_CARD * Card::NUMBER_OF_IDS];
+      int unseenCount = 0;
+
+      int samples = 0;
+};
+
+#endif
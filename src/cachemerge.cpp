@@ -0,0 +1,86 @@
+/************************************************************
+* Merges evaluation caches (see evaluationCache.h) into one, the single
+* writer of the cache processes read. Run it offline: the merged file is
+* written beside the output and renamed over it, so a process mapping
+* the old file keeps reading it until it opens the cache again.
+*
+* Usage: cachemerge [-o file] cache...
+*    -o file   the cache to merge into (default: fivecrowns.fce, which
+*              is where the game looks for it); what it holds is kept
+*    cache     caches to merge, such as those saved by replay -c.
+*              Caches made under other rules are skipped
+************************************************************/
+
+#include "evaluationCache.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+   std::string output = EvaluationCache::DEFAULT_FILE_NAME;
+   std::vector<std::string> inputs;
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if (argument == "-o" && i + 1 < argc)
+      {
+         output = argv[++i];
+      }
+      else
+      {
+         inputs.push_back(argument);
+      }
+   }
+
+   if (inputs.empty())
+   {
+      std::cerr << "Usage: " << argv[0] << " [-o file] cache...\n";
+      return EXIT_FAILURE;
+   }
+
+   std::unordered_map<std::uint64_t, EvaluationCache::Entry> entries;
+
+   // Keep what the output already holds, unless it's from other rules
+   EvaluationCache cache;
+   if (!cache.open(output))
+   {
+      cache.collect(entries);
+      std::cout << output << ": " << cache.size() << " entries\n";
+   }
+
+   int skipped = 0;
+   for (const std::string &input : inputs)
+   {
+      if (cache.open(input))
+      {
+         std::cerr << input << ": could not be read as a cache made under these rules, skipped\n";
+         skipped++;
+         continue;
+      }
+
+      size_t before = entries.size();
+      cache.collect(entries);
+      std::cout << input << ": " << cache.size() << " entries, " << entries.size() - before << " new\n";
+   }
+   cache.close();
+
+   if (EvaluationCache::save(entries, output))
+   {
+      std::cerr << "Could not write " << output << "\n";
+      return EXIT_FAILURE;
+   }
+
+   std::cout << "Wrote " << output << ": " << entries.size() << " entries";
+   if (skipped > 0)
+   {
+      std::cout << ", " << skipped << " caches skipped";
+   }
+   std::cout << "\n";
+
+   return EXIT_SUCCESS;
+}
@@ -1,5 +1,15 @@
 #include "card.h"
 
+// The value of each card
+const std::map<std::string, int> Card::valueOfCard =
+{
+   { "3", 3 }, { "4", 4 }, { "5", 5 }, { "6", 6 }, { "7", 7 },
+   { "8", 8 }, { "9", 9}, { "X", 10 }, { "J", 11 }, { "Q", 12 }, { "K", 13 }
+};
+
+// Characters of each suit and number in id order
+const char Card::SUIT_CHARACTERS[] = "SCDHT";
+const char Card::NUMBER_CHARACTERS[] = "3456789XJQK";
 
 /* *********************************************************************
 Function Name: Card()
@@ -14,6 +24,7 @@ Local Variables:
          none
 Algorithm:
          1) Assign all member variables to the variables passed in
+         2) Look up the card's id
 Assistance Received: none
 ********************************************************************* */
 Card::Card(std::string number, std::string suit, int value, bool wild)
@@ -22,6 +33,7 @@ Card::Card(std::string number, std::string suit, int value, bool wild)
    this->suit = suit;
    this->value = value;
    this->wild = wild;
+   this->id = idFromString(number + suit);
 }
 
 /* *********************************************************************
@@ -43,6 +55,7 @@ Algorithm:
             and assign member variable int value
          5) Check if the card is a wild card or joker and
             assign member variable bool wild
+         6) Look up the card's id
 Assistance Received: none
 ********************************************************************* */
 Card::Card(std::string card, int round)
@@ -51,7 +64,7 @@ Card::Card(std::string card, int round)
    std::string suit = card.substr(1, 1);
    this->number = number;
    this->suit = suit;
-   this->value = this->valueOfCard[number];
+   this->value = this->valueOfCard.at(number);
 
    // Check if card is a wild card
    // It can't be a joker
@@ -69,6 +82,7 @@ Card::Card(std::string card, int round)
       this->wild = true;
    }
 
+   this->id = idFromString(cardString);
 }
 
 /* *********************************************************************
@@ -235,7 +249,97 @@ Algorithm:
          1) Return WILD_CARD_OFFSET
 Assistance Received: none
 ********************************************************************* */
-const int Card::getWildCardOffset()
+int Card::getWildCardOffset()
 {
    return WILD_CARD_OFFSET;
+}
+
+/* *********************************************************************
+Function Name: getId()
+Purpose: Get the id of the card, a number from 0 to 57
+Parameters:
+         none
+Return Value: a const int, the id of the card, -1 for a blank card
+Local Variables:
+         none
+Algorithm:
+         1) Return member variable id
+Assistance Received: none
+********************************************************************* */
+int Card::getId() const
+{
+   return this->id;
+}
+
+/* *********************************************************************
+Function Name: idFromString()
+Purpose: Convert a card string (i.e. "5C" or "J2") to its id
+Parameters:
+         string_view card, the card to convert (a string or a token of
+            a game file, without copying it)
+Return Value: an int, the id of the card, -1 if it isn't a card
+Local Variables:
+         const char *suit, the suit character in SUIT_CHARACTERS
+         const char *number, the number character in NUMBER_CHARACTERS
+Algorithm:
+         1) If the string isn't two characters, it isn't a card
+         2) If it's J1, J2, or J3, it's a joker; jokers come after
+            every other card
+         3) Otherwise find the suit and number characters and
+            return suit * 11 + number
+Assistance Received: none
+********************************************************************* */
+int Card::idFromString(std::string_view card)
+{
+   if (card.length() != 2)
+   {
+      return -1;
+   }
+
+   // Jokers
+   if (card[0] == 'J' && card[1] >= '1' && card[1] <= '3')
+   {
+      return FIRST_JOKER_ID + (card[1] - '1');
+   }
+
+   const char *suit = std::char_traits<char>::find(SUIT_CHARACTERS, NUMBER_OF_SUITS, card[1]);
+   const char *number = std::char_traits<char>::find(NUMBER_CHARACTERS, NUMBER_OF_NUMBERS, card[0]);
+
+   if (suit == nullptr || number == nullptr)
+   {
+      return -1;
+   }
+
+   return (suit - SUIT_CHARACTERS) * NUMBER_OF_NUMBERS + (number - NUMBER_CHARACTERS);
+}
+
+/* *********************************************************************
+Function Name: fromId()
+Purpose: Create the card with the given id for the round
+Parameters:
+         int id, the id of the card
+         int round, the current round (to know the wild card)
+Return Value: a Card, the card with the id
+Local Variables:
+         string cardString, the string of the card (i.e. "5C")
+Algorithm:
+         1) Build the card string from the id
+         2) Create the card from the string and round
+Assistance Received: none
+********************************************************************* */
+Card Card::fromId(int id, int round)
+{
+   std::string cardString;
+
+   if (id >= FIRST_JOKER_ID)
+   {
+      cardString = "J" + std::to_string(id - FIRST_JOKER_ID + 1);
+   }
+   else
+   {
+      cardString += NUMBER_CHARACTERS[id % NUMBER_OF_NUMBERS];
+      cardString += SUIT_CHARACTERS[id / NUMBER_OF_NUMBERS];
+   }
+
+   return Card(cardString, round);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <map>
 
 class Card
@@ -32,7 +33,27 @@ class Card
 
       std::string toString() const;
 
-      static const int getWildCardOffset();
+      static int getWildCardOffset();
+
+      // Get the id of the card, a number from 0 to 57 (-1 for a blank card)
+      // Suits and numbers are laid out like the table in CombinationFinder
+      // (suit * 11 + number) and the three jokers come last
+      int getId() const;
+
+      // Convert a card string (i.e. "5C" or "J2") to its id
+      // Returns -1 if the string is not a card
+      static int idFromString(std::string_view card);
+
+      // Create the card with the given id for the round
+      static Card fromId(int id, int round);
+
+      // Number of different cards (5 suits * 11 numbers + 3 jokers)
+      static const int NUMBER_OF_IDS = 58;
+
+      // Number of suits and numbers, and the id of the first joker
+      static const int NUMBER_OF_SUITS = 5;
+      static const int NUMBER_OF_NUMBERS = 11;
+      static const int FIRST_JOKER_ID = NUMBER_OF_SUITS * NUMBER_OF_NUMBERS;
 
       friend std::ostream& operator<<(std::ostream& os, const Card& card);
 
@@ -49,15 +70,18 @@ class Card
       // whether or not it's a wild card (or a joker since it can act as one)
       bool wild = false;                  
 
+      // card id (see getId())
+      int id = -1;
+
       // the round number + wild card offset (2) is the number of a wild card
       static const int WILD_CARD_OFFSET = 2;   
       
-      // The value of each card                           
-      std::map<std::string, int> valueOfCard =
-      {
-         { "3", 3 }, { "4", 4 }, { "5", 5 }, { "6", 6 }, { "7", 7 },
-         { "8", 8 }, { "9", 9}, { "X", 10 }, { "J", 11 }, { "Q", 12 }, { "K", 13 }
-      };
+      // The value of each card, shared by every card
+      static const std::map<std::string, int> valueOfCard;
+
+      // Characters of each suit and number in id order
+      static const char SUIT_CHARACTERS[];
+      static const char NUMBER_CHARACTERS[];
 };
 
 
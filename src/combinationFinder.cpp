@@ -4,10 +4,46 @@
 Function Name: CombinationFinder()
 Purpose: Constructor that takes in a vector of cards to analyze for
    combinations. 
-hash table in CombinationFinder
 Parameters:
-         a vector<Card>, cards to analyze for books and runs, as well
-         as remaining cards after analysis
+         const vector<Card> &cards, cards to analyze for books and runs,
+         as well as remaining cards after analysis
+Return Value: The CombinationFinder object
+Local Variables:
+         none
+Algorithm:
+         1) Analyze the cards from the first card to the last
+Assistance Received: none
+********************************************************************* */
+CombinationFinder::CombinationFinder(const std::vector<Card> &cards)
+   : CombinationFinder(cards.data(), cards.data() + cards.size())
+{
+}
+
+/* *********************************************************************
+Function Name: CombinationFinder()
+Purpose: Constructor that takes in a hand to analyze for combinations
+Parameters:
+         const Hand &hand, the hand to analyze for books and runs,
+         as well as remaining cards after analysis
+Return Value: The CombinationFinder object
+Local Variables:
+         none
+Algorithm:
+         1) Analyze the cards from the first card to the last
+Assistance Received: none
+********************************************************************* */
+CombinationFinder::CombinationFinder(const Hand &hand)
+   : CombinationFinder(hand.begin(), hand.end())
+{
+}
+
+/* *********************************************************************
+Function Name: CombinationFinder()
+Purpose: Constructor that takes in a range of cards to analyze for
+   combinations. 
+Parameters:
+         const Card *first, the first card to analyze
+         const Card *last, one past the last card to analyze
 Return Value: The CombinationFinder object
 Local Variables:
          none
@@ -17,15 +53,16 @@ Algorithm:
          2) Set vector of cards to member variable
          3) Separate wild cards from jokers to their own vectors
          4) Populate the table with non-wild cards
+         5) Remember the table and wild cards before making combinations
 Assistance Received: none
 ********************************************************************* */
-CombinationFinder::CombinationFinder(std::vector<Card> cards)
+CombinationFinder::CombinationFinder(const Card *first, const Card *last)
 {
    // Initialize maps that map indices to strings
    initializeMaps();
 
    // Store cards to member variable
-   this->cards = cards;
+   this->cards.assign(first, last);
 
    // Separate wild cards and jokers
    separateWildCards();
@@ -37,6 +74,97 @@ CombinationFinder::CombinationFinder(std::vector<Card> cards)
       //printTable();
    }
 
+   // Remember the starting state so findBestCombinations() can reuse it
+   std::copy(&this->table[0][0], &this->table[0][0] + SUITS * NUMBERS, &this->initialTable[0][0]);
+   this->initialWildCards = this->wildCards;
+}
+
+/* *********************************************************************
+Function Name: findBestCombinations()
+Purpose: Find all combinations books first and runs first from the same
+   table and keep the arrangement that leaves the fewest single cards
+Parameters:
+         float booksFirstBias, how many fewer single cards books first
+            must leave to be kept (0 by default)
+Return Value: an Order, the order that was chosen
+Local Variables:
+         vector<vector<Card>> booksFirstBooks, the books made books first
+         vector<vector<Card>> booksFirstRuns, the runs made books first
+         vector<Card> booksFirstSingles, the single cards left books first
+         vector<Card> booksFirstPartials, the partial cards left books first
+         vector<Card> booksFirstWilds, the wild cards left books first
+         vector<Card> booksFirstRemaining, the remaining cards books first
+Algorithm:
+         1) Find combinations books first
+         2) Move the books first arrangement aside
+         3) Reset the table and wild cards to their initial state
+         4) Find combinations runs first
+         5) If books first left less single cards, less the bias, move
+            that arrangement back and return BOOKS_FIRST
+         6) Otherwise keep the runs first arrangement (runs win ties
+            unless the bias is above 0) and return RUNS_FIRST
+Assistance Received: none
+********************************************************************* */
+CombinationFinder::Order CombinationFinder::findBestCombinations(float booksFirstBias)
+{
+   // Make books first and set the arrangement aside
+   findCombinations(Order::BOOKS_FIRST);
+
+   std::vector<std::vector<Card>> booksFirstBooks = std::move(this->books);
+   std::vector<std::vector<Card>> booksFirstRuns = std::move(this->runs);
+   std::vector<Card> booksFirstSingles = std::move(this->singleCards);
+   std::vector<Card> booksFirstPartials = std::move(this->partialCards);
+   std::vector<Card> booksFirstWilds = std::move(this->wildCards);
+   std::vector<Card> booksFirstRemaining = std::move(this->remainingCards);
+
+   // Make runs first from the same starting table
+   resetCombinations();
+   findCombinations(Order::RUNS_FIRST);
+
+   // If there are less single cards with books than runs, keep books first
+   if (booksFirstSingles.size() < this->singleCards.size() + booksFirstBias)
+   {
+      this->books = std::move(booksFirstBooks);
+      this->runs = std::move(booksFirstRuns);
+      this->singleCards = std::move(booksFirstSingles);
+      this->partialCards = std::move(booksFirstPartials);
+      this->wildCards = std::move(booksFirstWilds);
+      this->remainingCards = std::move(booksFirstRemaining);
+
+      return Order::BOOKS_FIRST;
+   }
+
+   // If there are an equal number of single cards, choose runs
+   return Order::RUNS_FIRST;
+}
+
+/* *********************************************************************
+Function Name: resetCombinations()
+Purpose: Restore the table and wild cards to their initial state and
+   clear every combination found so far
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Copy the initial table over the table
+         2) Restore the wild cards
+         3) Clear the hash tables and every vector of cards made
+Assistance Received: none
+********************************************************************* */
+void CombinationFinder::resetCombinations()
+{
+   std::copy(&this->initialTable[0][0], &this->initialTable[0][0] + SUITS * NUMBERS, &this->table[0][0]);
+   this->wildCards = this->initialWildCards;
+
+   this->completeCombinations.clear();
+   this->partialCombinations.clear();
+   this->books.clear();
+   this->runs.clear();
+   this->singleCards.clear();
+   this->partialCards.clear();
+   this->remainingCards.clear();
 }
 
 /* *********************************************************************
@@ -114,7 +242,7 @@ void CombinationFinder::findCombinations(Order combinationOrder)
       {
          std::vector<Card> wildBook = this->wildCards;
          
-         this->wildCards.empty();
+         this->wildCards.clear();
          this->books.push_back(wildBook);
       }
    }
@@ -1404,14 +1532,14 @@ Function Name: getBooks()
 Purpose: Return a copy of the member variable vector of books 
 Parameters:
          none
-Return Value: a const vector<vector<Card>>, the vector of books made
+Return Value: a const reference to vector<vector<Card>>, the books made
 Local Variables:
          none
 Algorithm:
          1) Return the member variable books
 Assistance Received: none
 ********************************************************************* */
-std::vector<std::vector<Card>> CombinationFinder::getBooks() const
+const std::vector<std::vector<Card>>& CombinationFinder::getBooks() const
 {
    return this->books;
 }
@@ -1421,14 +1549,14 @@ Function Name: getRuns()
 Purpose: Return a copy of the member variable vector of runs
 Parameters:
          none
-Return Value: a const vector<vector<Card>>, the vector of runs made
+Return Value: a const reference to vector<vector<Card>>, the runs made
 Local Variables:
          none
 Algorithm:
          1) Return the member variable runs
 Assistance Received: none
 ********************************************************************* */
-std::vector<std::vector<Card>> CombinationFinder::getRuns() const
+const std::vector<std::vector<Card>>& CombinationFinder::getRuns() const
 {
    return this->runs;
 }
@@ -1438,19 +1566,57 @@ Function Name: retrieveRemainingCards()
 Purpose: Return the cards remaining from making combinations
 Parameters:
          none
-Return Value: a const vector<vector<Card>>, the vector of runs made
+Return Value: a const reference to vector<Card>, the remaining cards
 Local Variables:
          none
 Algorithm:
-         1) Return the member variable runs
+         1) Return the member variable remainingCards
 Assistance Received: none
 ********************************************************************* */
-// Return the cards remaining from making combinations
-std::vector<Card> CombinationFinder::retrieveRemainingCards() const
+const std::vector<Card>& CombinationFinder::retrieveRemainingCards() const
 {
    return this->remainingCards;
 }
 
+/* *********************************************************************
+Function Name: takeResult()
+Purpose: Move the books, runs, and remaining cards out of the finder
+   into a MeldResult (need to make combinations first)
+Parameters:
+         none
+Return Value: a MeldResult, the arrangement of the cards
+Local Variables:
+         MeldResult result, the result to return
+Algorithm:
+         1) Count the wild cards used in books and runs
+         2) Add the value of each remaining card to the deadwood score
+         3) Move books, runs, and remaining cards into the result
+         4) Return the result
+Assistance Received: none
+********************************************************************* */
+MeldResult CombinationFinder::takeResult()
+{
+   MeldResult result;
+
+   // Count wild cards used in books and runs
+   for (const std::vector<Card> &book : this->books)
+   {
+      result.wildsUsed += std::count_if(book.begin(), book.end(), [](const Card &card) { return card.isWild(); });
+   }
+   for (const std::vector<Card> &run : this->runs)
+   {
+      result.wildsUsed += std::count_if(run.begin(), run.end(), [](const Card &card) { return card.isWild(); });
+   }
+
+   result.deadwoodScore = getScore();
+
+   result.books = std::move(this->books);
+   result.runs = std::move(this->runs);
+   result.deadwood = std::move(this->remainingCards);
+
+   return result;
+}
+
 /* *********************************************************************
 Function Name: findWorstCard()
 Purpose: Find the least valuable card in the hand
@@ -5,6 +5,8 @@
 #include "run.h"
 #include "partialBook.h"
 #include "partialRun.h"
+#include "meldResult.h"
+#include "hand.h"
 #include <unordered_map>   // for storing combinations
 #include <set>             // for retrieving unique cards from a combination
 #include <memory>	   // smart pointers
@@ -17,7 +19,13 @@ class CombinationFinder
       ~CombinationFinder() = default;
 
       // Overloaded constructor
-      CombinationFinder(std::vector<Card> cards);
+      CombinationFinder(const std::vector<Card> &cards);
+
+      // Overloaded constructor that analyzes the cards in a hand
+      CombinationFinder(const Hand &hand);
+
+      // Overloaded constructor that analyzes the cards from first up to last
+      CombinationFinder(const Card *first, const Card *last);
 
       // Specifies which combinations we will make first
       enum class Order {
@@ -33,17 +41,28 @@ class CombinationFinder
       int getNumberOfSingleCards() const;
 
       // Get the books
-      std::vector<std::vector<Card>> getBooks() const;
+      const std::vector<std::vector<Card>>& getBooks() const;
 
       // Get the runs
-      std::vector<std::vector<Card>> getRuns() const;
+      const std::vector<std::vector<Card>>& getRuns() const;
 
       // Return the cards remaining from making combinations
-      std::vector<Card> retrieveRemainingCards() const;
+      const std::vector<Card>& retrieveRemainingCards() const;
+
+      // Move the books, runs, and remaining cards out of the finder into a MeldResult
+      // The finder should not be used for anything else afterwards
+      MeldResult takeResult();
 
       // Find all combinations
       void findCombinations(Order combinationOrder);
 
+      // Find all combinations books first and runs first from the same table
+      // and keep the arrangement that leaves the fewest single cards
+      // Books first has to leave booksFirstBias fewer to be kept, so runs
+      // win ties unless it's above 0 (see Strategy)
+      // Returns the order that was chosen
+      Order findBestCombinations(float booksFirstBias = 0);
+
       // Get score of cards
       int getScore();
 
@@ -67,6 +86,10 @@ class CombinationFinder
       // The table to store the amount of each cards remaining in the hand
       int table[5][11] = { 0 };
 
+      // The table as it was built from the cards passed in, before any combinations
+      // were made, so both orders can be evaluated without rebuilding it
+      int initialTable[5][11] = { 0 };
+
       // Enum to distinguish type of hash map
       enum class hashMapType {
          UNDEFINED = 0,
@@ -80,6 +103,9 @@ class CombinationFinder
       // Wild cards and jokers
       std::vector<Card> wildCards;
 
+      // Wild cards and jokers before any combinations were made
+      std::vector<Card> initialWildCards;
+
       // Books and runs make from cards passed into constructor
       std::vector<std::vector<Card>> books;
       std::vector<std::vector<Card>> runs;
@@ -128,6 +154,10 @@ class CombinationFinder
       // Populate the table with non-wild cards
       void populateTheTable();
 
+      // Restore the table and wild cards to their initial state and clear
+      // every combination found so far
+      void resetCombinations();
+
       // Create a card object from the current point in the table
       Card createCardFromTableIndex(int suitIndex, int numberIndex);
 
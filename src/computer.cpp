@@ -1,4 +1,6 @@
 #include "computer.h"
+#include <iomanip>   // std::setprecision
+#include <sstream>   // std::ostringstream
 
 /* *********************************************************************
 Function Name: chooseGameOption()
@@ -34,24 +36,59 @@ Parameters:
          none
 Return Value: a int, the choice the computer made
 Local Variables:
-         none
+         Action action, the endgame search's draw
+         string reason, why it chose it
+         PonderedReply reply, the reply worked out during the human's turn
+         pair<bool, string> drawAndReason, whether to draw from the
+         discard pile and why
 Algorithm:
-         1) Check if the card at the top of the discard pile leaves
-         you with less than or equal remaining cards from making
-         combinations, than your current hand
-         2) If it doesn't, draw from draw pile
+         1) Stop pondering. At the end of the round, search it (see
+         solveEndgame())
+         2) Otherwise use the reply to the top of the discard pile worked
+         out while pondering, if it was (its discard only if the human
+         drew from the deck, as it assumed, keyed on the hand after
+         drawing the top of the discard pile)
+         3) Otherwise decide within the difficulty's time budget (see
+         chooseDraw())
+         4) Print the choice and why
 Assistance Received: none
 ********************************************************************* */
 int Computer::move()
 {
-   CombinationFinder::Order order = bestOrder(this->hand);
-   CombinationFinder comboFinder(this->hand);
-   comboFinder.findCombinations(order);
+   stopPondering();
+   this->ponderedDiscard.clear();
+
+   Action action;
+   std::string reason;
+   PonderedReply reply;
+   std::pair<bool, std::string> drawAndReason;
+   if (solveEndgame(action, reason))
+   {
+      drawAndReason = { action.type == Action::Type::DRAW_DISCARD, reason };
+   }
+   else if (this->ponder.find(this->hand, this->topOfDiscard, reply))
+   {
+      drawAndReason = { reply.drawDiscard, reply.drawReason };
 
-   if (shouldDrawFromDiscard())
+      // The discard was worked out for the human drawing from the deck, and
+      // for this hand with the top of the discard pile drawn
+      if (!this->opponent.tookDiscardLastTurn() && !reply.discard.empty())
+      {
+         this->ponderedDiscard = reply.discard;
+         this->ponderedReason = reply.reason;
+         this->ponderedHand = handIds(this->hand);
+         this->ponderedHand.push_back(this->topOfDiscard.getId());
+      }
+   }
+   else
+   {
+      drawAndReason = chooseDraw(this->hand, this->topOfDiscard, this->difficulty, nullptr, this->strategy);
+   }
+
+   if (drawAndReason.first)
    {
       std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
-      std::cout << "The computer chose to draw from the discard pile because\nthe discard card did not increase the number single cards in the hand\n";
+      std::cout << "The computer chose to draw from the discard pile because\n" << drawAndReason.second << "\n";
       std::cout << "--------------------------------------------------------------------------------------------------------------------\n\n";
 
       return static_cast<int>(Player::moveOption::DRAW_DISCARD);
@@ -59,7 +96,7 @@ int Computer::move()
    else
    {
       std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
-      std::cout << "The computer chose to draw from the drawing pile because\nthe discard card increased the number single cards in the hand\n";
+      std::cout << "The computer chose to draw from the drawing pile because\n" << drawAndReason.second << "\n";
       std::cout << "--------------------------------------------------------------------------------------------------------------------\n\n";
 
       return static_cast<int>(Player::moveOption::DRAW_DECK);
@@ -71,40 +108,80 @@ int Computer::move()
 Function Name: help()
 Purpose: Find out what move the Human should make
 Parameters:
-         vector<Card> hand, the cards in the hand
-         Card discardCard, the card at the top of discard pile,
+         const Hand &hand, the cards in the hand
+         const Card &discardCard, the card at the top of discard pile,
          Computer::Help helpType, an enum denoting the type of help
 Return Value: none
 Local Variables:
-         a Computer object, used to call the Computer's function
-         using the hand and discard card passed in
+         none
 Algorithm:
-         1) Check if computer was asked for help in drawing a card
-         2) If yes, create a Computer object to find out the best order to make
-         books and runs in
-         3) 
-         4) Print its suggestion
+         1) Work out the help
+         2) Print its suggestion
 Assistance Received: none
 ********************************************************************* */
-void Computer::help(std::vector<Card> hand, Card discardCard, Computer::Help helpType)
+void Computer::help(const Hand &hand, const Card &discardCard, Computer::Help helpType)
 {
+   printHint(findHint(hand, discardCard, helpType));
+}
+
+/* *********************************************************************
+Function Name: findHint()
+Purpose: Work out what move the Human should make without printing it
+Parameters:
+         const Hand &hand, the cards in the hand
+         const Card &discardCard, the card at the top of discard pile,
+         Computer::Help helpType, an enum denoting the type of help
+Return Value: a Hint, the suggestion
+Local Variables:
+         Hint hint, the suggestion being worked out
+         pair<string, string> worstCardandReason, the card to discard
+            and why
+Algorithm:
+         1) If asked for help drawing a card, check if the discard card
+         leaves the hand with no more single cards
+         2) If asked for help discarding, find the worst card in the hand
+         made into combinations in the best order
+Assistance Received: none
+********************************************************************* */
+Computer::Hint Computer::findHint(const Hand &hand, const Card &discardCard, Computer::Help helpType)
+{
+   Hint hint;
+   hint.type = helpType;
+
    if (helpType == Computer::Help::DRAW_HELP)
    {
-      // Temporary computer object to set its hand and discard card to the ones passed in
-      // so we can call Player and Computer methods
-      Computer tempComputer;
-
-      // Initialize object to have player's cards
-      tempComputer.setHand(hand);
-      tempComputer.setTopOfDiscard(discardCard);
+      // Check if we should draw from the discard pile or not
+      hint.drawDiscard = shouldDrawFromDiscard(hand, discardCard);
+   }
+   else if (helpType == Computer::Help::DISCARD_HELP)
+   {
+      // Find the worst card in the hand
+      std::pair<std::string, std::string> worstCardandReason = worstCard(hand);
+      hint.card = worstCardandReason.first;
+      hint.reason = worstCardandReason.second;
+   }
 
-      // Find the best order to make combinations in
-      CombinationFinder::Order order = tempComputer.bestOrder(tempComputer.hand);
-      CombinationFinder comboFinder(tempComputer.hand);
-      comboFinder.findCombinations(order);
+   return hint;
+}
 
-      // Check if we should draw from the discard pile or not
-      if (tempComputer.shouldDrawFromDiscard())
+/* *********************************************************************
+Function Name: printHint()
+Purpose: Print the computer's suggestion for the Human
+Parameters:
+         const Hint &hint, the suggestion
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Print which pile to draw from, or which card to discard and
+         why
+Assistance Received: none
+********************************************************************* */
+void Computer::printHint(const Hint &hint)
+{
+   if (hint.type == Computer::Help::DRAW_HELP)
+   {
+      if (hint.drawDiscard)
       {
          std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
          std::cout << "The computer suggests you chose to draw from the discard pile because\nthe discard card did not increase the number single cards in the hand\n";
@@ -120,26 +197,10 @@ void Computer::help(std::vector<Card> hand, Card discardCard, Computer::Help hel
       }
 
    }
-   else if (helpType == Computer::Help::DISCARD_HELP)
+   else if (hint.type == Computer::Help::DISCARD_HELP)
    {
-      Computer tempComputer;
-
-      // Initialize object to have player's cards
-      tempComputer.setHand(hand);
-      tempComputer.setTopOfDiscard(discardCard);
-
-      // Find the best order to make combinations in
-      CombinationFinder::Order order = tempComputer.bestOrder(tempComputer.hand);
-      CombinationFinder finder(tempComputer.hand);
-      finder.findCombinations(order);
-
-      // Find the worst card in the hand
-      std::pair<std::string, std::string> worstCardandReason = finder.findWorstCard();
-      std::string card = worstCardandReason.first;
-      std::string reason = worstCardandReason.second;
-
       std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
-      std::cout << "The computer suggests you remove " << card << " from its hand\nbecause " << reason << "\n";
+      std::cout << "The computer suggests you remove " << hint.card << " from its hand\nbecause " << hint.reason << "\n";
       std::cout << "--------------------------------------------------------------------------------------------------------------------\n\n";
    }   
 }
@@ -174,24 +235,41 @@ Parameters:
          none
 Return Value: a string, denoting the card to discard
 Local Variables:
-         none
+         Action action, the endgame search's discard
+         string reason, why it chose it
+         pair<string, string> worstCardandReason, the card and why
 Algorithm:
-         1) Create a CombinationFinder object
-         2) Find all combinations
-         3) Find the worst card of the remaining ones
+         1) At the end of the round, search it (see solveEndgame())
+         2) Otherwise use the discard worked out while pondering if the
+         hand after the draw is the one it was worked out for
+         3) Otherwise find the card to discard within the difficulty's
+         time budget, counting what each discard is likely to give the
+         human (see chooseDiscard())
          4) Return that card
 Assistance Received: none
 ********************************************************************* */
 // TODO: possibly change so that it does not remove wild cards if they are single cards
 std::pair<bool, std::string> Computer::getCardToDiscard()
 {
-   CombinationFinder::Order order = bestOrder(this->hand);
-   CombinationFinder finder(this->hand);
-   finder.findCombinations(order);
+   Action action;
+   std::string reason;
+   std::pair<std::string, std::string> worstCardandReason;
+   if (solveEndgame(action, reason))
+   {
+      worstCardandReason = { Card::fromId(action.card, this->gameState.round).toString(), reason };
+   }
+   else if (!this->ponderedDiscard.empty() && handIds(this->hand) == this->ponderedHand)
+   {
+      worstCardandReason = { this->ponderedDiscard, this->ponderedReason };
+   }
+   else
+   {
+      worstCardandReason = chooseDiscard(this->hand, this->topOfDiscard, this->difficulty, nullptr, &this->opponent);
+   }
+   this->ponderedDiscard.clear();
 
-   std::pair<std::string, std::string> worstCardandReason = finder.findWorstCard();
    std::string card = worstCardandReason.first;
-   std::string reason = worstCardandReason.second;
+   reason = worstCardandReason.second;
 
    std::cout << "--------------------------------------------------------------------------------------------------------------------\n";
    std::cout << "The computer removed " << card << " from its hand because " << reason << "\n";
@@ -228,10 +306,10 @@ Parameters:
 Return Value: a bool, denoting whether or not we should pick from the
 the discard pile
 Local Variables:
-         CombinationFinder::Order enum, the order we should
+         none
 Algorithm:
-         1) Get best order to make combinations in given current hand
-         2) Get best order to make combinations in given current hand
+         1) Make combinations in the computer's order with the current hand
+         2) Make combinations in the computer's order with the current hand
             plus the top of the discard pile
          3) Compare the number of single cards remaining from making all
             combinations in both sets of cards
@@ -243,45 +321,66 @@ Assistance Received: none
 ********************************************************************* */
 bool Computer::shouldDrawFromDiscard()
 {
-   // Get best order of combinations with current hand
-   CombinationFinder::Order order = bestOrder(this->hand);
-
-   // Get number of remaining cards with current hand
-   int currentSingleCards = numberOfSingleCards(this->hand, order);
-
-   // TEMP USE FOR CHECKING BUG
-   int remainingCards = numberOfRemainingCards(this->hand, order);
-   
-   // Get number of remaining cards with current hand + card on top of discard
-   std::vector<Card> handWithDiscard;
-   handWithDiscard.push_back(this->topOfDiscard);
-   handWithDiscard.insert(handWithDiscard.end(), this->hand.begin(), this->hand.end());
+   return shouldDrawFromDiscard(this->hand, this->topOfDiscard, this->strategy);
+}
 
-   // Get best order of combinations with hand plus discard card
-   CombinationFinder::Order discardOrder = bestOrder(handWithDiscard);
-   
-   // TEMP USE FOR CHECKING BUG
-   int remainingCardsWithDiscard = numberOfRemainingCards(handWithDiscard, discardOrder);
+/* *********************************************************************
+Function Name: shouldDrawFromDiscard()
+Purpose: Check if a hand should draw the top of the discard pile
+Parameters:
+         const Hand &hand, the cards in the hand
+         const Card &topOfDiscard, the card on top of the discard pile
+         const Strategy &strategy, the parameters of the rule of thumb
+Return Value: a bool, denoting whether or not we should pick from the
+the discard pile
+Local Variables:
+         none
+Algorithm:
+         1) Make combinations with and without the top of the discard
+            pile (see Strategy::shouldDrawFromDiscard())
+         2) By default, draw it if it doesn't leave more single cards
+Assistance Received: none
+********************************************************************* */
+bool Computer::shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard, const Strategy &strategy)
+{
+   return strategy.shouldDrawFromDiscard(hand, topOfDiscard);
+}
 
-   int singleCardsWithDiscard = numberOfSingleCards(handWithDiscard, discardOrder);
+/* *********************************************************************
+Function Name: shouldDrawFromDiscard()
+Purpose: Check if a hand should draw the top of the discard pile by
+   playing out both draws
+Parameters:
+         const Hand &hand, the cards in the hand
+         const Card &topOfDiscard, the card on top of the discard pile
+         int samples, the number of deck draws to play out
+         steady_clock::time_point deadline, when to stop playing out
+         RolloutEstimate &estimate, set to the points each draw is
+            expected to leave and the confidence interval
+         const atomic<bool> *cancel, stops early when set (may be null)
+Return Value: a bool, true if the discard pile should be drawn from
+Local Variables:
+         none
+Algorithm:
+         1) Play out the draws across every core (see RolloutEstimator),
+            seeded by the cards so the same hand decides the same way
+         2) Draw from the discard pile if it's expected to leave no more,
+            or by the rule of thumb if there was no time to play out any
+Assistance Received: none
+********************************************************************* */
+bool Computer::shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard, int samples,
+   std::chrono::steady_clock::time_point deadline, RolloutEstimate &estimate, const std::atomic<bool> *cancel)
+{
+   // A hand holds round + 2 cards before drawing
+   RolloutEstimator estimator(hand.size() - Card::getWildCardOffset());
+   estimate = estimator.estimate(hand, topOfDiscard, samples, searchSeed(hand, topOfDiscard), deadline, cancel);
 
-   // If we end up with the same amount of remaining cards or less, we should draw
-   // from the discard pile
-   if (currentSingleCards >= singleCardsWithDiscard)
+   if (estimate.samples == 0)
    {
-      return true;
+      return shouldDrawFromDiscard(hand, topOfDiscard);
    }
 
-   //TEMP FOR DEBUGGING
-   /*if (remainingCards >= remainingCardsWithDiscard)
-   {
-      return true;
-   }*/
-   //TEMP FOR DEBUGGING
-
-   // If we end up with more remaining cards, we are working backwards and should
-   // not draw from the discard pile
-   return false;
+   return estimate.drawDiscard;
 }
 
 /* *********************************************************************
@@ -289,7 +388,7 @@ Function Name: numberOfRemainingCards()
 Purpose: Return the number of remaining cards after making combinations 
    from the cards in the hand
 Parameters:
-         vector<Card> hand, the cards in the Player's hand
+         const vector<Card> &hand, the cards in the Player's hand
          CombinationFinder::Order combinationOrder, an enum denoting
             which order to find combinations in
 
@@ -304,7 +403,7 @@ Algorithm:
          2) Return the number of remaining cards
 Assistance Received: none
 ********************************************************************* */
-int Computer::numberOfRemainingCards(std::vector<Card> hand, CombinationFinder::Order combinationOrder)
+int Computer::numberOfRemainingCards(const std::vector<Card> &hand, CombinationFinder::Order combinationOrder)
 {
    // Make combinations using the cards and the order passed in
    CombinationFinder handFinder(hand);
@@ -319,7 +418,7 @@ Function Name: numberOfSingleCards()
 Purpose: Return the number of single cards after making combinations
    from vector of cards
 Parameters:
-         vector<Card> hand, the cards in the Player's hand
+         const vector<Card> &hand, the cards in the Player's hand
          CombinationFinder::Order combinationOrder, an enum denoting
             which order to find combinations in
 Return Value: an int, denoting the number of single cards 
@@ -333,11 +432,460 @@ Algorithm:
 Assistance Received: none
 ********************************************************************* */
 // Return the number of single cards after making combinations from vector of cards
-int Computer::numberOfSingleCards(std::vector<Card> hand, CombinationFinder::Order combinationOrder)
+int Computer::numberOfSingleCards(const std::vector<Card> &hand, CombinationFinder::Order combinationOrder)
 {
    CombinationFinder handFinder(hand);
    handFinder.findCombinations(combinationOrder);
 
    // Return number of cards left after making combinations
    return handFinder.getNumberOfSingleCards();
-}
\ No newline at end of file
+}
+
+/* *********************************************************************
+Function Name: worstCard()
+Purpose: Find the card a hand should discard
+Parameters:
+         const Hand &hand, the cards in the hand
+Return Value: a pair<string, string>, the card and the reason for it
+Local Variables:
+         none
+Algorithm:
+         1) Make combinations in the best order
+         2) Return the worst card of the remaining ones (see
+            Strategy::worstCard())
+Assistance Received: none
+********************************************************************* */
+std::pair<std::string, std::string> Computer::worstCard(const Hand &hand)
+{
+   return Strategy().worstCard(hand);
+}
+
+/* *********************************************************************
+Function Name: chooseDraw()
+Purpose: Decide whether a hand draws the top of the discard pile within
+   a difficulty's time budget
+Parameters:
+         const Hand &hand, the cards in the hand
+         const Card &topOfDiscard, the card on top of the discard pile
+         Difficulty difficulty, how long to think
+         const atomic<bool> *cancel, stops thinking early when set (may
+            be null)
+         const Strategy &strategy, the parameters of the rule of thumb
+Return Value: a pair<bool, string>, true to draw from the discard pile,
+   and why
+Local Variables:
+         RolloutEstimate estimate, what playing out both draws left
+         ostringstream reason, why the draw was chosen
+         AnytimeSearch search, samples the cards that could be drawn
+         bool decided, whether the search had time to sample
+         bool drawDiscard, the search's choice
+Algorithm:
+         1) With no budget, use the rule of thumb in
+            shouldDrawFromDiscard()
+         2) At HARD, play out both draws until the budget runs out
+         3) Otherwise sample until the budget runs out
+         4) Fall back on the rule of thumb if there was no time for a
+            single sample
+Assistance Received: none
+********************************************************************* */
+std::pair<bool, std::string> Computer::chooseDraw(const Hand &hand, const Card &topOfDiscard, Difficulty difficulty,
+   const std::atomic<bool> *cancel, const Strategy &strategy)
+{
+   if (difficulty == Difficulty::HARD)
+   {
+      RolloutEstimate estimate;
+      bool drawDiscard = shouldDrawFromDiscard(hand, topOfDiscard, ROLLOUT_SAMPLES,
+         std::chrono::steady_clock::now() + getBudget(difficulty), estimate, cancel);
+      if (estimate.samples > 0)
+      {
+         std::ostringstream reason;
+         reason << std::fixed << std::setprecision(2) << "over " << estimate.samples
+            << " played out draws, the discard card is expected to leave " << estimate.discardMean
+            << " points and the deck " << estimate.deckMean << " (difference " << estimate.difference
+            << " +/- " << estimate.halfWidth << ")";
+         return { drawDiscard, reason.str() };
+      }
+   }
+   else if (difficulty != Difficulty::HEURISTIC)
+   {
+      // A hand holds round + 2 cards before drawing
+      AnytimeSearch search(hand.size() - Card::getWildCardOffset(), std::chrono::steady_clock::now() + getBudget(difficulty),
+         cancel, searchSeed(hand, topOfDiscard));
+
+      bool decided;
+      bool drawDiscard = search.shouldDrawFromDiscard(hand, topOfDiscard, decided);
+      if (decided)
+      {
+         return { drawDiscard, drawDiscard ? "the discard card leaves no more points than drawing from the deck is expected to"
+            : "drawing from the deck is expected to leave fewer points than the discard card" };
+      }
+   }
+
+   if (shouldDrawFromDiscard(hand, topOfDiscard, strategy))
+   {
+      return { true, "the discard card did not increase the number single cards in the hand" };
+   }
+
+   return { false, "the discard card increased the number single cards in the hand" };
+}
+
+/* *********************************************************************
+Function Name: chooseDiscard()
+Purpose: Find the card a hand discards within a difficulty's time budget
+Parameters:
+         const Hand &hand, the cards in the hand after drawing
+         const Card &topOfDiscard, the card on top of the discard pile
+         Difficulty difficulty, how long to think
+         const atomic<bool> *cancel, stops thinking early when set (may
+            be null)
+         const OpponentModel *opponent, what the human is likely to hold
+            (may be null)
+Return Value: a pair<string, string>, the card and why
+Local Variables:
+         int round, the round
+         int deadwood, the least the hand can be left with
+         unsigned char ids[], int size, the hand's card ids
+         float cost[], the points discarding each card id costs
+         AnytimeSearch search, samples the cards that could be drawn next
+         int index, the index of the card chosen
+         float completion[], the probability each card id completes a
+            book or run for the human
+         DiscardScorer::Score best, the best discard by the scorer
+         ostringstream reason, why it was chosen
+Algorithm:
+         1) With a budget, sample until it runs out, counting the cost of
+            what each discard gives the human
+         2) Otherwise, or if there was no time to decide, score every
+            discard by what's left and what it gives the human in one
+            pass (see DiscardScorer)
+         3) Without a model of the human, take the discard leaving the
+            least: from the solution table for the first rounds, otherwise
+            by arranging the rest without each card (see bestDiscard(),
+            which keeps what it finds in the evaluation cache)
+Assistance Received: none
+********************************************************************* */
+std::pair<std::string, std::string> Computer::chooseDiscard(const Hand &hand, const Card &topOfDiscard, Difficulty difficulty,
+   const std::atomic<bool> *cancel, const OpponentModel *opponent)
+{
+   // A hand holds round + 3 cards after drawing
+   int round = hand.size() - Card::getWildCardOffset() - 1;
+
+   if (difficulty != Difficulty::HEURISTIC)
+   {
+      float cost[Card::NUMBER_OF_IDS];
+      if (opponent != nullptr)
+      {
+         DiscardScorer::feedingCosts(*opponent, hand, cost);
+      }
+
+      AnytimeSearch search(round, std::chrono::steady_clock::now() + getBudget(difficulty), cancel, searchSeed(hand, topOfDiscard));
+
+      int index = search.chooseDiscard(hand, topOfDiscard, opponent == nullptr ? nullptr : cost);
+      if (index != -1)
+      {
+         return { hand[index].toString(), opponent == nullptr ? "it was expected to leave the fewest points after the next draw"
+            : "it was expected to leave the fewest points after the next draw, counting what it would give the human" };
+      }
+   }
+
+   if (opponent != nullptr)
+   {
+      float completion[Card::NUMBER_OF_IDS];
+      opponent->completionProbabilities(hand, completion);
+
+      DiscardScorer::Score best = DiscardScorer(round).choose(hand, completion);
+      if (best.index != -1)
+      {
+         std::ostringstream reason;
+         reason << "it left " << best.deadwood << " points in the hand and had a " << static_cast<int>(best.completion * 100 + 0.5f)
+            << "% chance of completing one of the human's books or runs";
+         return { hand[best.index].toString(), reason.str() };
+      }
+   }
+
+   int index;
+   int deadwood;
+   if (SolutionTable::shared().bestDiscard(hand, round, index, deadwood))
+   {
+      return { hand[index].toString(), "it left the fewest points possible, " + std::to_string(deadwood) };
+   }
+
+   unsigned char ids[Hand::MAX_CARDS];
+   int size = 0;
+   for (const Card &card : hand)
+   {
+      ids[size++] = card.getId();
+   }
+
+   index = bestDiscard(ids, size, round, deadwood);
+   return { hand[index].toString(), "it left the fewest points after arranging the rest, " + std::to_string(deadwood) };
+}
+
+/* *********************************************************************
+Function Name: setDifficulty()
+Purpose: Set how long the computer may think about each decision
+Parameters:
+         Difficulty difficulty, the difficulty
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the difficulty
+Assistance Received: none
+********************************************************************* */
+void Computer::setDifficulty(Difficulty difficulty)
+{
+   this->difficulty = difficulty;
+}
+
+/* *********************************************************************
+Function Name: setStrategy()
+Purpose: Set the parameters of the computer's rule of thumb
+Parameters:
+         const Strategy &strategy, the parameters
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the strategy
+Assistance Received: none
+********************************************************************* */
+void Computer::setStrategy(const Strategy &strategy)
+{
+   this->strategy = strategy;
+}
+
+/* *********************************************************************
+Function Name: setGameState()
+Purpose: Let the computer see the game for the endgame search
+Parameters:
+         const GameState &state, the game with the computer to move
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the state for the next decision. The endgame search
+         deals the human's hand and the draw pile again, so only what the
+         computer can see is used
+Assistance Received: none
+********************************************************************* */
+void Computer::setGameState(const GameState &state)
+{
+   this->gameState = state;
+   this->hasGameState = true;
+}
+
+/* *********************************************************************
+Function Name: solveEndgame()
+Purpose: Search the end of the round for the computer's next action
+Parameters:
+         Action &action, set to the action found
+         string &reason, set to why it was chosen
+Return Value: a bool, false if this isn't the end of the round (or
+   there was no time to search), so the computer decides as usual
+Local Variables:
+         EndgameSolver solver, searches the deals of the unseen cards
+         double expected, the computer's score minus the human's expected
+         ostringstream why, the reason being written
+Algorithm:
+         1) Only search with a time budget, and only when few enough
+         cards are unseen in the state set by setGameState(), which is
+         used once
+         2) Search within the budget and explain the choice by how far
+         ahead or behind it leaves the computer
+Assistance Received: none
+********************************************************************* */
+bool Computer::solveEndgame(Action &action, std::string &reason)
+{
+   bool hasState = this->hasGameState;
+   this->hasGameState = false;
+   if (!hasState || this->difficulty == Difficulty::HEURISTIC || !EndgameSolver::isEndgame(this->gameState))
+   {
+      return false;
+   }
+
+   EndgameSolver solver(std::chrono::steady_clock::now() + getBudget(this->difficulty), nullptr,
+      static_cast<unsigned>(this->gameState.hash));
+
+   double expected;
+   if (!solver.solve(this->gameState, action, expected))
+   {
+      return false;
+   }
+
+   std::ostringstream why;
+   why << std::fixed << std::setprecision(2) << "searching the end of the round " << solver.getTurns()
+      << " turns ahead over " << EndgameSolver::DEALS << " deals of the cards it can't see, it is expected to leave the computer "
+      << (expected > 0 ? expected : -expected) << " points " << (expected > 0 ? "behind" : "ahead of") << " the human";
+   reason = why.str();
+
+   return true;
+}
+
+/* *********************************************************************
+Function Name: searchSeed()
+Purpose: Get the seed to sample a position with
+Parameters:
+         const Hand &hand, the cards in the hand
+         const Card &topOfDiscard, the card on top of the discard pile
+Return Value: an unsigned, the seed
+Local Variables:
+         unsigned seed, the seed so far
+Algorithm:
+         1) Mix the id of each card into the seed, so the same position
+            is always sampled the same way
+Assistance Received: none
+********************************************************************* */
+unsigned Computer::searchSeed(const Hand &hand, const Card &topOfDiscard)
+{
+   unsigned seed = topOfDiscard.getId() + 1;
+   for (const Card &card : hand)
+   {
+      seed = seed * 31 + card.getId();
+   }
+
+   return seed;
+}
+
+/* *********************************************************************
+Function Name: handIds()
+Purpose: Get the ids of the cards in a hand
+Parameters:
+         const Hand &hand, the hand
+Return Value: a vector<int>, the ids in the hand's order
+Local Variables:
+         vector<int> ids, the ids
+Algorithm:
+         1) Copy the id of each card
+Assistance Received: none
+********************************************************************* */
+std::vector<int> Computer::handIds(const Hand &hand)
+{
+   std::vector<int> ids;
+   ids.reserve(hand.size());
+   for (const Card &card : hand)
+   {
+      ids.push_back(card.getId());
+   }
+
+   return ids;
+}
+
+/* *********************************************************************
+Function Name: startPondering()
+Purpose: Start working out replies to the human's discard while they
+   decide
+Parameters:
+         int round, the round (to know the wild card)
+         const vector<int> &likelyCards, ids of the cards the human is
+            likely to discard
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Start the worker on a copy of the hand and what the human is
+         likely to hold at the computer's difficulty
+Assistance Received: none
+********************************************************************* */
+void Computer::startPondering(int round, const std::vector<int> &likelyCards)
+{
+   this->ponder.start(this->hand, round, this->difficulty, this->strategy, likelyCards, this->opponent);
+}
+
+/* *********************************************************************
+Function Name: observeRoundStart()
+Purpose: Start keeping track of what the human is likely to hold
+Parameters:
+         int round, the round (to know the wild card)
+         int humanHandSize, the cards the human holds
+         const vector<int> &discardPile, ids of the cards face up in the
+            discard pile
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Start the model's round
+Assistance Received: none
+********************************************************************* */
+void Computer::observeRoundStart(int round, int humanHandSize, const std::vector<int> &discardPile)
+{
+   this->opponent.startRound(round, humanHandSize, discardPile);
+}
+
+/* *********************************************************************
+Function Name: observeDraw()
+Purpose: Keep track of a draw
+Parameters:
+         bool byComputer, whether the computer drew
+         bool fromDiscard, whether the card came from the discard pile
+         const Card &card, the card drawn
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) The human's draws grow their hand, and a card taken from the
+         discard pile is known to be in it
+         2) The computer's draws from the discard pile take the card out
+         of sight of the human's hand
+Assistance Received: none
+********************************************************************* */
+void Computer::observeDraw(bool byComputer, bool fromDiscard, const Card &card)
+{
+   if (byComputer)
+   {
+      if (fromDiscard)
+      {
+         this->opponent.tookDiscard(card.getId());
+      }
+   }
+   else if (fromDiscard)
+   {
+      this->opponent.opponentTookDiscard(card.getId());
+   }
+   else
+   {
+      this->opponent.opponentDrewDeck();
+   }
+}
+
+/* *********************************************************************
+Function Name: observeDiscard()
+Purpose: Keep track of a discard
+Parameters:
+         bool byComputer, whether the computer discarded
+         const Card &card, the card discarded
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Tell the model who threw the card away
+Assistance Received: none
+********************************************************************* */
+void Computer::observeDiscard(bool byComputer, const Card &card)
+{
+   if (byComputer)
+   {
+      this->opponent.discarded(card.getId());
+   }
+   else
+   {
+      this->opponent.opponentDiscarded(card.getId());
+   }
+}
+
+/* *********************************************************************
+Function Name: stopPondering()
+Purpose: Stop working out replies
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Stop the worker, keeping the replies found so far
+Assistance Received: none
+********************************************************************* */
+void Computer::stopPondering()
+{
+   this->ponder.stop();
+}
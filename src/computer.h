@@ -2,6 +2,12 @@
 #define COMPUTER_H
 
 #include "player.h"
+#include "anytimeSearch.h"
+#include "ponder.h"
+#include "rolloutEstimator.h"
+#include "endgameSolver.h"
+#include "discardScorer.h"
+#include "strategy.h"
 
 class Computer : public Player
 {
@@ -21,17 +27,122 @@ class Computer : public Player
       virtual std::pair<bool, std::string> getCardToDiscard() override;
       virtual std::string toString() const override;
 
+      // A suggestion for the Human: whether to draw from the discard pile, or
+      // which card to discard and why
+      struct Hint
+      {
+         Help type = Help::UNDEFINED;
+         bool drawDiscard = false;
+         std::string card;
+         std::string reason;
+      };
+
       // Function Human player can call to ask for help on what moves to make
-      static void help(std::vector<Card> hand, Card discardCard, Computer::Help helpType);
+      static void help(const Hand &hand, const Card &discardCard, Computer::Help helpType);
+
+      // Work out the help for the hand and discard card without printing it
+      static Hint findHint(const Hand &hand, const Card &discardCard, Computer::Help helpType);
+
+      // Print help worked out by findHint()
+      static void printHint(const Hint &hint);
 
       // Check if we should draw from the discard pile or drawing pile
       bool shouldDrawFromDiscard();
 
+      // Check if a hand should draw the top of the discard pile by the
+      // strategy's rule of thumb
+      static bool shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard, const Strategy &strategy = Strategy());
+
+      // Check if a hand should draw the top of the discard pile by playing out
+      // samples draws from the deck against it, until the deadline (or until
+      // cancel is set). estimate gets the points each is expected to leave
+      static bool shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard, int samples,
+         std::chrono::steady_clock::time_point deadline, RolloutEstimate &estimate, const std::atomic<bool> *cancel = nullptr);
+
+      // Find the card a hand should discard and why
+      static std::pair<std::string, std::string> worstCard(const Hand &hand);
+
+      // Decide whether to draw the top of the discard pile within the
+      // difficulty's time budget (or until cancel is set), and why. With no
+      // budget the strategy's rule of thumb decides
+      static std::pair<bool, std::string> chooseDraw(const Hand &hand, const Card &topOfDiscard, Difficulty difficulty,
+         const std::atomic<bool> *cancel = nullptr, const Strategy &strategy = Strategy());
+
+      // Find the card to discard within the difficulty's time budget (or until
+      // cancel is set), and why. If opponent is given, discards that are
+      // likely to complete the human's books and runs cost more (see
+      // DiscardScorer)
+      static std::pair<std::string, std::string> chooseDiscard(const Hand &hand, const Card &topOfDiscard, Difficulty difficulty,
+         const std::atomic<bool> *cancel = nullptr, const OpponentModel *opponent = nullptr);
+
+      // Set how long the computer may think about each decision
+      void setDifficulty(Difficulty difficulty);
+
+      // Set the parameters of the computer's rule of thumb (see Strategy)
+      void setStrategy(const Strategy &strategy);
+
+      // Let the computer see the game as its turn starts and after it draws,
+      // to search the end of the round (see EndgameSolver). The search deals
+      // the cards it can't see again, so it only uses what it can see
+      void setGameState(const GameState &state);
+
+      // Keep track of what the human is likely to hold (see OpponentModel):
+      // at the start of a round (or a loaded game), and after every draw
+      // from the discard pile and every discard, by either player
+      void observeRoundStart(int round, int humanHandSize, const std::vector<int> &discardPile);
+      void observeDraw(bool byComputer, bool fromDiscard, const Card &card);
+      void observeDiscard(bool byComputer, const Card &card);
+
+      // Start working out replies to the human's discard on a worker thread
+      // while they decide. likelyCards are ids of the cards they're likely to discard
+      void startPondering(int round, const std::vector<int> &likelyCards);
+
+      // Stop working out replies, called once the human has acted
+      void stopPondering();
+
       // Return the number of remaining cards after making combinations from a vector of cards
-      int numberOfRemainingCards(std::vector<Card> hand, CombinationFinder::Order combinationOrder);
+      int numberOfRemainingCards(const std::vector<Card> &hand, CombinationFinder::Order combinationOrder);
 
       // Return the number of single cards after making combinations from vector of cards
-      int numberOfSingleCards(std::vector<Card> hand, CombinationFinder::Order combinationOrder);
+      int numberOfSingleCards(const std::vector<Card> &hand, CombinationFinder::Order combinationOrder);
+
+   private:
+      // Draws played out to decide a draw at Difficulty::HARD (as many as
+      // the budget allows)
+      static const int ROLLOUT_SAMPLES = 4096;
+
+      // Search the end of the round from the state set by setGameState(),
+      // if few enough cards are unseen. Returns false to decide as usual
+      bool solveEndgame(Action &action, std::string &reason);
+
+      // Get the seed to sample a position with, the same for the same cards
+      static unsigned searchSeed(const Hand &hand, const Card &topOfDiscard);
+
+      // Get the ids of the cards in a hand, in the hand's order
+      static std::vector<int> handIds(const Hand &hand);
+
+      // How long the computer may think about each decision
+      Difficulty difficulty = Difficulty::HEURISTIC;
+
+      // The parameters of its rule of thumb
+      Strategy strategy;
+
+      // The game as the computer's turn started or after it drew, used by
+      // the next decision only
+      GameState gameState = GameState();
+      bool hasGameState = false;
+
+      // What the human is likely to hold
+      OpponentModel opponent;
+
+      // Replies worked out during the human's turn
+      Ponder ponder;
+
+      // The discard worked out with the reply used by move(), why, and the
+      // ids of the hand after the draw it was worked out for
+      std::string ponderedDiscard;
+      std::string ponderedReason;
+      std::vector<int> ponderedHand;
 };
 
 #endif
\ No newline at end of file
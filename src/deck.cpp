@@ -165,19 +165,26 @@ void Deck::printDiscard()
 
 /* *********************************************************************
 Function Name: shuffleDeck()
-Purpose: Randomly shuffle all cards in the deck
+Purpose: Shuffle all cards in the deck. The same seed and round always
+   give the same order so games can be replayed
 Parameters:
-         none
+         unsigned seed, the seed of the game
+         int round, the current round
 Return Value: none
 Local Variables:
-         none
+         seed_seq sequence, the seed and round combined
+         mt19937 generator, the random number generator
 Algorithm:
-         1) Call random_shuffle on the deck from beginning to end
+         1) Seed the generator with the seed and round
+         2) Shuffle the deck from beginning to end
 Assistance Received: none
 ********************************************************************* */
-void Deck::shuffleDeck()
+void Deck::shuffleDeck(unsigned seed, int round)
 {
-    std::random_shuffle(deck.begin(), deck.end());
+   std::seed_seq sequence{ seed, static_cast<unsigned>(round) };
+   std::mt19937 generator(sequence);
+
+   std::shuffle(deck.begin(), deck.end(), generator);
 }
 
 /* *********************************************************************
@@ -358,6 +365,40 @@ bool Deck::isDrawPileEmpty()
    return this->deck.empty();
 }
 
+/* *********************************************************************
+Function Name: getDrawPile()
+Purpose: Get the draw pile without copying it
+Parameters:
+         none
+Return Value: a const vector<Card>&, the draw pile, top of the pile first
+Local Variables:
+         none
+Algorithm:
+         1) Return the draw pile
+Assistance Received: none
+********************************************************************* */
+const std::vector<Card>& Deck::getDrawPile() const
+{
+   return this->deck;
+}
+
+/* *********************************************************************
+Function Name: getDiscardPile()
+Purpose: Get the discard pile without copying it
+Parameters:
+         none
+Return Value: a const deque<Card>&, the discard pile, top of the pile first
+Local Variables:
+         none
+Algorithm:
+         1) Return the discard pile
+Assistance Received: none
+********************************************************************* */
+const std::deque<Card>& Deck::getDiscardPile() const
+{
+   return this->discardPile;
+}
+
 /* *********************************************************************
 Function Name: toString()
 Purpose: Convert the deck to its string equivalent
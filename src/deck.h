@@ -4,7 +4,7 @@
 #include "card.h"
 #include <vector>
 //#include <list>
-#include <algorithm>  // std::random_shuffle
+#include <algorithm>  // std::shuffle
 #include <ctime>      // std::time
 #include <cstdlib>    // std::rand, std::srand
 #include <iostream>   // delete or set to debug
@@ -47,8 +47,9 @@ class Deck
 
       /**
        * @brief shuffle the deck of cards
+       * The same seed and round always give the same order
        */
-      void shuffleDeck();
+      void shuffleDeck(unsigned seed, int round);
 
       // takes N cards from top of deck
       std::vector<Card> takeNCards(int n);
@@ -77,6 +78,12 @@ class Deck
       // Check if the drawing pile is empty
       bool isDrawPileEmpty();
 
+      // Get the draw pile, top of the pile first
+      const std::vector<Card>& getDrawPile() const;
+
+      // Get the discard pile, top of the pile first
+      const std::deque<Card>& getDiscardPile() const;
+
       // To string function so we can output the deck
       std::string toString() const;
 
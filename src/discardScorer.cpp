@@ -0,0 +1,145 @@
+#include "discardScorer.h"
+#include <algorithm>   // std::swap
+
+/* *********************************************************************
+Function Name: DiscardScorer()
+Purpose: Create a scorer for a round
+Parameters:
+         int round, the round (to know the wild card)
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the round, its evaluator, and the solution table
+Assistance Received: none
+********************************************************************* */
+DiscardScorer::DiscardScorer(int round)
+   : round(round), evaluator(round), table(&SolutionTable::shared())
+{
+}
+
+/* *********************************************************************
+Function Name: feedingCosts()
+Purpose: Find the points discarding each card costs from what the other
+   player is likely to hold
+Parameters:
+         const OpponentModel &opponent, what the other player is likely
+            to hold
+         const Hand &hand, the hand discarding
+         float cost[], set to the cost of discarding each card id
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Find the probability each card completes a book or run for
+            them, and charge COMPLETION_COST points for a certain one
+Assistance Received: none
+********************************************************************* */
+void DiscardScorer::feedingCosts(const OpponentModel &opponent, const Hand &hand, float cost[Card::NUMBER_OF_IDS])
+{
+   opponent.completionProbabilities(hand, cost);
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      cost[id] *= COMPLETION_COST;
+   }
+}
+
+/* *********************************************************************
+Function Name: scoreAll()
+Purpose: Score every card a hand could discard
+Parameters:
+         const Hand &hand, the hand after drawing
+         const float *completion, the probability each card id completes
+            a book or run for the other player (may be null)
+         Score scores[], set to the score of each different card
+Return Value: an int, the number of scores
+Local Variables:
+         unsigned char ids[], the hand's card ids
+         int size, the number of cards
+         int count, the scores so far
+Algorithm:
+         1) Copy the ids once
+         2) For each different card, swap it to the end and find what's
+            left in the rest (looked up in the solution table for the
+            first rounds), then add the cost of what it gives the other
+            player
+Assistance Received: none
+********************************************************************* */
+int DiscardScorer::scoreAll(const Hand &hand, const float *completion, Score scores[Hand::MAX_CARDS]) const
+{
+   unsigned char ids[Hand::MAX_CARDS];
+   int size = 0;
+   for (const Card &card : hand)
+   {
+      ids[size++] = card.getId();
+   }
+
+   int count = 0;
+   for (int i = 0; i < size; i++)
+   {
+      // Discarding either copy of a card is the same
+      if (hand.indexOf(ids[i]) != i)
+      {
+         continue;
+      }
+
+      Score &score = scores[count++];
+      score.index = i;
+
+      std::swap(ids[i], ids[size - 1]);
+      if (!this->table->deadwood(ids, size - 1, this->round, score.deadwood))
+      {
+         score.deadwood = this->evaluator.deadwood(ids, size - 1);
+      }
+      std::swap(ids[i], ids[size - 1]);
+
+      score.completion = completion == nullptr ? 0 : completion[ids[i]];
+      score.total = score.deadwood + score.completion * COMPLETION_COST;
+   }
+
+   return count;
+}
+
+/* *********************************************************************
+Function Name: choose()
+Purpose: Find the best card for a hand to discard
+Parameters:
+         const Hand &hand, the hand after drawing
+         const float *completion, the probability each card id completes
+            a book or run for the other player (may be null)
+Return Value: a Score, the best discard's score
+Local Variables:
+         Score scores[], the score of each different card
+         int count, the number of scores
+         int best, the index of the best score
+Algorithm:
+         1) Score every card
+         2) Take the first discard that goes out, otherwise the one with
+            the least total, the first found on a tie
+Assistance Received: none
+********************************************************************* */
+DiscardScorer::Score DiscardScorer::choose(const Hand &hand, const float *completion) const
+{
+   Score scores[Hand::MAX_CARDS];
+   int count = scoreAll(hand, completion, scores);
+   if (count == 0)
+   {
+      return Score();
+   }
+
+   int best = 0;
+   for (int i = 0; i < count; i++)
+   {
+      if (scores[i].deadwood == 0)
+      {
+         return scores[i];
+      }
+
+      if (scores[i].total < scores[best].total)
+      {
+         best = i;
+      }
+   }
+
+   return scores[best];
+}
@@ -0,0 +1,60 @@
+#ifndef DISCARDSCORER_H
+#define DISCARDSCORER_H
+
+#include "hand.h"
+#include "meldEvaluator.h"
+#include "solutionTable.h"
+#include "opponentModel.h"
+
+// Scores every card a hand could discard in one pass, weighing the points
+// left in the hand without it against how likely it is to complete a book or
+// run for the other player (see OpponentModel::completionProbabilities()).
+// Unlike CombinationFinder::findWorstCard(), which only looks at the hand,
+// this can keep a card that would help the other player when throwing away
+// another costs few points.
+class DiscardScorer
+{
+   public:
+      // Points a discard costs if it's certain to complete a book or run for
+      // the other player
+      static constexpr float COMPLETION_COST = 10.0f;
+
+      // One card the hand could discard
+      struct Score
+      {
+         // Index of the card in the hand
+         int index = -1;
+
+         // Points left in the rest of the hand after its best arrangement
+         int deadwood = 0;
+
+         // Probability it completes a book or run for the other player
+         float completion = 0;
+
+         // deadwood plus the cost of completion
+         float total = 0;
+      };
+
+      // Score discards in a round (to know the wild card)
+      explicit DiscardScorer(int round);
+
+      // Fill cost with the points discarding each card id costs, from what
+      // opponent thinks the other player holds
+      static void feedingCosts(const OpponentModel &opponent, const Hand &hand, float cost[Card::NUMBER_OF_IDS]);
+
+      // Score each different card of the hand (after drawing), given the
+      // probability each card id completes a book or run for the other
+      // player (null if there's none). Returns the number of scores
+      int scoreAll(const Hand &hand, const float *completion, Score scores[Hand::MAX_CARDS]) const;
+
+      // Find the discard with the least total. A discard that goes out is
+      // always taken
+      Score choose(const Hand &hand, const float *completion) const;
+
+   private:
+      int round;
+      MeldEvaluator evaluator;
+      const SolutionTable *table;
+};
+
+#endif
@@ -0,0 +1,496 @@
+#include "endgameSolver.h"
+#include "zobrist.h"
+#include <algorithm>   // std::shuffle, std::swap
+
+namespace
+{
+   // More than any score difference in a round
+   const int INFINITE_VALUE = 1 << 20;
+
+   // Check the clock once every this many positions (a power of two)
+   const long long CHECK_INTERVAL = 256;
+
+   // Mix a number into a well spread 64-bit key (splitmix64's finisher)
+   unsigned long long mixKey(unsigned long long value)
+   {
+      value += 0x9E3779B97F4A7C15ULL;
+      value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+      return value ^ (value >> 31);
+   }
+}
+
+/* *********************************************************************
+Function Name: EndgameSolver()
+Purpose: Create a solver that stops at a deadline
+Parameters:
+         steady_clock::time_point deadline, when to stop searching
+         const atomic<bool> *cancel, stops the search early when set
+            (may be null)
+         unsigned seed, the seed the unseen cards are dealt with
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the deadline, cancel flag, and seed
+Assistance Received: none
+********************************************************************* */
+EndgameSolver::EndgameSolver(std::chrono::steady_clock::time_point deadline, const std::atomic<bool> *cancel, unsigned seed)
+   : deadline(deadline), cancel(cancel), seed(seed)
+{
+}
+
+/* *********************************************************************
+Function Name: isEndgame()
+Purpose: Check if few enough cards are unseen to search the end of the
+   round
+Parameters:
+         const GameState &state, the state
+Return Value: a bool, true if fewer than UNSEEN_LIMIT cards are in the
+   draw pile and the other player's hand
+Local Variables:
+         int other, the player not moving
+Algorithm:
+         1) Count the draw pile and the other player's hand
+Assistance Received: none
+********************************************************************* */
+bool EndgameSolver::isEndgame(const GameState &state)
+{
+   if (state.phase == GameState::Phase::ROUND_OVER)
+   {
+      return false;
+   }
+
+   int other = (state.playerToMove + 1) % GameState::PLAYER_COUNT;
+   return state.drawSize + state.handSizes[other] < UNSEEN_LIMIT;
+}
+
+/* *********************************************************************
+Function Name: solve()
+Purpose: Find the best action for the player to move
+Parameters:
+         const GameState &start, the state, only the player to move's
+            hand and the discard pile are used as they are
+         Action &best, set to the action found
+         double &expected, set to the player's score minus the other's
+            expected at the end of the search
+Return Value: a bool, false if there was no time to search a turn
+Local Variables:
+         Action actions[], the actions the player can make
+         GameState deals[], the deals of the unseen cards
+         long long totals[], the total value of each action over the
+            deals at the deepest search finished
+         unsigned short first, the generation of the first deal
+Algorithm:
+         1) Deal the unseen cards DEALS times
+         2) Search one turn ahead, then two, and so on: score every
+            action in every deal with a full window so the values can be
+            averaged, keeping the totals of the last depth finished
+         3) Choose the action with the least total
+Assistance Received: none
+********************************************************************* */
+bool EndgameSolver::solve(const GameState &start, Action &best, double &expected)
+{
+   this->player = start.playerToMove;
+   this->evaluator = MeldEvaluator(start.round);
+   this->nodes = 0;
+   this->turns = 0;
+   this->stopped = false;
+
+   Action actions[GameState::MAX_ACTIONS];
+   int count = legalActions(start, actions);
+   if (count == 0)
+   {
+      return false;
+   }
+
+   if (this->table.empty())
+   {
+      this->table.resize(TABLE_SIZE);
+   }
+
+   // Every deal gets its own generation, kept across depths so deeper
+   // searches try the best actions shallower ones stored first
+   if (this->generations > 0xFFFF - DEALS)
+   {
+      std::fill(this->table.begin(), this->table.end(), Entry());
+      this->generations = 0;
+   }
+   unsigned short first = this->generations + 1;
+   this->generations += DEALS;
+
+   std::mt19937 generator(this->seed);
+   GameState deals[DEALS];
+   for (int d = 0; d < DEALS; d++)
+   {
+      deals[d] = deal(start, generator);
+   }
+
+   long long totals[GameState::MAX_ACTIONS] = { 0 };
+   for (int turnsLeft = 1; turnsLeft <= MAX_TURNS && !this->stopped; turnsLeft++)
+   {
+      long long sums[GameState::MAX_ACTIONS] = { 0 };
+      for (int d = 0; d < DEALS && !this->stopped; d++)
+      {
+         this->generation = first + d;
+         setDeal(deals[d]);
+
+         for (int a = 0; a < count && !this->stopped; a++)
+         {
+            apply(actions[a]);
+            sums[a] += search(turnsLeft - (actions[a].type == Action::Type::DISCARD), -INFINITE_VALUE, INFINITE_VALUE);
+            this->undoStack.undo(this->state);
+         }
+      }
+
+      if (!this->stopped)
+      {
+         std::copy(sums, sums + count, totals);
+         this->turns = turnsLeft;
+      }
+   }
+
+   if (this->turns == 0)
+   {
+      return false;
+   }
+
+   int bestIndex = 0;
+   for (int a = 1; a < count; a++)
+   {
+      if (totals[a] < totals[bestIndex])
+      {
+         bestIndex = a;
+      }
+   }
+
+   best = actions[bestIndex];
+   expected = static_cast<double>(totals[bestIndex]) / DEALS;
+   return true;
+}
+
+/* *********************************************************************
+Function Name: getTurns()
+Purpose: Get the turns searched ahead by the last solve()
+Parameters:
+         none
+Return Value: an int, the deepest search finished
+Local Variables:
+         none
+Algorithm:
+         1) Return the count
+Assistance Received: none
+********************************************************************* */
+int EndgameSolver::getTurns() const
+{
+   return this->turns;
+}
+
+/* *********************************************************************
+Function Name: getNodes()
+Purpose: Get the positions searched by the last solve()
+Parameters:
+         none
+Return Value: a long long, the number of positions
+Local Variables:
+         none
+Algorithm:
+         1) Return the count
+Assistance Received: none
+********************************************************************* */
+long long EndgameSolver::getNodes() const
+{
+   return this->nodes;
+}
+
+/* *********************************************************************
+Function Name: deal()
+Purpose: Deal the cards the player to move can't see at random
+Parameters:
+         const GameState &state, the state
+         mt19937 &generator, the generator to shuffle with
+Return Value: a GameState, the state with the other player's hand and
+   the draw pile dealt again from the same cards
+Local Variables:
+         GameState dealt, the state being dealt
+         int other, the player not moving
+         unsigned char unseen[], the cards of the other hand and the
+            draw pile
+Algorithm:
+         1) Put the other hand and the draw pile together and shuffle
+         2) Deal the other hand first and the draw pile from the rest
+         3) Hash the new state
+Assistance Received: none
+********************************************************************* */
+GameState EndgameSolver::deal(const GameState &state, std::mt19937 &generator) const
+{
+   GameState dealt = state;
+   int other = (state.playerToMove + 1) % GameState::PLAYER_COUNT;
+
+   unsigned char unseen[GameState::DECK_SIZE + GameState::MAX_HAND];
+   int unseenCount = 0;
+   for (int i = 0; i < state.handSizes[other]; i++)
+   {
+      unseen[unseenCount++] = state.hands[other][i];
+   }
+   for (int i = 0; i < state.drawSize; i++)
+   {
+      unseen[unseenCount++] = state.drawPile[i];
+   }
+
+   std::shuffle(unseen, unseen + unseenCount, generator);
+
+   std::copy(unseen, unseen + state.handSizes[other], dealt.hands[other]);
+   std::copy(unseen + state.handSizes[other], unseen + unseenCount, dealt.drawPile);
+   dealt.hash = Zobrist::hash(dealt);
+
+   return dealt;
+}
+
+/* *********************************************************************
+Function Name: setDeal()
+Purpose: Start searching a deal
+Parameters:
+         const GameState &dealt, the deal
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Copy the deal and empty the undo stack
+         2) Hash every prefix of the discard pile
+Assistance Received: none
+********************************************************************* */
+void EndgameSolver::setDeal(const GameState &dealt)
+{
+   this->state = dealt;
+   this->undoStack.size = 0;
+
+   this->discardKeys[0] = 0;
+   for (int i = 0; i < this->state.discardSize; i++)
+   {
+      this->discardKeys[i + 1] = mixKey(this->discardKeys[i] ^ (this->state.discardPile[i] + 1));
+   }
+}
+
+/* *********************************************************************
+Function Name: search()
+Purpose: Search the state for a number of turns
+Parameters:
+         int turnsLeft, the turns left to search
+         int alpha, the least the other player can already hold the
+            player to
+         int beta, the most the player can already hold the other to
+Return Value: an int, the player's score minus the other's at the end of
+   the round, or after turnsLeft turns if it hasn't ended
+Local Variables:
+         unsigned long long key, the state's key in the table
+         Entry &entry, where the state is stored in the table
+         bool stored, whether the entry is for this state
+         Action actions[], the legal actions
+         bool minimizing, whether the player is moving
+         int best, the best value found
+         Action bestAction, the action giving it
+Algorithm:
+         1) Return the score difference once the round is over, or what's
+            left in each hand when out of turns
+         2) Use the table's value if it was searched to the same depth,
+            or narrow the window by its bound (a deeper value would mix
+            depths, so it only orders the actions)
+         3) Try every action, the stored best action first: the player
+            keeps the least value and the other player the most, and
+            stop once the window closes
+         4) Store the value, marked as a bound if it fell outside the
+            window, unless the search was stopped
+Assistance Received: none
+********************************************************************* */
+int EndgameSolver::search(int turnsLeft, int alpha, int beta)
+{
+   int other = (this->player + 1) % GameState::PLAYER_COUNT;
+   if (this->state.phase == GameState::Phase::ROUND_OVER)
+   {
+      return this->state.scores[this->player] - this->state.scores[other];
+   }
+
+   if (this->state.phase == GameState::Phase::DRAW && turnsLeft == 0)
+   {
+      return evaluate();
+   }
+
+   if (++this->nodes % CHECK_INTERVAL == 0 && outOfTime())
+   {
+      this->stopped = true;
+   }
+
+   if (this->stopped)
+   {
+      return 0;
+   }
+
+   unsigned long long key = this->key();
+   Entry &entry = this->table[key & (TABLE_SIZE - 1)];
+   bool stored = entry.key == key && entry.generation == this->generation;
+   if (stored && entry.turnsLeft == turnsLeft)
+   {
+      if (entry.bound == Bound::EXACT)
+      {
+         return entry.value;
+      }
+      else if (entry.bound == Bound::LOWER)
+      {
+         alpha = std::max(alpha, entry.value);
+      }
+      else
+      {
+         beta = std::min(beta, entry.value);
+      }
+
+      if (alpha >= beta)
+      {
+         return entry.value;
+      }
+   }
+
+   Action actions[GameState::MAX_ACTIONS];
+   int count = legalActions(this->state, actions);
+   if (count == 0)
+   {
+      return evaluate();
+   }
+
+   for (int i = 1; i < count && stored; i++)
+   {
+      if (actions[i].type == entry.best.type && actions[i].card == entry.best.card)
+      {
+         std::swap(actions[0], actions[i]);
+      }
+   }
+
+   bool minimizing = this->state.playerToMove == this->player;
+   int originalAlpha = alpha;
+   int originalBeta = beta;
+   int best = minimizing ? INFINITE_VALUE : -INFINITE_VALUE;
+   Action bestAction = actions[0];
+   for (int i = 0; i < count && alpha < beta; i++)
+   {
+      apply(actions[i]);
+      int value = search(turnsLeft - (actions[i].type == Action::Type::DISCARD), alpha, beta);
+      this->undoStack.undo(this->state);
+
+      if (minimizing ? value < best : value > best)
+      {
+         best = value;
+         bestAction = actions[i];
+      }
+
+      if (minimizing)
+      {
+         beta = std::min(beta, best);
+      }
+      else
+      {
+         alpha = std::max(alpha, best);
+      }
+   }
+
+   if (!this->stopped)
+   {
+      // The entry may be for another state, which is replaced
+      Entry &slot = this->table[key & (TABLE_SIZE - 1)];
+      slot.key = key;
+      slot.value = best;
+      slot.generation = this->generation;
+      slot.turnsLeft = turnsLeft;
+      slot.bound = best <= originalAlpha ? Bound::UPPER : best >= originalBeta ? Bound::LOWER : Bound::EXACT;
+      slot.best = bestAction;
+   }
+
+   return best;
+}
+
+/* *********************************************************************
+Function Name: apply()
+Purpose: Make an action on the state
+Parameters:
+         Action action, the action
+Return Value: none
+Local Variables:
+         int size, the size of the discard pile after the action
+Algorithm:
+         1) Make the action, pushing its undo record
+         2) A discard adds the card to the discard pile's hash (draws
+            only shorten the pile, whose shorter prefixes are hashed)
+Assistance Received: none
+********************************************************************* */
+void EndgameSolver::apply(Action action)
+{
+   this->undoStack.apply(this->state, action);
+
+   if (action.type == Action::Type::DISCARD)
+   {
+      int size = this->state.discardSize;
+      this->discardKeys[size] = mixKey(this->discardKeys[size - 1] ^ (this->state.discardPile[size - 1] + 1));
+   }
+}
+
+/* *********************************************************************
+Function Name: evaluate()
+Purpose: Score the state as if the round ended now
+Parameters:
+         none
+Return Value: an int, the player's score minus the other's, with what's
+   left in each hand after its best arrangement
+Local Variables:
+         int other, the player the search isn't for
+Algorithm:
+         1) Add what's left in each hand to each score and subtract
+Assistance Received: none
+********************************************************************* */
+int EndgameSolver::evaluate() const
+{
+   int other = (this->player + 1) % GameState::PLAYER_COUNT;
+   int mine = this->state.scores[this->player] + this->evaluator.deadwood(this->state.hands[this->player], this->state.handSizes[this->player]);
+   int theirs = this->state.scores[other] + this->evaluator.deadwood(this->state.hands[other], this->state.handSizes[other]);
+
+   return mine - theirs;
+}
+
+/* *********************************************************************
+Function Name: key()
+Purpose: Get the state's key in the transposition table
+Parameters:
+         none
+Return Value: an unsigned long long, the key
+Local Variables:
+         none
+Algorithm:
+         1) Combine the state's hash (the hands, top of the discard pile,
+            round, and turn) with the draw pile's size, which fixes what's
+            left in it in a deal, and the whole discard pile
+Assistance Received: none
+********************************************************************* */
+unsigned long long EndgameSolver::key() const
+{
+   return this->state.hash ^ this->discardKeys[this->state.discardSize] ^ mixKey(~static_cast<unsigned long long>(this->state.drawSize));
+}
+
+/* *********************************************************************
+Function Name: outOfTime()
+Purpose: Check if the search has to stop
+Parameters:
+         none
+Return Value: a bool, true if the deadline passed or it was cancelled
+Local Variables:
+         none
+Algorithm:
+         1) Check the cancel flag, then the clock
+Assistance Received: none
+********************************************************************* */
+bool EndgameSolver::outOfTime() const
+{
+   if (this->cancel != nullptr && *this->cancel)
+   {
+      return true;
+   }
+
+   return std::chrono::steady_clock::now() >= this->deadline;
+}
@@ -0,0 +1,119 @@
+#ifndef ENDGAMESOLVER_H
+#define ENDGAMESOLVER_H
+
+#include "gameState.h"
+#include "meldEvaluator.h"
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::steady_clock
+#include <random>      // std::mt19937
+#include <vector>
+
+// Plays out the end of a round exactly once few cards are left unseen. The
+// cards the player to move can't see (the other hand and the draw pile) are
+// dealt again a number of times, and every deal is searched as if all the
+// cards were face up, with alpha-beta and a transposition table, for the
+// next few turns or to the end of the round. The action with the least
+// expected score difference over the deals is chosen. Turns are searched
+// one deeper at a time, so the last depth finished is used when the
+// deadline passes.
+class EndgameSolver
+{
+   public:
+      // Most cards the player to move can't see for the end of a round
+      static const int UNSEEN_LIMIT = 24;
+
+      // Deals of the unseen cards searched
+      static const int DEALS = 8;
+
+      // Most turns (of either player) searched ahead
+      static const int MAX_TURNS = 8;
+
+      // Search until the deadline, or until cancel is set if it's given
+      EndgameSolver(std::chrono::steady_clock::time_point deadline, const std::atomic<bool> *cancel = nullptr, unsigned seed = 0);
+
+      // Check if few enough cards are unseen by the player to move
+      static bool isEndgame(const GameState &state);
+
+      // Find the action for the player to move (drawing or discarding) that
+      // leaves them the least behind on average over the deals. expected is
+      // their score minus the other player's, expected at the end of the
+      // search. Returns false if there was no time to search a single turn
+      bool solve(const GameState &state, Action &best, double &expected);
+
+      // Turns searched ahead by the last solve()
+      int getTurns() const;
+
+      // Positions searched by the last solve()
+      long long getNodes() const;
+
+   private:
+      // Whether a stored value is exact or only a bound on it
+      enum class Bound : unsigned char {
+         EXACT = 0,
+         LOWER,
+         UPPER
+      };
+
+      // A position searched, found by its key
+      struct Entry
+      {
+         unsigned long long key = 0;
+         int value = 0;
+         unsigned short generation = 0;
+         unsigned char turnsLeft = 0;
+         Bound bound = Bound::EXACT;
+         Action best = { Action::Type::DRAW_DECK, 0 };
+      };
+
+      // Entries in the transposition table (a power of two)
+      static const int TABLE_SIZE = 1 << 16;
+
+      // Deal the cards the player to move can't see at random
+      GameState deal(const GameState &state, std::mt19937 &generator) const;
+
+      // Start searching a deal: hash its discard pile
+      void setDeal(const GameState &state);
+
+      // Search the state for turnsLeft more turns, returning its value for
+      // the player the search is for, which they want as low as possible
+      int search(int turnsLeft, int alpha, int beta);
+
+      // Make an action on the state, keeping the discard pile's hash
+      void apply(Action action);
+
+      // The player's score minus the other's if the round ended now
+      int evaluate() const;
+
+      // Key of the state in the transposition table: its hash with the
+      // draw pile's size and the whole discard pile, since every card is
+      // known in a deal
+      unsigned long long key() const;
+
+      // Check if the deadline passed or the search was cancelled
+      bool outOfTime() const;
+
+      std::chrono::steady_clock::time_point deadline;
+      const std::atomic<bool> *cancel;
+      unsigned seed;
+
+      // The deal being searched and the actions to take back
+      GameState state = GameState();
+      UndoStack undoStack;
+      MeldEvaluator evaluator{ 1 };
+      int player = 0;
+
+      // Hash of the first i cards of the discard pile at [i]
+      unsigned long long discardKeys[GameState::DECK_SIZE + 1] = { 0 };
+
+      // Entries from other deals are told apart by generation, the deal's
+      // number counted across every solve()
+      std::vector<Entry> table;
+      unsigned short generation = 0;
+      unsigned short generations = 0;
+
+      long long nodes = 0;
+      int turns = 0;
+      bool stopped = false;
+};
+
+#endif
@@ -0,0 +1,501 @@
+#include "evaluationCache.h"
+#include "zobrist.h"
+#include <cstdio>      // std::rename, std::remove
+#include <cstring>     // std::memcmp, std::memcpy
+#include <fcntl.h>     // open
+#include <fstream>
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#include <vector>
+
+const char EvaluationCache::MAGIC[4] = { 'F', 'C', 'E', 'C' };
+const std::string EvaluationCache::DEFAULT_FILE_NAME = "fivecrowns.fce";
+
+/* *********************************************************************
+Function Name: ~EvaluationCache()
+Purpose: Release the mapped file
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Unmap the file if one is mapped
+Assistance Received: none
+********************************************************************* */
+EvaluationCache::~EvaluationCache()
+{
+   close();
+}
+
+/* *********************************************************************
+Function Name: open()
+Purpose: Map a cache file into memory
+Parameters:
+         const string &fileName, the file to map
+Return Value: a bool, true if it could not be opened, is not a valid
+   cache, or was made under other rules
+Local Variables:
+         int file, the open file
+         struct stat status, its size
+         const unsigned char *bytes, the mapped file
+         uint32_t rules, the rules version it was made under
+         uint64_t keyCheck, the first round key it was made with
+Algorithm:
+         1) Map the whole file read only and shared, so processes reading
+            the same file share its pages
+         2) Check the magic and versions, and that the keys were made with
+            the same Zobrist keys
+         3) Check that the capacity is a power of two with room to spare,
+            so probes always reach an empty slot, and the slots fit in the
+            file, and point at them
+         4) Unmap the file if anything is wrong
+Assistance Received: none
+********************************************************************* */
+bool EvaluationCache::open(const std::string &fileName)
+{
+   close();
+
+   int file = ::open(fileName.c_str(), O_RDONLY);
+   if (file == -1)
+   {
+      return true;
+   }
+
+   struct stat status;
+   if (fstat(file, &status) == -1 || status.st_size < HEADER_SIZE)
+   {
+      ::close(file);
+      return true;
+   }
+
+   this->length = static_cast<size_t>(status.st_size);
+   this->data = mmap(nullptr, this->length, PROT_READ, MAP_SHARED, file, 0);
+   ::close(file);
+
+   if (this->data == MAP_FAILED)
+   {
+      this->data = nullptr;
+      this->length = 0;
+      return true;
+   }
+
+   const unsigned char *bytes = static_cast<const unsigned char *>(this->data);
+   std::uint32_t rules;
+   std::uint64_t keyCheck;
+   std::memcpy(&rules, bytes + 8, sizeof(rules));
+   std::memcpy(&this->count, bytes + 12, sizeof(this->count));
+   std::memcpy(&keyCheck, bytes + 16, sizeof(keyCheck));
+   std::memcpy(&this->capacity, bytes + 24, sizeof(this->capacity));
+
+   if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || bytes[4] != FORMAT_VERSION || rules != RULES_VERSION
+      || keyCheck != Zobrist::roundKey(1) || this->capacity == 0 || (this->capacity & (this->capacity - 1)) != 0
+      || this->count > this->capacity / SLOTS_PER_ENTRY
+      || (this->length - HEADER_SIZE) / (sizeof(std::uint64_t) + sizeof(std::uint32_t)) < this->capacity)
+   {
+      close();
+      return true;
+   }
+
+   this->keys = reinterpret_cast<const std::uint64_t *>(bytes + HEADER_SIZE);
+   this->values = reinterpret_cast<const std::uint32_t *>(bytes + HEADER_SIZE + this->capacity * sizeof(std::uint64_t));
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: close()
+Purpose: Release the mapped file
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Unmap the file and forget its slots, keeping what was recorded
+Assistance Received: none
+********************************************************************* */
+void EvaluationCache::close()
+{
+   if (this->data != nullptr)
+   {
+      munmap(this->data, this->length);
+   }
+
+   this->data = nullptr;
+   this->length = 0;
+   this->keys = nullptr;
+   this->values = nullptr;
+   this->capacity = 0;
+   this->count = 0;
+}
+
+/* *********************************************************************
+Function Name: key()
+Purpose: Find the key of a hand in a round
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+         int round, the round (to know the wild card)
+Return Value: a uint64_t, the key, never 0
+Local Variables:
+         unsigned char copies[], the copies of each card seen so far
+         uint64_t key, the key being built
+Algorithm:
+         1) XOR the round's key with the key of each copy of each card,
+            the way Zobrist hashes a hand, so the order doesn't matter
+         2) 0 marks an empty slot, so move a key of 0 to 1
+Assistance Received: none
+********************************************************************* */
+std::uint64_t EvaluationCache::key(const unsigned char *ids, int size, int round)
+{
+   unsigned char copies[Card::NUMBER_OF_IDS] = { 0 };
+   std::uint64_t key = Zobrist::roundKey(round);
+   for (int i = 0; i < size; i++)
+   {
+      key ^= Zobrist::handKey(0, ids[i], copies[ids[i]]++ % Zobrist::MAX_COPIES);
+   }
+
+   return key == 0 ? 1 : key;
+}
+
+/* *********************************************************************
+Function Name: find()
+Purpose: Find a hand's entry
+Parameters:
+         uint64_t key, the hand's key
+         Entry &entry, set to its entry
+Return Value: a bool, false if the hand isn't in the cache
+Local Variables:
+         Entry recordedEntry, what this process recorded for the hand
+         bool found, whether the file has it
+Algorithm:
+         1) Look in the mapped file
+         2) While recording, also look at what was recorded, which may
+            know the discard when the file doesn't
+Assistance Received: none
+********************************************************************* */
+bool EvaluationCache::find(std::uint64_t key, Entry &entry) const
+{
+   bool found = findMapped(key, entry);
+   if (!this->recording)
+   {
+      return found;
+   }
+
+   std::lock_guard<std::mutex> guard(this->recordedLock);
+   std::unordered_map<std::uint64_t, Entry>::const_iterator recordedEntry = this->recorded.find(key);
+   if (recordedEntry == this->recorded.end())
+   {
+      return found;
+   }
+
+   if (found)
+   {
+      merge(entry, recordedEntry->second);
+   }
+   else
+   {
+      entry = recordedEntry->second;
+   }
+   return true;
+}
+
+/* *********************************************************************
+Function Name: record()
+Purpose: Remember an entry to save
+Parameters:
+         uint64_t key, the hand's key
+         const Entry &entry, what it was found to be
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Do nothing unless recording
+         2) Otherwise add it, or merge it with the entry already recorded
+Assistance Received: none
+********************************************************************* */
+void EvaluationCache::record(std::uint64_t key, const Entry &entry)
+{
+   if (!this->recording)
+   {
+      return;
+   }
+
+   std::lock_guard<std::mutex> guard(this->recordedLock);
+   std::pair<std::unordered_map<std::uint64_t, Entry>::iterator, bool> inserted = this->recorded.insert({ key, entry });
+   if (!inserted.second)
+   {
+      merge(inserted.first->second, entry);
+   }
+}
+
+/* *********************************************************************
+Function Name: setRecording()
+Purpose: Start or stop recording the hands evaluated
+Parameters:
+         bool recording, whether to record
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Set the flag
+Assistance Received: none
+********************************************************************* */
+void EvaluationCache::setRecording(bool recording)
+{
+   this->recording = recording;
+}
+
+/* *********************************************************************
+Function Name: isRecording()
+Purpose: Check if hands evaluated are being recorded
+Parameters:
+         none
+Return Value: a bool, true if recording
+Local Variables:
+         none
+Algorithm:
+         1) Return the flag
+Assistance Received: none
+********************************************************************* */
+bool EvaluationCache::isRecording() const
+{
+   return this->recording;
+}
+
+/* *********************************************************************
+Function Name: size()
+Purpose: Get the number of entries in the mapped file
+Parameters:
+         none
+Return Value: a size_t, the number of entries
+Local Variables:
+         none
+Algorithm:
+         1) Return the count from the header
+Assistance Received: none
+********************************************************************* */
+size_t EvaluationCache::size() const
+{
+   return this->count;
+}
+
+/* *********************************************************************
+Function Name: recordedSize()
+Purpose: Get the number of entries recorded
+Parameters:
+         none
+Return Value: a size_t, the number of entries
+Local Variables:
+         none
+Algorithm:
+         1) Return the size of the recorded map
+Assistance Received: none
+********************************************************************* */
+size_t EvaluationCache::recordedSize() const
+{
+   std::lock_guard<std::mutex> guard(this->recordedLock);
+   return this->recorded.size();
+}
+
+/* *********************************************************************
+Function Name: collect()
+Purpose: Add every entry in the mapped file to a map
+Parameters:
+         unordered_map<uint64_t, Entry> &entries, the entries to add to
+Return Value: none
+Local Variables:
+         Entry entry, the entry of a slot
+Algorithm:
+         1) Decode each slot in use, merging with an entry already there
+Assistance Received: none
+********************************************************************* */
+void EvaluationCache::collect(std::unordered_map<std::uint64_t, Entry> &entries) const
+{
+   for (std::uint64_t slot = 0; slot < this->capacity; slot++)
+   {
+      if (this->keys[slot] == 0)
+      {
+         continue;
+      }
+
+      Entry entry;
+      entry.deadwood = this->values[slot] & ((1u << DEADWOOD_BITS) - 1);
+      entry.discard = this->values[slot] >> DEADWOOD_BITS;
+
+      std::pair<std::unordered_map<std::uint64_t, Entry>::iterator, bool> inserted = entries.insert({ this->keys[slot], entry });
+      if (!inserted.second)
+      {
+         merge(inserted.first->second, entry);
+      }
+   }
+}
+
+/* *********************************************************************
+Function Name: saveRecorded()
+Purpose: Save the recorded entries as a cache file
+Parameters:
+         const string &fileName, the file to write
+Return Value: a bool, true if it could not be written
+Local Variables:
+         none
+Algorithm:
+         1) Write the recorded entries while holding the lock
+Assistance Received: none
+********************************************************************* */
+bool EvaluationCache::saveRecorded(const std::string &fileName) const
+{
+   std::lock_guard<std::mutex> guard(this->recordedLock);
+   return save(this->recorded, fileName);
+}
+
+/* *********************************************************************
+Function Name: save()
+Purpose: Write entries as a cache file
+Parameters:
+         const unordered_map<uint64_t, Entry> &entries, the entries
+         const string &fileName, the file to write
+Return Value: a bool, true if it could not be written
+Local Variables:
+         uint64_t capacity, the number of slots
+         vector<uint64_t> keys, vector<uint32_t> values, the slots
+         string temporary, the file written before it's renamed
+         ofstream file, the file being written
+Algorithm:
+         1) Take the smallest power of two with SLOTS_PER_ENTRY slots for
+            each entry
+         2) Put each entry in the first free slot from its key's own,
+            wrapping around
+         3) Write the header and slots to a temporary file and rename it
+            over fileName, which replaces it in one step
+Assistance Received: none
+********************************************************************* */
+bool EvaluationCache::save(const std::unordered_map<std::uint64_t, Entry> &entries, const std::string &fileName)
+{
+   std::uint64_t capacity = 16;
+   while (capacity < entries.size() * SLOTS_PER_ENTRY)
+   {
+      capacity *= 2;
+   }
+
+   std::vector<std::uint64_t> keys(capacity, 0);
+   std::vector<std::uint32_t> values(capacity, 0);
+   for (const std::pair<const std::uint64_t, Entry> &entry : entries)
+   {
+      std::uint64_t slot = entry.first & (capacity - 1);
+      while (keys[slot] != 0)
+      {
+         slot = (slot + 1) & (capacity - 1);
+      }
+
+      keys[slot] = entry.first;
+      values[slot] = static_cast<std::uint32_t>(entry.second.deadwood) | static_cast<std::uint32_t>(entry.second.discard) << DEADWOOD_BITS;
+   }
+
+   char header[HEADER_SIZE] = { 0 };
+   std::uint32_t rules = RULES_VERSION;
+   std::uint32_t count = static_cast<std::uint32_t>(entries.size());
+   std::uint64_t keyCheck = Zobrist::roundKey(1);
+   std::memcpy(header, MAGIC, sizeof(MAGIC));
+   header[4] = static_cast<char>(FORMAT_VERSION);
+   std::memcpy(header + 8, &rules, sizeof(rules));
+   std::memcpy(header + 12, &count, sizeof(count));
+   std::memcpy(header + 16, &keyCheck, sizeof(keyCheck));
+   std::memcpy(header + 24, &capacity, sizeof(capacity));
+
+   std::string temporary = fileName + ".tmp";
+   {
+      std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+      file.write(header, HEADER_SIZE);
+      file.write(reinterpret_cast<const char *>(keys.data()), capacity * sizeof(std::uint64_t));
+      file.write(reinterpret_cast<const char *>(values.data()), capacity * sizeof(std::uint32_t));
+      if (!file)
+      {
+         std::remove(temporary.c_str());
+         return true;
+      }
+   }
+
+   return std::rename(temporary.c_str(), fileName.c_str()) != 0;
+}
+
+/* *********************************************************************
+Function Name: merge()
+Purpose: Combine two entries for the same hand
+Parameters:
+         Entry &into, the entry to fill in
+         const Entry &from, the other entry
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Both have the same deadwood, so only the discard can be
+            missing from one of them
+Assistance Received: none
+********************************************************************* */
+void EvaluationCache::merge(Entry &into, const Entry &from)
+{
+   if (into.discard == NO_DISCARD)
+   {
+      into.discard = from.discard;
+   }
+}
+
+/* *********************************************************************
+Function Name: shared()
+Purpose: Get the cache the game and the tools evaluate hands through
+Parameters:
+         none
+Return Value: an EvaluationCache&, the cache, empty if there is no cache
+   file
+Local Variables:
+         EvaluationCache cache, the cache, mapped once
+         bool opened, whether it has been mapped
+Algorithm:
+         1) Map DEFAULT_FILE_NAME the first time, a missing or stale file
+            leaves the cache empty and every hand is evaluated
+Assistance Received: none
+********************************************************************* */
+EvaluationCache &EvaluationCache::shared()
+{
+   static EvaluationCache cache;
+   static bool opened = !cache.open(DEFAULT_FILE_NAME);
+   (void)opened;
+
+   return cache;
+}
+
+/* *********************************************************************
+Function Name: findMapped()
+Purpose: Find a hand's entry in the mapped file
+Parameters:
+         uint64_t key, the hand's key
+         Entry &entry, set to its entry
+Return Value: a bool, false if the file doesn't have it
+Local Variables:
+         uint64_t slot, the slot being probed
+Algorithm:
+         1) Probe from the key's own slot until the key or an empty slot
+Assistance Received: none
+********************************************************************* */
+bool EvaluationCache::findMapped(std::uint64_t key, Entry &entry) const
+{
+   if (this->capacity == 0)
+   {
+      return false;
+   }
+
+   for (std::uint64_t slot = key & (this->capacity - 1); this->keys[slot] != 0; slot = (slot + 1) & (this->capacity - 1))
+   {
+      if (this->keys[slot] == key)
+      {
+         entry.deadwood = this->values[slot] & ((1u << DEADWOOD_BITS) - 1);
+         entry.discard = this->values[slot] >> DEADWOOD_BITS;
+         return true;
+      }
+   }
+
+   return false;
+}
@@ -0,0 +1,132 @@
+#ifndef EVALUATIONCACHE_H
+#define EVALUATIONCACHE_H
+
+#include "card.h"
+#include <atomic>          // std::atomic
+#include <cstddef>
+#include <cstdint>
+#include <mutex>           // std::mutex
+#include <string>
+#include <unordered_map>
+
+// What CombinationFinder made of hands other processes have already seen,
+// read from a file mapped into memory (see deadwoodScore() in gameState.h).
+// Hands are keyed by the XOR of their Zobrist keys and the round, so the
+// order of the cards doesn't matter. Suits aren't renamed like in
+// SolutionTable, since CombinationFinder doesn't always arrange a hand the
+// same way when its suits are swapped.
+// The file is an open-addressing hash table that is only ever read, so any
+// number of processes can map it at once. Hands a process evaluates can be
+// recorded and saved to a file of their own, and the cachemerge tool folds
+// those into the shared file offline, writing a new file and renaming it
+// over the old one so readers never see it half written.
+// The header holds a rules version, and a file made under other rules is
+// ignored: bump RULES_VERSION whenever a change to the rules or to
+// CombinationFinder changes what a hand is left with.
+class EvaluationCache
+{
+   public:
+      // File the game and the tools read the cache from
+      static const std::string DEFAULT_FILE_NAME;
+
+      // File format, all numbers in the byte order of the machine that made it:
+      //   0  magic "FCEC"     4  format version   5  unused
+      //   8  rules version (4 bytes)               12 number of entries (4 bytes)
+      //   16 Zobrist key check (8 bytes)           24 capacity, a power of two (8 bytes)
+      //   32 keys (8 bytes each, 0 for an empty slot), then values (4 bytes each)
+      static const char MAGIC[4];
+      static const unsigned char FORMAT_VERSION = 1;
+      static const std::uint32_t RULES_VERSION = 1;
+      static const int HEADER_SIZE = 32;
+
+      // No best discard is known
+      static const int NO_DISCARD = 255;
+
+      // What a hand is left with after CombinationFinder arranges it, and
+      // the card id it does best to discard if that was asked for
+      struct Entry
+      {
+         int deadwood = 0;
+         int discard = NO_DISCARD;
+      };
+
+      EvaluationCache() = default;
+      ~EvaluationCache();
+
+      EvaluationCache(const EvaluationCache &) = delete;
+      EvaluationCache &operator=(const EvaluationCache &) = delete;
+
+      // Map a cache file into memory. Returns true if it could not be opened,
+      // is not a valid cache, or was made under other rules (the cache is
+      // then empty)
+      bool open(const std::string &fileName);
+
+      // Release the mapped file
+      void close();
+
+      // The key of a hand in a round
+      static std::uint64_t key(const unsigned char *ids, int size, int round);
+
+      // Find a hand's entry in the file, or among those recorded. Returns
+      // false if neither has it
+      bool find(std::uint64_t key, Entry &entry) const;
+
+      // Remember an entry to save if recording, merging it with one
+      // already recorded for the hand
+      void record(std::uint64_t key, const Entry &entry);
+
+      // Start or stop recording the hands evaluated
+      void setRecording(bool recording);
+
+      // Check if hands evaluated are being recorded
+      bool isRecording() const;
+
+      // Number of entries in the mapped file
+      size_t size() const;
+
+      // Number of entries recorded
+      size_t recordedSize() const;
+
+      // Add every entry in the mapped file to entries
+      void collect(std::unordered_map<std::uint64_t, Entry> &entries) const;
+
+      // Save the recorded entries as a cache file. Returns true if it
+      // could not be written
+      bool saveRecorded(const std::string &fileName) const;
+
+      // Write entries as a cache file through a temporary file renamed
+      // over fileName. Returns true if it could not be written
+      static bool save(const std::unordered_map<std::uint64_t, Entry> &entries, const std::string &fileName);
+
+      // Fill what into with what from knows that it doesn't
+      static void merge(Entry &into, const Entry &from);
+
+      // The cache read from DEFAULT_FILE_NAME the first time it's asked
+      // for, empty if there is no such file
+      static EvaluationCache &shared();
+
+   private:
+      // Values hold the deadwood in their low bits and the discard above it
+      static const int DEADWOOD_BITS = 16;
+
+      // Slots per entry written, so probes stay short
+      static const int SLOTS_PER_ENTRY = 2;
+
+      // Find a hand's entry in the mapped file
+      bool findMapped(std::uint64_t key, Entry &entry) const;
+
+      // The mapped file
+      void *data = nullptr;
+      size_t length = 0;
+      const std::uint64_t *keys = nullptr;
+      const std::uint32_t *values = nullptr;
+      std::uint64_t capacity = 0;
+      std::uint32_t count = 0;
+
+      // Entries recorded by this process
+      std::atomic<bool> recording{ false };
+      mutable std::mutex recordedLock;
+      std::unordered_map<std::uint64_t, Entry> recorded;
+};
+
+#endif
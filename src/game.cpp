@@ -1,8 +1,10 @@
 #include "game.h"
+#include "zobrist.h"
 
 Game::Game()
 {
-   players[0] = std::shared_ptr<Player>(new Computer());
+   this->computer = std::shared_ptr<Computer>(new Computer());
+   players[0] = this->computer;
    players[1] = std::shared_ptr<Player>(new Human());
    std::cout << "        _.+._" << "         _.+._" << "         _.+._" << "         _.+._" << "         _.+._\n";
    std::cout << "      (^\\/^\\/^)" << "     (^\\/^\\/^)" << "     (^\\/^\\/^)" << "     (^\\/^\\/^)" << "     (^\\/^\\/^)\n";
@@ -21,7 +23,8 @@ Local Variables:
          string startChoice, start a new game, load a game file,
          or exit game
 Algorithm:
-         1) Seed a random time
+         1) Seed a random time, which is also the seed the decks are
+            shuffled with
          2) Get the start choice
          3) Start a new game, load a game file, or exit game
          depending on input
@@ -30,7 +33,8 @@ Assistance Received: none
 void Game::startGame()
 {
    // Seed random time
-   srand(unsigned(time(NULL)));
+   this->seed = unsigned(time(NULL));
+   srand(this->seed);
    startMenu();
    std::string startChoice = getStartChoice();
 
@@ -42,6 +46,7 @@ void Game::startGame()
    // Start new game
    if (startChoice == "1")
    {
+      openJournal();
       firstRound();
       /*nextRound(this->roundNumber);*/
    }
@@ -61,6 +66,57 @@ void Game::startGame()
    }
 }
 
+/* *********************************************************************
+Function Name: setDifficulty()
+Purpose: Set how long the computer may think about each decision
+Parameters:
+         Difficulty difficulty, the difficulty
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Pass the difficulty on to the computer
+Assistance Received: none
+********************************************************************* */
+void Game::setDifficulty(Difficulty difficulty)
+{
+   this->computer->setDifficulty(difficulty);
+}
+
+/* *********************************************************************
+Function Name: setStrategy()
+Purpose: Set the parameters of the computer's rule of thumb
+Parameters:
+         const Strategy &strategy, the parameters
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Pass the strategy on to the computer
+Assistance Received: none
+********************************************************************* */
+void Game::setStrategy(const Strategy &strategy)
+{
+   this->computer->setStrategy(strategy);
+}
+
+/* *********************************************************************
+Function Name: setJournalFile()
+Purpose: Set the file games are journaled to
+Parameters:
+         const string &fileName, the journal file, empty to not journal
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the file name for openJournal()
+Assistance Received: none
+********************************************************************* */
+void Game::setJournalFile(const std::string &fileName)
+{
+   this->journalFileName = fileName;
+}
+
 /* *********************************************************************
 Function Name: startMenu()
 Purpose: Print the start menu
@@ -99,24 +155,16 @@ Assistance Received: none
 ********************************************************************* */
 void Game::firstRound()
 {
-   // Create new round object
-   Round newRound(this->roundNumber);
-
-   // Set the current Round object
-   this->round = newRound;
-
-   // Deal cards to all players
-   dealCards();
-
-   // Discard first card from draw pile and add to discard pile
-   Card discardCard = this->round.drawDeck();
-   setTopOfDiscard(discardCard);
-   this->round.discardCard(discardCard);
-
    // Decide who goes first
    setFirstPlayer();
    int firstPlayer = this->getFirstPlayer();
 
+   // Deal cards to all players and turn over the first discard
+   dealCards(firstPlayer);
+
+   // Record the deal
+   journalState(firstPlayer);
+
    // While no one has gone out, play the next turn
    while (!this->hasPlayerGoneOut)
    {
@@ -128,30 +176,117 @@ void Game::firstRound()
 
 /* *********************************************************************
 Function Name: dealCards()
-Purpose: Deal cards to all players based on the current round
+Purpose: Deal cards to all players based on the current round and turn
+   over the first discard
 Parameters:
+         int firstPlayer, the player to move first
+Return Value: none
+Local Variables:
          none
+Algorithm:
+         1) Start the round's GameState with the game's seed
+         2) Set the players and round to it
+Assistance Received: none
+********************************************************************* */
+void Game::dealCards(int firstPlayer)
+{
+   restoreState(startRound(this->roundNumber, this->seed, firstPlayer, this->players[0]->getPlayerScore(), this->players[1]->getPlayerScore()));
+}
+
+/* *********************************************************************
+Function Name: captureState()
+Purpose: Get the state of the game as a GameState
+Parameters:
+         int playerToMove, the player whose turn is next
+         GameState::Phase phase, whether they're about to draw or
+            discard
+Return Value: a GameState, the state with the player about to draw or
+   discard
+Local Variables:
+         GameState state, the state being created
+         const vector<Card> &drawPile, the draw pile, top first
+         const deque<Card> &discardPile, the discard pile, top first
+Algorithm:
+         1) Copy the round, seed, scores, and player to move
+         2) Copy the ids of each player's hand in order
+         3) Copy the ids of each pile with the top last
+         4) Hash the state
+Assistance Received: none
+********************************************************************* */
+GameState Game::captureState(int playerToMove, GameState::Phase phase) const
+{
+   GameState state = GameState();
+   state.round = this->roundNumber;
+   state.seed = this->seed;
+   state.playerToMove = playerToMove;
+   state.phase = phase;
+   state.goneOutCount = this->goneOutCount;
+   state.lastTurn = this->goneOutCount > 0;
+
+   for (int player = 0; player < PLAYER_COUNT; player++)
+   {
+      state.scores[player] = this->players[player]->getPlayerScore();
+      for (const Card &card : this->players[player]->getHand())
+      {
+         state.hands[player][state.handSizes[player]++] = card.getId();
+      }
+   }
+
+   const std::vector<Card> &drawPile = this->round.getDrawPile();
+   for (std::vector<Card>::const_reverse_iterator card = drawPile.rbegin(); card != drawPile.rend(); ++card)
+   {
+      state.drawPile[state.drawSize++] = card->getId();
+   }
+
+   const std::deque<Card> &discardPile = this->round.getDiscardPile();
+   for (std::deque<Card>::const_reverse_iterator card = discardPile.rbegin(); card != discardPile.rend(); ++card)
+   {
+      state.discardPile[state.discardSize++] = card->getId();
+   }
+   state.hash = Zobrist::hash(state);
+
+   return state;
+}
+
+/* *********************************************************************
+Function Name: restoreState()
+Purpose: Set the players and round to a GameState
+Parameters:
+         const GameState &state, the state to set the game to
 Return Value: none
 Local Variables:
-         vector<vector<Card>> hands, the hands each player will
-         have
+         GameFile cards, the state as cards
 Algorithm:
-         1) Clear players current cards
-         2) Get cards to deal from Round
-         3) Set each players hand
+         1) Create the cards of the state
+         2) Set the round number, scores, and hands
+         3) Set the round's piles and the top of the discard pile
+         4) Start the computer's model of the human's hand
 Assistance Received: none
 ********************************************************************* */
-void Game::dealCards()
+void Game::restoreState(const GameState &state)
 {
+   GameFile cards;
+   cards.setGameState(state);
+
+   this->roundNumber = state.round;
+
    // Clear players cards and discard card
    resetPlayerCards();
 
-   std::vector<std::vector<Card>> hands = this->round.dealCards(this->roundNumber, this->PLAYER_COUNT);
-   for (int i = 0; i < PLAYER_COUNT; i++)
+   this->setPlayerScore(0, state.scores[0]);
+   this->setPlayerScore(1, state.scores[1]);
+   this->players[0]->setHand(cards.getComputerHand());
+   this->players[1]->setHand(cards.getHumanHand());
+
+   this->round = Round(cards.getDrawPile(), cards.getDiscardPile());
+   if (state.discardSize > 0)
    {
-      this->players[i]->setHand(hands[i]);
-      this->players[i]->setHand(hands[i]);
+      setTopOfDiscard(this->round.getTopOfDiscardPile());
    }
+
+   // The computer starts over keeping track of what the human holds
+   std::vector<int> discardPile(state.discardPile, state.discardPile + state.discardSize);
+   this->computer->observeRoundStart(state.round, state.handSizes[1], discardPile);
 }
 
 /* *********************************************************************
@@ -189,9 +324,11 @@ Local Variables:
 Algorithm:
          1) Print the current game stats
          2) Set the current player
-         3) Get the game choice
-         4) Do action based on choice
-         5) Increment current turn number
+         3) On the human's turn, start working out their help and let
+            the computer ponder its replies
+         4) Get the game choice
+         5) Do action based on choice
+         6) Increment current turn number
 Assistance Received: none
 ********************************************************************* */
 // Play the next turn of the round
@@ -203,6 +340,13 @@ void Game::nextTurn()
    // Set current player
    setCurrentPlayer(turnNumber);
 
+   // Work out the human's help and let the computer think while the human decides
+   if (this->players[this->currentPlayer] != this->computer)
+   {
+      startHints();
+      startPondering();
+   }
+
    // Ask player what move they want to make
    int gameChoice = this->players[this->currentPlayer]->chooseGameOption();
 
@@ -210,7 +354,9 @@ void Game::nextTurn()
    if (gameChoice == 1)
    {
       // Save game to file and exit game
+      stopBackgroundWork();
       serializeGame();
+      this->journal.flush();
       exit(EXIT_SUCCESS);
    }
    // Make a move
@@ -228,6 +374,8 @@ void Game::nextTurn()
    // Quit game
    else
    {
+      stopBackgroundWork();
+      this->journal.flush();
       exit(EXIT_SUCCESS);
    }
 
@@ -284,24 +432,19 @@ Local Variables:
          none
 Algorithm:
          1) Loop through all players
-         2) If player has not gone out, update their score
-         3) Otherwise their score remains the same
+         2) Score what's left after their best arrangement, the same one
+            goOut() checks
+         3) A player who went out is left with nothing
 Assistance Received: none
 ********************************************************************* */
 void Game::updatePlayerScores()
 {
    for (int i = 0; i < PLAYER_COUNT; i++)
    {
-      std::vector<Card> hand = players[i]->getHand();
-      CombinationFinder finder(hand);
-      CombinationFinder::Order order = players[i]->bestOrder(hand);
-      finder.findCombinations(order);
-      finder.combineRemainingCards();
-
-      std::vector<Card> remainingCards = finder.retrieveRemainingCards();
-
-      this->players[i]->updatePlayerScore(remainingCards);
+      this->players[i]->updatePlayerScore(Player::bestArrangement(this->players[i]->getHand()).takeResult());
    }
+
+   this->journal.recordRoundEnd(this->players[0]->getPlayerScore(), this->players[1]->getPlayerScore());
 }
 
 /* *********************************************************************
@@ -324,15 +467,13 @@ Assistance Received: none
 ********************************************************************* */
 void Game::nextRound()
 {
-   this->currentPlayer;
-   this->firstPlayerOfNextRound;
-
    this->goneOutCount = 0;
 
    // Check to see if we've played the last round
    if (this->roundNumber > 11)
    {
       printWinner();
+      this->journal.flush();
       std::cin.get();
       exit(EXIT_SUCCESS);
    }
@@ -340,19 +481,11 @@ void Game::nextRound()
    // Prepare the round
    prepareRound();
 
-   // Create new round object
-   Round newRound(this->roundNumber);
+   // Deal cards to all players and turn over the first discard
+   dealCards(this->playerOne);
 
-   // Set the current Round object
-   this->round = newRound;
-
-   // Deal cards to all players
-   dealCards();
-
-   // Discard first card from draw pile and add to discard pile
-   Card discardCard = this->round.drawDeck();
-   setTopOfDiscard(discardCard);
-   this->round.discardCard(discardCard);
+   // Record the deal
+   journalState(this->playerOne);
 
    // While no one has gone out, play the next turn
    while (!this->hasPlayerGoneOut)
@@ -431,9 +564,6 @@ Assistance Received: none
 ********************************************************************* */
 void Game::continueRound()
 {
-   this->currentPlayer;
-   this->firstPlayerOfNextRound;
-
    // While no one has gone out, play the next turn
    while (!this->hasPlayerGoneOut)
    {
@@ -586,8 +716,8 @@ Local Variables:
          int moveChoice, what move they want to make: draw from 
          discard pile or draw from drawing pile
 Algorithm:
-         1) Get move choice
-         2) Get top of draw/discard pile
+         1) Let the computer see the game, then get move choice
+         2) Get top of draw/discard pile, letting the computer see it
          3) Add to players hand
          4) Get the card they want to discard
          5) Check if player can go out
@@ -596,20 +726,26 @@ Assistance Received: none
 void Game::movePlayer()
 {
    int moveChoice;
+
+   // Let the computer see the game in case it's the end of the round
+   if (this->players[this->currentPlayer] == this->computer)
+   {
+      this->computer->setGameState(captureState(this->currentPlayer));
+   }
    
    do {
       try
       {
          moveChoice = players[this->currentPlayer]->move();
       }
-      catch (std::out_of_range)
+      catch (const std::out_of_range &)
       {
          //std::cout << "DECK IS EMPTY!\n";
       }
    } while (moveChoice < 1 || moveChoice > 2);
 
-   // Check to see if deck is empty
-   if (isDeckEmpty())
+   // Draw from the discard pile when the deck can't be drawn from
+   if (this->round.isDrawingPileEmpty())
    {
       moveChoice = static_cast<int>(Player::moveOption::DRAW_DISCARD);
       //moveChoice = 2;
@@ -620,6 +756,8 @@ void Game::movePlayer()
    {
       // Draw card from deck drawing pile
       Card topOfDeck = this->round.drawDeck();
+      this->journal.recordDrawDeck();
+      this->computer->observeDraw(this->players[this->currentPlayer] == this->computer, false, topOfDeck);
 
       // Add to hand
       players[this->currentPlayer]->addToHand(topOfDeck);
@@ -629,6 +767,8 @@ void Game::movePlayer()
    {
       // Draw card from deck discard pile
       Card topOfDiscard = this->round.drawDiscard();
+      this->journal.recordDrawDiscard();
+      this->computer->observeDraw(this->players[this->currentPlayer] == this->computer, true, topOfDiscard);
 
       Card newTopOfDiscard = this->round.getTopOfDiscardPile();
       setTopOfDiscard(newTopOfDiscard);
@@ -644,6 +784,9 @@ void Game::movePlayer()
    // Get discard card from player
    getCardToDiscard();
 
+   // The turn is over, so the hints and pondered replies are out of date
+   stopBackgroundWork();
+
    // Check if player can go out
    bool goneOut = players[this->currentPlayer]->goOut();
    if (goneOut && this->goneOutCount < PLAYER_COUNT)
@@ -661,10 +804,77 @@ void Game::movePlayer()
    }
 }
 
-// Check if the deck is empty (no cards remaining in draw pile)
-bool Game::isDeckEmpty()
+/* *********************************************************************
+Function Name: startPondering()
+Purpose: Let the computer work out its replies to the human's discard
+   while the human decides
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         vector<int> likelyCards, ids of the cards the human is likely to
+            discard
+Algorithm:
+         1) The human discards a card from their hand or the top of the
+            discard pile if they draw it, so try those first
+         2) Start the computer's worker
+Assistance Received: none
+********************************************************************* */
+void Game::startPondering()
+{
+   std::vector<int> likelyCards;
+   for (const Card &card : this->players[this->currentPlayer]->getHand())
+   {
+      likelyCards.push_back(card.getId());
+   }
+
+   if (!this->round.getDiscardPile().empty())
+   {
+      likelyCards.push_back(this->round.getTopOfDiscardPile().getId());
+   }
+
+   this->computer->startPondering(this->roundNumber, likelyCards);
+}
+
+/* *********************************************************************
+Function Name: startHints()
+Purpose: Work out the help the human can ask for as their turn starts
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         const vector<Card> &drawPile, the draw pile, top first
+         Card deckCard, the top of the deck, blank if it's empty
+Algorithm:
+         1) Start working out the draw help for the human's hand and
+            discard card, and the discard help after either draw
+Assistance Received: none
+********************************************************************* */
+void Game::startHints()
+{
+   const std::vector<Card> &drawPile = this->round.getDrawPile();
+   Card deckCard = drawPile.empty() ? Card() : drawPile.front();
+
+   this->hints.start(this->players[this->currentPlayer]->getHand(), this->players[this->currentPlayer]->getDiscardCard(), deckCard);
+}
+
+/* *********************************************************************
+Function Name: stopBackgroundWork()
+Purpose: Stop the work done in the background during the human's turn
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Stop working out hints
+         2) Stop the computer pondering
+Assistance Received: none
+********************************************************************* */
+void Game::stopBackgroundWork()
 {
-   return (this->round.isDrawingPileEmpty() ? true : false);
+   this->hints.stop();
+   this->computer->stopPondering();
 }
 
 /* *********************************************************************
@@ -679,11 +889,13 @@ Local Variables:
          Card cardToDiscard
 Algorithm:
          1) Print game stats
-         2) Get name of card to discard
+         2) Let the computer see the game, then get name of card to
+         discard
          3) Get the index of that card
          4) Validate input
          5) Discard the card
-         6) Add to discard pile and set player's discard card
+         6) Add to discard pile and set player's discard card, letting the
+         computer see it
 Assistance Received: none
 ********************************************************************* */
 void Game::getCardToDiscard()
@@ -693,6 +905,11 @@ void Game::getCardToDiscard()
       // Print current game stats
       printGameStats();
 
+      if (this->players[this->currentPlayer] == this->computer)
+      {
+         this->computer->setGameState(captureState(this->currentPlayer, GameState::Phase::DISCARD));
+      }
+
       std::pair<bool, std::string> nameOfCardAndHelp = this->players[this->currentPlayer]->getCardToDiscard();
 
       if (nameOfCardAndHelp.first)
@@ -721,6 +938,8 @@ void Game::getCardToDiscard()
 
       // Add to discard pile
       this->round.discardCard(cardToDiscard);
+      this->journal.recordDiscard(cardToDiscard.getId());
+      this->computer->observeDiscard(this->players[this->currentPlayer] == this->computer, cardToDiscard);
 
       // Set players top of discard card
       setTopOfDiscard(cardToDiscard);
@@ -739,24 +958,33 @@ Parameters:
          none
 Return Value: none
 Local Variables:
-         vector<Card> hand, current player's hand
+         const Hand &hand, current player's hand
          Card discardCard, the current player's discard card
+         Computer::Hint hint, the computer's suggestion
 Algorithm:
          1) Get current player's hand
          2) Get current player's discard card
-         3) Call Computer's help function and pass in cards
+         3) Use the hint worked out when the turn started if there is
+            one for these cards, otherwise ask the computer now
+         4) Print the hint
 Assistance Received: none
 ********************************************************************* */
 void Game::askComputerForHelp(Computer::Help helpType)
 {
    // Get the current players hand
-   std::vector<Card> hand = this->players[this->currentPlayer]->getHand();
+   const Hand &hand = this->players[this->currentPlayer]->getHand();
 
    // Get the current players discard card
    Card discardCard = this->players[this->currentPlayer]->getDiscardCard();
 
    // Ask computer for help
-   Computer::help(hand, discardCard, helpType);
+   Computer::Hint hint;
+   if (!this->hints.find(hand, discardCard, helpType, hint))
+   {
+      hint = Computer::findHint(hand, discardCard, helpType);
+   }
+
+   Computer::printHint(hint);
 }
 
 /* *********************************************************************
@@ -783,7 +1011,7 @@ Function Name: setPlayerHand()
 Purpose: Set the players hand
 Parameters:
          int player, the player that will have its hand set
-         vector<Card> hand, the hand of the player
+         const Hand &hand, the hand of the player
 Return Value: none
 Local Variables:
          none
@@ -791,7 +1019,7 @@ Algorithm:
          1) Set players hand to cards passed in
 Assistance Received: none
 ********************************************************************* */
-void Game::setPlayerHand(int player, std::vector<Card> hand)
+void Game::setPlayerHand(int player, const Hand &hand)
 {
    this->players[player]->setHand(hand);
 }
@@ -863,19 +1091,14 @@ Return Value: none
 Local Variables:
          GameFile load, object that stores all game values
          bool fail, check to see if file opened succesfully
-         int gameRound, round from save file
-         int computerScore, computer score from save file
-         int humanScore, human score from save file
-         int nextPlayer, next player from save file
-         vector<Card> computerHand, computer hand from save file
-         vector<Card> humanHand, human hand from save file
-         vector<Card> drawPile, draw pile from save file
-         deque<Card> discardPile, discard pile from save file
+         GameState state, the state in the file
 
 Algorithm:
-         1) Open save file
-         2) Set all values from save file
-         3) Continue the round
+         1) Open and parse save file, going back to the menu if either fails
+         2) Set all values from save file, going back to the menu if they
+            don't fit in a game
+         3) Start a journal with the loaded state
+         4) Continue the round
 Assistance Received: none
 ********************************************************************* */
 void Game::loadGameFile()
@@ -884,50 +1107,32 @@ void Game::loadGameFile()
    GameFile load;
    bool fail = load.openFile();
    
-   // If the file failed to open, get the game option again
-   if (fail)
+   // If the file failed to open or isn't a valid game file, get the game option again
+   if (fail || load.parseFile())
    {
       this->startGame();
+      return;
    }
 
-   // Parse the file we opened
-   load.parseFile();
-
-   int gameRound = load.getGameRound();
-   int computerScore = load.getComputerScore();
-   int humanScore = load.getHumanScore();
-   int nextPlayer = load.getNextPlayer();
-
-   std::vector<Card> computerHand = load.getComputerHand();
-   std::vector<Card> humanHand = load.getHumanHand();
-   std::vector<Card> drawPile = load.getDrawPile();
-
-   std::deque<Card> discardPile = load.getDiscardPile();
+   // Set the round, scores, hands, and piles from the file, if they fit in a game
+   GameState state;
+   if (load.toGameState(state))
+   {
+      std::cerr << "Invalid game file: " << load.getError() << "\n";
+      this->startGame();
+      return;
+   }
+   restoreState(state);
 
    this->currentPlayer = load.getNextPlayer();
 
-   // Set game state
-   // 1. Set current round
-   this->roundNumber = gameRound;
-
-   // 2. Set scores
-   this->setPlayerScore(0, computerScore);
-   this->setPlayerScore(1, humanScore);
-
-   // 3. Set player hands
-   this->players[0]->setHand(computerHand);
-   this->players[1]->setHand(humanHand);
-
-   // 4. Set Round object and set drawing pile and discard pile
-   Round round(drawPile, discardPile);
-   this->round = round;
-
-
-   // Set current turn number
+   // Set current turn number, counting turns from the Computer
    this->turnNumber = currentPlayer;
+   this->playerOne = 0;
 
-   // 5. Set player top of hand
-   setTopOfDiscard(discardPile[0]);
+   // Start a new journal from the loaded game
+   openJournal();
+   journalState(this->currentPlayer);
    
    // Continue round
    continueRound();
@@ -941,125 +1146,150 @@ Parameters:
          none
 Return Value: none
 Local Variables:
+         GameFile save, the game file to save to
+         string fileName, the file to save to
+         int nextPlayer, the player to move after this turn
          string gameState, the current state of the game
 Algorithm:
-         1) Add round number to gameState
-         2) Add player hand and scores to gameState
-         3) Add draw pile and discard pile to gameState
-         4) Save the game
+         1) Get the file to save to
+         2) If it has the snapshot extension, save the game as a binary
+            snapshot
+         3) Otherwise add round number, player hands and scores, draw
+            pile, discard pile, and next player to the text gameState
+         4) Save the game, asking for another file if it can't be written
 Assistance Received: none
 ********************************************************************* */
 void Game::serializeGame()
 {
-   // Add round number to game state
-   std::string gameState = "Round: ";
-   gameState += std::to_string(roundNumber) + "\n\n";
+   GameFile save;
+   std::string fileName = save.getSaveFileName();
+   int nextPlayer = (this->currentPlayer + 1) % PLAYER_COUNT;
+   std::string gameState;
 
-   // Add players, their scores, and hands to game state
-   for (int i = 0; i < PLAYER_COUNT; i++)
+   if (GameFile::isSnapshotFileName(fileName))
    {
-      gameState += this->players[i]->serialize();
-      gameState += "\n\n";
+      save.setGameState(captureState(nextPlayer));
+      gameState = save.serializeSnapshot();
    }
-   gameState += "\n";
+   else
+   {
+      // Every card is at most 3 characters with its separator
+      gameState.reserve(256 + 3 * (Card::NUMBER_OF_IDS * 2));
+
+      // Add round number to game state
+      gameState += "Round: ";
+      gameState += std::to_string(roundNumber) + "\n\n";
 
-   // Add draw pile to game state
-   // Add discard pile to game state
-   gameState += round.serializeDeck() + "\n\n";
+      // Add players, their scores, and hands to game state
+      for (int i = 0; i < PLAYER_COUNT; i++)
+      {
+         gameState += this->players[i]->serialize();
+         gameState += "\n\n";
+      }
+      gameState += "\n";
 
-   // Add next player to game state
-   gameState += "Next Player: " + this->players[(this->currentPlayer + 1) % PLAYER_COUNT]->toString();
+      // Add draw pile to game state
+      // Add discard pile to game state
+      gameState += round.serializeDeck() + "\n\n";
+
+      // Add next player to game state
+      gameState += "Next Player: " + this->players[nextPlayer]->toString();
+   }
 
    // Save the game
-   GameFile save;
-   save.saveGameToFile(gameState);
+   while (save.saveGameToFile(fileName, gameState))
+   {
+      std::cout << "Invalid file name!\n";
+      fileName = save.getSaveFileName();
+   }
 }
 
 /* *********************************************************************
-Function Name: determineWinner()
-Purpose: Determine the winner of the game
+Function Name: openJournal()
+Purpose: Start journaling the game so it can be recovered or replayed
 Parameters:
          none
-Return Value: an int, which is the index of the player who won
+Return Value: none
 Local Variables:
-         vector<pair<int, int>> scores, keep track of which player
-         has what score
-         int winner, the winner of the game
+         none
 Algorithm:
-         1) While no player has gone out, play next turn
-         2) Update players scores
+         1) Do nothing unless a journal file was set
+         2) Open the journal, the game carries on without one if it
+            can't be opened
+         3) Record the seed
 Assistance Received: none
 ********************************************************************* */
-int Game::determineWinner()
+void Game::openJournal()
 {
-   // Check if there is a tie
-   if (isTie())
+   if (this->journalFileName.empty())
    {
-      return -1;
+      return;
    }
 
-   // Get all player scores
-   // Pair of player score and their index in player array
-   std::vector<std::pair<int, int>> scores;
-
-   for (int i = 0; i < PLAYER_COUNT; i++)
+   if (this->journal.open(this->journalFileName))
    {
-      scores.push_back(std::make_pair(players[i]->getPlayerScore(), i));
+      std::cerr << "Journal " << this->journalFileName << " could not be opened, the game will not be recorded\n";
+      return;
    }
 
-   // Sort scores
-   sort(scores.begin(), scores.end());
+   this->journal.recordSeed(this->seed);
+}
 
-   for (size_t i = 0; i < scores.size(); i++)
+/* *********************************************************************
+Function Name: journalState()
+Purpose: Record the whole game state in the journal
+Parameters:
+         int playerToMove, the player whose turn is next
+Return Value: none
+Local Variables:
+         GameFile state, the game state to record
+Algorithm:
+         1) Skip it if the game isn't being journaled
+         2) Set the game file to the current state
+         3) Record its snapshot
+Assistance Received: none
+********************************************************************* */
+void Game::journalState(int playerToMove)
+{
+   if (!this->journal.isOpen())
    {
-      std::cout << scores[i].first << " "
-         << scores[i].second << "\n";
+      return;
    }
 
-   // Since it's sorted ascending, the winner will be the first one
-   int winner = scores[0].second;
+   GameFile state;
+   state.setGameState(captureState(playerToMove));
 
-   return winner;
+   this->journal.recordState(state.serializeSnapshot());
 }
 
-
 /* *********************************************************************
-Function Name: isTie()
-Purpose: Determine if game resulted in a tie
+Function Name: determineWinner()
+Purpose: Determine the winner of the game
 Parameters:
          none
-Return Value: a bool determining if there is a tie or not
+Return Value: an int, which is the index of the player who won, or -1
+   if it's a tie
 Local Variables:
-         int sameScoreCheck, check if all players have same score
-         int firstPlayerScore, score of first player
+         int scores[], each player's score
 Algorithm:
-         1) Set first players score
-         2) Loop through rest of players
-         3) If score is the same for all, we have a tie, return true
-         4) Return false
+         1) Get every player's score
+         2) The lowest score wins unless they're all the same (see
+            winnerOf(), which headless games use too)
 Assistance Received: none
 ********************************************************************* */
-bool Game::isTie()
+int Game::determineWinner()
 {
-   int sameScoreCheck = 1;
-   int firstPlayerScore = players[0]->getPlayerScore();
-
-   for (int i = 1; i < PLAYER_COUNT; i++)
+   int scores[PLAYER_COUNT];
+   for (int i = 0; i < PLAYER_COUNT; i++)
    {
-      if (sameScoreCheck == PLAYER_COUNT)
-      {
-         return true;
-      }
-
-      if (players[i]->getPlayerScore() == firstPlayerScore)
-      {
-         sameScoreCheck++;
-      }
+      scores[i] = players[i]->getPlayerScore();
+      std::cout << scores[i] << " " << i << "\n";
    }
 
-   return false;
+   return winnerOf(scores);
 }
 
+
 /* *********************************************************************
 Function Name: printWinner()
 Purpose: Prints the winner of the game
@@ -5,11 +5,12 @@
 #include "human.h"
 #include "computer.h"
 #include "gameFile.h"
+#include "journal.h"
+#include "hintCache.h"
 
 #include <memory>         // smart pointers
 #include <stdlib.h>         // srand, rand
 #include <fstream>         // fstream for reading and writing files
-#include <regex>
 #include <unordered_map>   // to store value of game file
 
 
@@ -31,12 +32,28 @@ class Game
        */
       void startGame();
 
+      /**
+       * @brief Set how long the computer may think about each decision
+       */
+      void setDifficulty(Difficulty difficulty);
+
+      /**
+       * @brief Set the parameters of the computer's rule of thumb (see Strategy)
+       */
+      void setStrategy(const Strategy &strategy);
+
+      /**
+       * @brief Journal the game to the file, games aren't journaled unless one is set
+       */
+      void setJournalFile(const std::string &fileName);
+
 
    private:
       Round round;                                 // the actual round object
       int roundNumber = 1;                           // number of round we're on
       static const int PLAYER_COUNT = 2;                   // number of players in the game
       std::shared_ptr<Player> players[2];                  // array of players
+      std::shared_ptr<Computer> computer;                  // the computer player, also in players
       int scores[2] = { 0 };                           // the total scores of all the players
       int playerOne;                                 // the first player to move
       int currentPlayer;                              // the player whose turn it currently is
@@ -46,6 +63,11 @@ class Game
 
       int goneOutCount = 0;
 
+      unsigned seed = 0;                              // seed the decks are shuffled with
+      Journal journal;                              // record of the game for recovery and replay
+      std::string journalFileName;                  // where the journal is written, empty for none
+      HintCache hints;                              // help for the human worked out ahead of time
+
       /**
        * @brief Print menu when game starts
        *
@@ -72,9 +94,16 @@ class Game
       // Starts the first round of the game
       void firstRound();
 
-      // Deal cards to all players
+      // Deal cards to all players and turn over the first discard
       // Clear hands before dealing to make sure they have none beforehand
-      void dealCards();
+      void dealCards(int firstPlayer);
+
+      // Get the state of the game, with the player to move about to draw (or
+      // to discard, in the phase given)
+      GameState captureState(int playerToMove, GameState::Phase phase = GameState::Phase::DRAW) const;
+
+      // Set the players and round to the state
+      void restoreState(const GameState &state);
 
       // Clear players hand and discard card
       void resetPlayerCards();
@@ -120,8 +149,14 @@ class Game
       // Make the move for the player
       void movePlayer();
 
-      // Check if the deck is empty (no cards remaining in draw pile)
-      bool isDeckEmpty();
+      // Let the computer work out its replies while the human decides on their turn
+      void startPondering();
+
+      // Work out the help the human can ask for as their turn starts
+      void startHints();
+
+      // Stop the work done in the background during the human's turn
+      void stopBackgroundWork();
 
       // Get the card the player is discarding
       void getCardToDiscard();
@@ -134,7 +169,7 @@ class Game
 
       // Set the players hand to the cards passed in
       // this calls Player::addToHand() function that takes in cards and adds them to its current hand
-      void setPlayerHand(int player, std::vector<Card> hand);
+      void setPlayerHand(int player, const Hand &hand);
 
       // Set the draw pile to the cards passed in
       void setDrawPile(std::vector<Card> drawPile);
@@ -153,15 +188,17 @@ class Game
       // Save the current game state. Called when use specifies they want to save the game
       void serializeGame();
 
+      // Start journaling the game and record the seed
+      void openJournal();
+
+      // Record the whole game state in the journal, after a deal or a load
+      void journalState(int playerToMove);
+
       // Determine the winner of the game
-      // Returns the index of the player with the highest score
+      // Returns the index of the player with the lowest score
       // If scores are tied, returns -1
       int determineWinner();
 
-      // Determine if there is a tie in the game
-      // A tie is if players have the same score
-      bool isTie();
-
       // Print the winner of the game
       // Called when round 11 ends
       void printWinner();
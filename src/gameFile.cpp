@@ -1,29 +1,63 @@
 #include "gameFile.h"
+#include "journalReader.h"   // to recover a game from its journal
+#include "zobrist.h"
+#include <charconv>      // std::from_chars
 
+const char GameFile::SNAPSHOT_MAGIC[4] = { 'F', 'C', 'S', 'V' };
+const std::string GameFile::SNAPSHOT_EXTENSION = ".fcs";
+
+namespace
+{
+   // Bits for each required key of the game file
+   const unsigned ROUND_KEY = 1 << 0;
+   const unsigned COMPUTER_SCORE_KEY = 1 << 1;
+   const unsigned COMPUTER_HAND_KEY = 1 << 2;
+   const unsigned HUMAN_SCORE_KEY = 1 << 3;
+   const unsigned HUMAN_HAND_KEY = 1 << 4;
+   const unsigned DRAW_PILE_KEY = 1 << 5;
+   const unsigned DISCARD_PILE_KEY = 1 << 6;
+   const unsigned NEXT_PLAYER_KEY = 1 << 7;
+
+   // The rounds of a game
+   const int FIRST_ROUND = 1;
+   const int LAST_ROUND = 11;
+
+   // Most copies of a card in a hand or pile (the game uses two decks)
+   const int MAX_COPIES = 2;
+
+   // Sections of the game file that Score and Hand belong to
+   const int COMPUTER_SECTION = 0;
+   const int HUMAN_SECTION = 1;
+
+   // Check if a character is whitespace within a line
+   inline bool isBlank(char character)
+   {
+      return character == ' ' || character == '\t' || character == '\r';
+   }
+}
 
 /* *********************************************************************
 Function Name: openFile()
 Purpose: Try and open user specified file
 Parameters:
          none
-Return Value: a bool, whether or not file was successfull opened
+Return Value: a bool, true if the file could not be opened
 Local Variables:
          string gameFileName, name of game file
 Algorithm:
-         1) Open file
-         2) If file failed, return true
-         3) Otherwise return false
+         1) Get the name of the game file
+         2) Read the whole file into memory
+         3) If it couldn't be read, return true
+         4) Otherwise return false
 Assistance Received: none
 ********************************************************************* */
 bool GameFile::openFile()
 {
    std::string gameFileName = getGameFileName();
 
-   loadFile.open(gameFileName);
-
    // Abort if file can't be opened
    // Potentially change so that user can try again
-   if (!loadFile)
+   if (readFile(gameFileName, this->fileContents))
    {
       std::cerr << "Game file " << gameFileName << " could not be opened\n";
       return true;
@@ -55,211 +89,683 @@ std::string GameFile::getGameFileName()
 }
 
 
+/* *********************************************************************
+Function Name: readFile()
+Purpose: Read a whole file into memory with a single read
+Parameters:
+         const string &fileName, the file to read
+         string &contents, where to store the file
+Return Value: a bool, true if the file could not be read
+Local Variables:
+         ifstream file, the file being read
+         streamoff size, the size of the file
+Algorithm:
+         1) Open the file at its end to get its size
+         2) Size contents to fit the file
+         3) Read the file into contents
+Assistance Received: none
+********************************************************************* */
+bool GameFile::readFile(const std::string &fileName, std::string &contents)
+{
+   std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+
+   if (!file)
+   {
+      return true;
+   }
+
+   std::streamoff size = file.tellg();
+   contents.resize(static_cast<size_t>(size));
+
+   file.seekg(0);
+   file.read(&contents[0], size);
+
+   return !file;
+}
+
 /* *********************************************************************
 Function Name: parseFile()
-Purpose: Get name of game file
+Purpose: Parse the file that was opened with openFile()
 Parameters:
          none
-Return Value: none
+Return Value: a bool, true if the file is not a valid game file
+Local Variables:
+         none
+Algorithm:
+         1) Load the file as a snapshot or journal if it starts with
+            their magic, otherwise parse it as a text game file
+         2) If it failed, print where and why
+Assistance Received: none
+********************************************************************* */
+bool GameFile::parseFile()
+{
+   if (parseContents())
+   {
+      std::cerr << "Invalid game file: " << getError() << "\n";
+      return true;
+   }
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: loadFromFile()
+Purpose: Read and parse the given file without asking the user for
+   anything. Used when loading many game files at once
+Parameters:
+         const string &fileName, the game file to load
+Return Value: a bool, true if it could not be read or is not a valid
+   game file
+Local Variables:
+         none
+Algorithm:
+         1) Read the file into memory
+         2) Load it as a snapshot or journal, or parse it as a text
+            game file
+Assistance Received: none
+********************************************************************* */
+bool GameFile::loadFromFile(const std::string &fileName)
+{
+   if (readFile(fileName, this->fileContents))
+   {
+      return setError(0, 0, "could not open " + fileName);
+   }
+
+   return parseContents();
+}
+
+/* *********************************************************************
+Function Name: parseContents()
+Purpose: Load the contents of the file in whichever format it's in
+Parameters:
+         none
+Return Value: a bool, true if it is not a valid game file
+Local Variables:
+         none
+Algorithm:
+         1) If it starts with the snapshot magic, load the snapshot
+         2) If it starts with the journal magic, replay the journal
+         3) Otherwise parse it as a text game file
+Assistance Received: none
+********************************************************************* */
+bool GameFile::parseContents()
+{
+   if (isSnapshot(this->fileContents))
+   {
+      return parseSnapshot(this->fileContents);
+   }
+
+   if (Journal::isJournal(this->fileContents))
+   {
+      return parseJournal(this->fileContents);
+   }
+
+   return parseBuffer(this->fileContents);
+}
+
+/* *********************************************************************
+Function Name: parseJournal()
+Purpose: Recover a game by replaying its whole journal
+Parameters:
+         string_view journal, the contents of the journal
+Return Value: a bool, true if it is not a valid journal
+Local Variables:
+         JournalReader reader, replays the journal
+Algorithm:
+         1) Replay every record of the journal
+         2) Set the game to the state it ended in
+Assistance Received: none
+********************************************************************* */
+bool GameFile::parseJournal(std::string_view journal)
+{
+   JournalReader reader;
+
+   if (reader.load(journal) || reader.replay() || reader.toGameFile(*this))
+   {
+      return setError(0, 0, reader.getError());
+   }
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: parseBuffer()
+Purpose: Parse a game file that is already in memory in a single pass,
+   without copying any of it
+Parameters:
+         string_view text, the contents of the game file
+Return Value: a bool, true if it is not a valid game file
 Local Variables:
-         string line, the line of the file
-         int colonLocation, location on line where there is a colon
-         string key, the key of the line
-         string value, the value of the line
-         regex regex("\\s+"), to remove whitespaces
+         int lineNumber, the current line number
+         size_t lineStart, where the current line starts in text
+         size_t lineEnd, where the current line ends in text
+         int section, whether Score and Hand belong to the Computer
+            or the Human
+         int scoresSeen, the number of Score lines seen
+         int handsSeen, the number of Hand lines seen
+         unsigned keysSeen, a bit for each required key that was seen
 Algorithm:
-         1) For each line, get the key and value associated
-         2) Add to unordered map member variable where the key is
-         the variable (i.e. score, hand, etc) and the value is
-         what's after the colon : (i.e. "1", "S6 S5 S4", etc)
-         3) Based on these construct the cards and values
+         1) Clear anything from a previous parse
+         2) Split the text into lines and parse each one; a line is
+            "Key: value" where whitespace in the key is ignored
+         3) Make sure every required key was seen
+         4) Create the hands and piles from the card ids
 Assistance Received: none
 ********************************************************************* */
-void GameFile::parseFile()
+bool GameFile::parseBuffer(std::string_view text)
 {
-   std::string line;
-   int colonLocation;
-   std::string key;
-   std::string value;
+   this->computerHandIds.clear();
+   this->humanHandIds.clear();
+   this->drawPileIds.clear();
+   this->discardPileIds.clear();
+   this->errorLine = 0;
+   this->errorColumn = 0;
+   this->errorMessage.clear();
 
-   // To remove whitespaces
-   std::regex regex("\\s+");
+   int lineNumber = 0;
+   int section = -1;
+   int scoresSeen = 0;
+   int handsSeen = 0;
+   unsigned keysSeen = 0;
 
-   // While not at end of file
-   while (!loadFile.eof())
+   size_t lineStart = 0;
+   while (lineStart < text.size())
    {
-      // Get the current line
-      getline(loadFile, line);
+      size_t lineEnd = text.find('\n', lineStart);
+      if (lineEnd == std::string_view::npos)
+      {
+         lineEnd = text.size();
+      }
 
-      // If it's not a whitespace line, get position of :
-      if (!std::all_of(line.begin(), line.end(), isspace))
+      lineNumber++;
+      if (parseLine(text.substr(lineStart, lineEnd - lineStart), lineNumber, section, scoresSeen, handsSeen, keysSeen))
       {
-         // Get location of colon
-         colonLocation = line.find(":");
-         key = line.substr(0, colonLocation);
+         return true;
+      }
 
-         // Remove all whitespace from key if it begins with a white space
-         key = std::regex_replace(key, regex, "");
-         value = line.substr(colonLocation + 1, line.length());
+      lineStart = lineEnd + 1;
+   }
 
-         // Delete extra whitespace if it exists
-         if (value[0] == ' ')
-         {
-            value.erase(0, 1);
-         }
+   // Make sure every part of the game was in the file
+   const std::pair<unsigned, const char *> requiredKeys[] = {
+      { ROUND_KEY, "Round" }, { COMPUTER_SCORE_KEY, "Computer Score" }, { COMPUTER_HAND_KEY, "Computer Hand" },
+      { HUMAN_SCORE_KEY, "Human Score" }, { HUMAN_HAND_KEY, "Human Hand" }, { DRAW_PILE_KEY, "Draw Pile" },
+      { DISCARD_PILE_KEY, "Discard Pile" }, { NEXT_PLAYER_KEY, "Next Player" }
+   };
 
-         // If we come across Scores or Hand again, this is the Human's score and hand
-         if (this->gameValues.count(key) > 0)
-         {
-            key.insert(0, "Human");
-         }
+   for (const auto &key : requiredKeys)
+   {
+      if (!(keysSeen & key.first))
+      {
+         return setError(lineNumber + 1, 1, std::string("missing ") + key.second);
+      }
+   }
+
+   createCards();
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: parseLine()
+Purpose: Parse a single "Key: value" line of the game file
+Parameters:
+         string_view line, the line without its newline
+         int lineNumber, the number of the line (starting at 1)
+         int &section, whether Score and Hand belong to the Computer
+            or the Human
+         int &scoresSeen, the number of Score lines seen
+         int &handsSeen, the number of Hand lines seen
+         unsigned &keysSeen, a bit for each required key seen
+Return Value: a bool, true if the line is not valid
+Local Variables:
+         size_t position, the current position in the line
+         char key[], the key with whitespace removed
+         size_t keyLength, the length of the key
+         size_t colon, the position of the colon
+         string_view value, the text after the colon
+         int valueColumn, the column the value starts at
+         int owner, the section a Score or Hand line belongs to
+Algorithm:
+         1) Skip blank lines
+         2) Find the colon, and build the key from the characters before
+            it that aren't whitespace
+         3) "Computer" and "Human" start the section Score and Hand
+            belong to; without them the first Score and Hand are the
+            Computer's and the second are the Human's
+         4) Parse the value based on the key
+Assistance Received: none
+********************************************************************* */
+bool GameFile::parseLine(std::string_view line, int lineNumber, int &section, int &scoresSeen, int &handsSeen, unsigned &keysSeen)
+{
+   size_t position = 0;
+   while (position < line.size() && isBlank(line[position]))
+   {
+      position++;
+   }
+
+   // Blank line
+   if (position == line.size())
+   {
+      return false;
+   }
+
+   size_t colon = line.find(':', position);
+   if (colon == std::string_view::npos)
+   {
+      return setError(lineNumber, position + 1, "expected ':' after key");
+   }
+
+   // Key without any whitespace (i.e. "Draw Pile" -> "DrawPile")
+   char key[16];
+   size_t keyLength = 0;
+   for (size_t i = position; i < colon; i++)
+   {
+      if (isBlank(line[i]))
+      {
+         continue;
+      }
+
+      if (keyLength == sizeof(key))
+      {
+         return setError(lineNumber, position + 1, "unknown key");
+      }
+
+      key[keyLength++] = line[i];
+   }
+
+   std::string_view keyView(key, keyLength);
+   std::string_view value = line.substr(colon + 1);
+   int valueColumn = colon + 2;
+
+   if (keyView == "Round")
+   {
+      keysSeen |= ROUND_KEY;
+      if (parseNumber(value, lineNumber, valueColumn, this->gameRound))
+      {
+         return true;
+      }
+
+      if (this->gameRound < FIRST_ROUND || this->gameRound > LAST_ROUND)
+      {
+         return setError(lineNumber, valueColumn, "round must be from " + std::to_string(FIRST_ROUND) + " to "
+            + std::to_string(LAST_ROUND));
+      }
+   }
+   else if (keyView == "Computer")
+   {
+      section = COMPUTER_SECTION;
+   }
+   else if (keyView == "Human")
+   {
+      section = HUMAN_SECTION;
+   }
+   else if (keyView == "Score")
+   {
+      int owner = (section != -1) ? section : (scoresSeen == 0 ? COMPUTER_SECTION : HUMAN_SECTION);
+      scoresSeen++;
+
+      if (owner == COMPUTER_SECTION)
+      {
+         keysSeen |= COMPUTER_SCORE_KEY;
+         return parseNumber(value, lineNumber, valueColumn, this->computerScore);
+      }
+
+      keysSeen |= HUMAN_SCORE_KEY;
+      return parseNumber(value, lineNumber, valueColumn, this->humanScore);
+   }
+   else if (keyView == "Hand")
+   {
+      int owner = (section != -1) ? section : (handsSeen == 0 ? COMPUTER_SECTION : HUMAN_SECTION);
+      handsSeen++;
+
+      if (owner == COMPUTER_SECTION)
+      {
+         keysSeen |= COMPUTER_HAND_KEY;
+         this->computerHandIds.clear();
+         return parseCardIds(value, lineNumber, valueColumn, Hand::MAX_CARDS, this->computerHandIds);
+      }
+
+      keysSeen |= HUMAN_HAND_KEY;
+      this->humanHandIds.clear();
+      return parseCardIds(value, lineNumber, valueColumn, Hand::MAX_CARDS, this->humanHandIds);
+   }
+   else if (keyView == "DrawPile")
+   {
+      keysSeen |= DRAW_PILE_KEY;
+      this->drawPileIds.clear();
+      return parseCardIds(value, lineNumber, valueColumn, GameState::DECK_SIZE, this->drawPileIds);
+   }
+   else if (keyView == "DiscardPile")
+   {
+      keysSeen |= DISCARD_PILE_KEY;
+      this->discardPileIds.clear();
+      return parseCardIds(value, lineNumber, valueColumn, GameState::DECK_SIZE, this->discardPileIds);
+   }
+   else if (keyView == "NextPlayer")
+   {
+      keysSeen |= NEXT_PLAYER_KEY;
+
+      // Trim whitespace around the player
+      size_t first = 0;
+      while (first < value.size() && isBlank(value[first]))
+      {
+         first++;
+      }
+      size_t last = value.size();
+      while (last > first && isBlank(value[last - 1]))
+      {
+         last--;
+      }
+
+      std::string_view player = value.substr(first, last - first);
+      if (player == "Computer")
+      {
+         this->nextPlayer = 0;
+      }
+      else if (player == "Human")
+      {
+         this->nextPlayer = 1;
+      }
+      else
+      {
+         return setError(lineNumber, valueColumn + first, "next player must be Computer or Human");
+      }
+   }
+   else
+   {
+      return setError(lineNumber, position + 1, "unknown key");
+   }
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: parseNumber()
+Purpose: Parse a whole number value
+Parameters:
+         string_view value, the text after the colon
+         int lineNumber, the line of the value
+         int column, the column the value starts at
+         int &number, where to store the number
+Return Value: a bool, true if the value is not a whole number
+Local Variables:
+         size_t first, the first character of the number
+         from_chars_result result, the result of converting the number
+Algorithm:
+         1) Skip whitespace before the number
+         2) Convert the digits to a number
+         3) Make sure only whitespace follows it
+Assistance Received: none
+********************************************************************* */
+bool GameFile::parseNumber(std::string_view value, int lineNumber, int column, int &number)
+{
+   size_t first = 0;
+   while (first < value.size() && isBlank(value[first]))
+   {
+      first++;
+   }
+
+   std::from_chars_result result = std::from_chars(value.data() + first, value.data() + value.size(), number);
+   if (result.ec != std::errc() || number < 0)
+   {
+      return setError(lineNumber, column + first, "expected a number");
+   }
 
-         // Add value to hashmap
-         this->gameValues[key] = value;
+   for (const char *it = result.ptr; it != value.data() + value.size(); ++it)
+   {
+      if (!isBlank(*it))
+      {
+         return setError(lineNumber, column + (it - value.data()), "unexpected text after number");
       }
    }
 
-   parseInt();
-   parseCards();
-   loadFile.close();
+   return false;
 }
 
+/* *********************************************************************
+Function Name: parseCardIds()
+Purpose: Parse a list of cards separated by whitespace straight into
+   card ids
+Parameters:
+         string_view value, the text after the colon
+         int lineNumber, the line of the value
+         int column, the column the value starts at
+         size_t limit, the most cards the list may hold
+         vector<int> &ids, where to store the card ids
+Return Value: a bool, true if a card is not valid, there are too many,
+   or a card is there more than twice
+Local Variables:
+         int copies[], the number of each card seen so far
+         size_t position, the current position in the value
+         size_t start, where the current card starts
+         string_view token, the current card
+         int id, the id of the current card
+Algorithm:
+         1) Skip whitespace
+         2) Take the characters up to the next whitespace as a card
+         3) Convert it to its id, it's an error if it isn't a card, if
+            there are already limit cards, or if it's the third copy
+         4) Repeat until the end of the value
+Assistance Received: none
+********************************************************************* */
+bool GameFile::parseCardIds(std::string_view value, int lineNumber, int column, size_t limit, std::vector<int> &ids)
+{
+   int copies[Card::NUMBER_OF_IDS] = { 0 };
+
+   size_t position = 0;
+   while (position < value.size())
+   {
+      if (isBlank(value[position]))
+      {
+         position++;
+         continue;
+      }
+
+      size_t start = position;
+      while (position < value.size() && !isBlank(value[position]))
+      {
+         position++;
+      }
+
+      std::string_view token = value.substr(start, position - start);
+      int id = Card::idFromString(token);
+      if (id == -1)
+      {
+         return setError(lineNumber, column + start, "'" + std::string(token) + "' is not a card");
+      }
+
+      if (ids.size() == limit)
+      {
+         return setError(lineNumber, column + start, "more than " + std::to_string(limit) + " cards");
+      }
+
+      if (++copies[id] > MAX_COPIES)
+      {
+         return setError(lineNumber, column + start, "'" + std::string(token) + "' is there more than twice");
+      }
+
+      ids.push_back(id);
+   }
+
+   return false;
+}
 
 /* *********************************************************************
-Function Name: parseInt()
-Purpose: Convert all game file values to integers
+Function Name: checkCardIds()
+Purpose: Check that a hand or pile holds no more cards, or copies of a
+   card, than a game can
 Parameters:
-         none
-Return Value: none
+         const vector<int> &ids, the card ids of the hand or pile
+         size_t limit, the most cards it may hold
+         const string &name, what it is, for the error
+Return Value: a bool, true if it holds too many cards or a card more
+   than twice (the error is set)
 Local Variables:
-         string nextPlayerString, next player in round
+         int copies[], the number of each card
 Algorithm:
-         1) Parse gameRound to int
-         2) Parse computerScore to int
-         3) Parse humanScore to int
-         4) Parse nextPlayer to int
+         1) Check the number of cards against the limit
+         2) Count each card, failing at the third copy of any
 Assistance Received: none
 ********************************************************************* */
-void GameFile::parseInt()
+bool GameFile::checkCardIds(const std::vector<int> &ids, size_t limit, const std::string &name)
 {
-   this->gameRound = stoi(gameValues.at("Round"));
-   this->computerScore = stoi(gameValues.at("Score"));
-   this->humanScore = stoi(gameValues.at("HumanScore"));
+   if (ids.size() > limit)
+   {
+      return setError(0, 0, name + " has more than " + std::to_string(limit) + " cards");
+   }
+
+   int copies[Card::NUMBER_OF_IDS] = { 0 };
+   for (int id : ids)
+   {
+      if (++copies[id] > MAX_COPIES)
+      {
+         return setError(0, 0, name + " has " + Card::fromId(id, this->gameRound).toString() + " more than twice");
+      }
+   }
 
-   std::string nextPlayerString = gameValues.at("NextPlayer");
-   this->nextPlayer = (nextPlayerString == "Computer") ? 0 : 1;
-   //int x;
+   return false;
 }
 
+/* *********************************************************************
+Function Name: setError()
+Purpose: Record where and why parsing failed
+Parameters:
+         int line, the line of the error
+         int column, the column of the error
+         const string &message, what went wrong
+Return Value: a bool, always true so callers can return it
+Local Variables:
+         none
+Algorithm:
+         1) Store the line, column, and message
+         2) Return true
+Assistance Received: none
+********************************************************************* */
+bool GameFile::setError(int line, int column, const std::string &message)
+{
+   this->errorLine = line;
+   this->errorColumn = column;
+   this->errorMessage = message;
+
+   return true;
+}
 
 /* *********************************************************************
-Function Name: parseCards()
-Purpose: Parse the list of cards from the game file
+Function Name: createCards()
+Purpose: Create the hands and piles from the card ids once the round
+   is known
 Parameters:
          none
 Return Value: none
 Local Variables:
+         none
 Algorithm:
-         1) Get all card values from game file
-         2) Create vector of strings from cards
-         3) Create vector of cards from each vector of strings
-Assistance Received: https://en.cppreference.com/w/cpp/regex/regex_token_iterator
+         1) Create each card from its id and the round
+         2) Add them to the hands, draw pile, and discard pile
+Assistance Received: none
 ********************************************************************* */
-void GameFile::parseCards()
+void GameFile::createCards()
 {
-   std::string computerHandString = gameValues.at("Hand");
-   std::string humanHandString = gameValues.at("HumanHand");
-   std::string drawPileString = gameValues.at("DrawPile");
-   std::string discardPileString = gameValues.at("DiscardPile");
-
-   // To remove whitespaces
-   std::regex regex("\\s+");
+   this->computerHand.clear();
+   this->humanHand.clear();
+   this->drawPile.clear();
+   this->discardPile.clear();
 
-   // Construct a vector of strings from the computer's hand
-   std::vector<std::string> computerHandVString
+   for (int id : this->computerHandIds)
    {
-      std::sregex_token_iterator(computerHandString.begin(), computerHandString.end(), regex, -1), {}
-   };
+      this->computerHand.add(Card::fromId(id, this->gameRound));
+   }
 
-   // Construct a vector of strings from the human's hand
-   std::vector<std::string> humanHandVString
+   for (int id : this->humanHandIds)
    {
-      std::sregex_token_iterator(humanHandString.begin(), humanHandString.end(), regex, -1), {}
-   };
+      this->humanHand.add(Card::fromId(id, this->gameRound));
+   }
 
-   // Construct vector of strings from draw pile
-   std::vector<std::string> drawPileVString
+   for (int id : this->drawPileIds)
    {
-      std::sregex_token_iterator(drawPileString.begin(), drawPileString.end(), regex, -1), {}
-   };
+      this->drawPile.push_back(Card::fromId(id, this->gameRound));
+   }
 
-   // Construct vector of strings from discard pile
-   std::vector<std::string> discardPileVString
+   for (int id : this->discardPileIds)
    {
-      std::sregex_token_iterator(discardPileString.begin(), discardPileString.end(), regex, -1), {}
-   };
+      this->discardPile.push_back(Card::fromId(id, this->gameRound));
+   }
+}
 
-   // Create the list of cards
-   this->computerHand = createVectorOfCards(computerHandVString);
-   this->humanHand = createVectorOfCards(humanHandVString);
-   this->drawPile = createVectorOfCards(drawPileVString);
-   this->discardPile = createDequeOfCards(discardPileVString);
+/* *********************************************************************
+Function Name: getErrorLine()
+Purpose: Get the line of the last parse error
+Parameters:
+         none
+Return Value: a const int, the line of the error (starting at 1)
+Local Variables:
+         none
+Algorithm:
+         1) Return the error line
+Assistance Received: none
+********************************************************************* */
+int GameFile::getErrorLine() const
+{
+   return this->errorLine;
 }
 
 /* *********************************************************************
-Function Name: createVectorOfCards()
-Purpose: Create a vector of cards from the game file
+Function Name: getErrorColumn()
+Purpose: Get the column of the last parse error
 Parameters:
-         vector<string> cardStrings, strings to convert to cards
-Return Value: vector<Card>, the cards we made from vector of strings
+         none
+Return Value: a const int, the column of the error (starting at 1)
 Local Variables:
-         vector<Card> cards, card to return 
+         none
 Algorithm:
-         1) Loop through all cards (strings)
-         2) Create a Card object for each
-         3) Push to cards
-         4) Return cards
+         1) Return the error column
 Assistance Received: none
 ********************************************************************* */
-std::vector<Card> GameFile::createVectorOfCards(std::vector<std::string> cardStrings)
+int GameFile::getErrorColumn() const
 {
-   std::vector<Card> cards;
-   for (std::vector<std::string>::const_iterator it = cardStrings.begin(); it != cardStrings.end(); ++it)
-   {
-      //std::cout << *it << "\n";
-      Card card = Card((*it), this->gameRound);
-      cards.push_back(card);
-   }
+   return this->errorColumn;
+}
 
-   return cards;
+/* *********************************************************************
+Function Name: getErrorMessage()
+Purpose: Get the description of the last parse error
+Parameters:
+         none
+Return Value: a const string, what went wrong
+Local Variables:
+         none
+Algorithm:
+         1) Return the error message
+Assistance Received: none
+********************************************************************* */
+std::string GameFile::getErrorMessage() const
+{
+   return this->errorMessage;
 }
 
 /* *********************************************************************
-Function Name: createDequeOfCards()
-Purpose: Create a deque of cards from the game file
+Function Name: getError()
+Purpose: Get the last parse error as "line L, column C: message"
 Parameters:
-         vector<string> cardStrings, strings to convert to cards
-Return Value: deque<Card>, the cards we made from vector of strings
+         none
+Return Value: a const string, the error
 Local Variables:
-         deque<Card> cards, card to return
+         none
 Algorithm:
-         1) Loop through all cards (strings)
-         2) Create a Card object for each
-         3) Push to cards
-         4) Return cards
+         1) If the error isn't on a line (i.e. in a snapshot), return the
+            message
+         2) Otherwise combine the line, column, and message
 Assistance Received: none
 ********************************************************************* */
-std::deque<Card> GameFile::createDequeOfCards(std::vector<std::string> cardStrings)
+std::string GameFile::getError() const
 {
-   std::deque<Card> cards;
-   for (std::vector<std::string>::const_iterator it = cardStrings.begin(); it != cardStrings.end(); ++it)
+   if (this->errorLine == 0)
    {
-      //std::cout << *it << "\n";
-      Card card = Card((*it), this->gameRound);
-      cards.push_back(card);
+      return this->errorMessage;
    }
 
-   return cards;
+   return "line " + std::to_string(this->errorLine) + ", column " + std::to_string(this->errorColumn) + ": " + this->errorMessage;
 }
 
 /* *********************************************************************
@@ -337,14 +843,14 @@ Function Name: getComputerHand()
 Purpose: Get the computers hand
 Parameters:
          none
-Return Value: const vector<Card>, the computers hand
+Return Value: a const reference to Hand, the computers hand
 Local Variables:
          none
 Algorithm:
          1) Return the computers hand
 Assistance Received: none
 ********************************************************************* */
-std::vector<Card> GameFile::getComputerHand() const
+const Hand& GameFile::getComputerHand() const
 {
    return this->computerHand;
 }
@@ -354,14 +860,14 @@ Function Name: getHumanHand()
 Purpose: Get the humans hand
 Parameters:
          none
-Return Value: const vector<Card>, the humans hand
+Return Value: a const reference to Hand, the humans hand
 Local Variables:
          none
 Algorithm:
          1) Return the human hand
 Assistance Received: none
 ********************************************************************* */
-std::vector<Card> GameFile::getHumanHand() const
+const Hand& GameFile::getHumanHand() const
 {
    return this->humanHand;
 }
@@ -401,35 +907,452 @@ std::deque<Card> GameFile::getDiscardPile() const
 }
 
 /* *********************************************************************
-Function Name: saveGameToFile()
-Purpose: Saves the current game state into user specified file
+Function Name: getSaveFileName()
+Purpose: Ask the user for the name of the file to save the game to
 Parameters:
-         string gameState, the current state of the game
-Return Value: none
+         none
+Return Value: a string, the name of the file
 Local Variables:
          string fileName, name of the file
 Algorithm:
-         1) Get file to save game to
-         2) Open file
-         3) If file is open, save to file
+         1) Get the name of the file
+         2) Return it
 Assistance Received: none
 ********************************************************************* */
-void GameFile::saveGameToFile(std::string gameState)
-{   
+std::string GameFile::getSaveFileName()
+{
    std::string fileName;
    std::cout << "Enter name of file to save game to: ";
-   
+
    std::getline(std::cin, fileName);
 
-   saveFile.open(fileName);
-   if (saveFile.is_open())
+   return fileName;
+}
+
+/* *********************************************************************
+Function Name: saveGameToFile()
+Purpose: Saves the game state into the file
+Parameters:
+         const string &fileName, the file to save to
+         string_view gameState, the text or snapshot of the game
+Return Value: a bool, true if the file could not be written
+Local Variables:
+         ofstream saveFile, the file being written
+Algorithm:
+         1) Open file
+         2) Write the game state with a single write
+Assistance Received: none
+********************************************************************* */
+bool GameFile::saveGameToFile(const std::string &fileName, std::string_view gameState)
+{
+   std::ofstream saveFile(fileName, std::ios::binary);
+   if (!saveFile)
    {
-      saveFile << gameState;
-      saveFile.close();
+      return true;
    }
-   else
+
+   saveFile.write(gameState.data(), gameState.size());
+
+   return !saveFile;
+}
+
+/* *********************************************************************
+Function Name: isSnapshot()
+Purpose: Check if data is a binary snapshot rather than a text game file
+Parameters:
+         string_view data, the contents of a game file
+Return Value: a bool, true if data starts with the snapshot magic
+Local Variables:
+         none
+Algorithm:
+         1) Compare the start of data with the magic
+Assistance Received: none
+********************************************************************* */
+bool GameFile::isSnapshot(std::string_view data)
+{
+   return data.size() >= sizeof(SNAPSHOT_MAGIC) && data.compare(0, sizeof(SNAPSHOT_MAGIC), std::string_view(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC))) == 0;
+}
+
+/* *********************************************************************
+Function Name: isSnapshotFileName()
+Purpose: Check if a game should be saved as a binary snapshot
+Parameters:
+         const string &fileName, the file the game is saved to
+Return Value: a bool, true if the file name ends with the snapshot extension
+Local Variables:
+         none
+Algorithm:
+         1) Compare the end of the file name with the extension
+Assistance Received: none
+********************************************************************* */
+bool GameFile::isSnapshotFileName(const std::string &fileName)
+{
+   return fileName.size() > SNAPSHOT_EXTENSION.size()
+      && fileName.compare(fileName.size() - SNAPSHOT_EXTENSION.size(), SNAPSHOT_EXTENSION.size(), SNAPSHOT_EXTENSION) == 0;
+}
+
+/* *********************************************************************
+Function Name: setGameState()
+Purpose: Set the game state to save
+Parameters:
+         int round, the current round
+         int computerScore, the computer's score
+         int humanScore, the human's score
+         int nextPlayer, the next player (0 for Computer, 1 for Human)
+         const Hand &computerHand, the computer's hand
+         const Hand &humanHand, the human's hand
+         const vector<Card> &drawPile, the draw pile, top first
+         const deque<Card> &discardPile, the discard pile, top first
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Copy the state into the game file
+Assistance Received: none
+********************************************************************* */
+void GameFile::setGameState(int round, int computerScore, int humanScore, int nextPlayer, const Hand &computerHand,
+   const Hand &humanHand, const std::vector<Card> &drawPile, const std::deque<Card> &discardPile)
+{
+   this->gameRound = round;
+   this->computerScore = computerScore;
+   this->humanScore = humanScore;
+   this->nextPlayer = nextPlayer;
+   this->computerHand = computerHand;
+   this->humanHand = humanHand;
+   this->drawPile = drawPile;
+   this->discardPile = discardPile;
+}
+
+/* *********************************************************************
+Function Name: setGameState()
+Purpose: Set the game state to save from a GameState
+Parameters:
+         const GameState &state, the state of the game
+Return Value: none
+Local Variables:
+         int player, the current player
+Algorithm:
+         1) Copy the round, scores, and player to move
+         2) Create the cards of each hand in order
+         3) Create the cards of each pile from the top down
+Assistance Received: none
+********************************************************************* */
+void GameFile::setGameState(const GameState &state)
+{
+   this->gameRound = state.round;
+   this->computerScore = state.scores[0];
+   this->humanScore = state.scores[1];
+   this->nextPlayer = state.playerToMove;
+
+   Hand *hands[] = { &this->computerHand, &this->humanHand };
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      hands[player]->clear();
+      for (int i = 0; i < state.handSizes[player]; i++)
+      {
+         hands[player]->add(Card::fromId(state.hands[player][i], state.round));
+      }
+   }
+
+   this->drawPile.clear();
+   for (int i = state.drawSize - 1; i >= 0; i--)
+   {
+      this->drawPile.push_back(Card::fromId(state.drawPile[i], state.round));
+   }
+
+   this->discardPile.clear();
+   for (int i = state.discardSize - 1; i >= 0; i--)
+   {
+      this->discardPile.push_back(Card::fromId(state.discardPile[i], state.round));
+   }
+}
+
+/* *********************************************************************
+Function Name: toGameState()
+Purpose: Get the game state as a GameState
+Parameters:
+         GameState &state, set to the state with the next player to move
+            and about to draw
+Return Value: a bool, true if a hand or pile doesn't fit in a GameState
+   or holds a card more than twice (the error is set)
+Local Variables:
+         const Hand *hands[], the hands of each player
+         vector<int> handIds, the ids of a hand
+         vector<int> pileIds[], the ids of each pile, top first
+Algorithm:
+         1) Check each hand and pile against what a GameState holds
+         2) Copy the round, scores, and player to move
+         3) Copy the ids of each hand in order
+         4) Copy the ids of each pile with the top last
+         5) Hash the state
+Assistance Received: none
+********************************************************************* */
+bool GameFile::toGameState(GameState &state)
+{
+   const Hand *hands[] = { &this->computerHand, &this->humanHand };
+   const std::string handNames[] = { "computer hand", "human hand" };
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      std::vector<int> handIds;
+      for (const Card &card : *hands[player])
+      {
+         handIds.push_back(card.getId());
+      }
+
+      if (checkCardIds(handIds, GameState::MAX_HAND, handNames[player]))
+      {
+         return true;
+      }
+   }
+
+   std::vector<int> pileIds[2];
+   for (const Card &card : this->drawPile)
+   {
+      pileIds[0].push_back(card.getId());
+   }
+   for (const Card &card : this->discardPile)
+   {
+      pileIds[1].push_back(card.getId());
+   }
+
+   if (checkCardIds(pileIds[0], GameState::DECK_SIZE, "draw pile") || checkCardIds(pileIds[1], GameState::DECK_SIZE, "discard pile"))
+   {
+      return true;
+   }
+
+   state = GameState();
+   state.round = this->gameRound;
+   state.scores[0] = this->computerScore;
+   state.scores[1] = this->humanScore;
+   state.playerToMove = this->nextPlayer;
+   state.phase = GameState::Phase::DRAW;
+
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      for (const Card &card : *hands[player])
+      {
+         state.hands[player][state.handSizes[player]++] = card.getId();
+      }
+   }
+
+   for (std::vector<Card>::const_reverse_iterator card = this->drawPile.rbegin(); card != this->drawPile.rend(); ++card)
+   {
+      state.drawPile[state.drawSize++] = card->getId();
+   }
+
+   for (std::deque<Card>::const_reverse_iterator card = this->discardPile.rbegin(); card != this->discardPile.rend(); ++card)
+   {
+      state.discardPile[state.discardSize++] = card->getId();
+   }
+   state.hash = Zobrist::hash(state);
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: serializeSnapshot()
+Purpose: Return the game state as a binary snapshot
+Parameters:
+         none
+Return Value: a string, the bytes of the snapshot
+Local Variables:
+         string snapshot, the bytes of the snapshot
+         size_t position, where the next card id goes
+Algorithm:
+         1) Size the snapshot to fit the header and every card
+         2) Fill in the header
+         3) Write the id of every card in the hands and piles
+Assistance Received: none
+********************************************************************* */
+std::string GameFile::serializeSnapshot() const
+{
+   std::string snapshot(SNAPSHOT_HEADER_SIZE + this->computerHand.size() + this->humanHand.size()
+      + this->drawPile.size() + this->discardPile.size(), '\0');
+
+   std::copy(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + sizeof(SNAPSHOT_MAGIC), snapshot.begin());
+   snapshot[4] = SNAPSHOT_VERSION;
+   snapshot[5] = this->gameRound;
+   snapshot[6] = this->nextPlayer;
+   snapshot[8] = this->computerScore & 0xFF;
+   snapshot[9] = (this->computerScore >> 8) & 0xFF;
+   snapshot[10] = this->humanScore & 0xFF;
+   snapshot[11] = (this->humanScore >> 8) & 0xFF;
+   snapshot[12] = this->computerHand.size();
+   snapshot[13] = this->humanHand.size();
+   snapshot[14] = this->drawPile.size();
+   snapshot[15] = this->discardPile.size();
+
+   size_t position = SNAPSHOT_HEADER_SIZE;
+   for (const Card &card : this->computerHand)
+   {
+      snapshot[position++] = card.getId();
+   }
+
+   for (const Card &card : this->humanHand)
+   {
+      snapshot[position++] = card.getId();
+   }
+
+   for (const Card &card : this->drawPile)
+   {
+      snapshot[position++] = card.getId();
+   }
+
+   for (const Card &card : this->discardPile)
+   {
+      snapshot[position++] = card.getId();
+   }
+
+   return snapshot;
+}
+
+/* *********************************************************************
+Function Name: serializeText()
+Purpose: Return the game state as a text game file
+Parameters:
+         none
+Return Value: a string, the text of the game file
+Local Variables:
+         string text, the text being written
+         const Hand *hands[], the hands of each player
+         const char *names[], the name of each player
+         int scores[], the score of each player
+Algorithm:
+         1) Write the round
+         2) Write each player's score and hand, the computer first
+         3) Write the draw pile and discard pile from the top down
+         4) Write the next player, laid out as Game::serializeGame() does
+Assistance Received: none
+********************************************************************* */
+std::string GameFile::serializeText() const
+{
+   std::string text;
+
+   // Every card is at most 3 characters with its separator
+   text.reserve(256 + 3 * (Card::NUMBER_OF_IDS * 2));
+
+   text += "Round: " + std::to_string(this->gameRound) + "\n\n";
+
+   const Hand *hands[] = { &this->computerHand, &this->humanHand };
+   const char *names[] = { "Computer", "Human" };
+   int scores[] = { this->computerScore, this->humanScore };
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      text += std::string(names[player]) + ":\n";
+      text += "   Score: " + std::to_string(scores[player]) + "\n";
+      text += "   Hand: ";
+      for (const Card &card : *hands[player])
+      {
+         text += card.toString() + " ";
+      }
+      text += "\n\n";
+   }
+   text += "\n";
+
+   text += "Draw Pile: ";
+   for (const Card &card : this->drawPile)
+   {
+      text += card.toString() + " ";
+   }
+
+   text += "\n\nDiscard Pile: ";
+   for (const Card &card : this->discardPile)
+   {
+      text += card.toString() + " ";
+   }
+
+   text += "\n\nNext Player: ";
+   text += names[this->nextPlayer];
+
+   return text;
+}
+
+/* *********************************************************************
+Function Name: parseSnapshot()
+Purpose: Load a binary snapshot that is already in memory. Every field
+   is at a fixed offset so nothing has to be tokenized
+Parameters:
+         string_view data, the bytes of the snapshot
+Return Value: a bool, true if it is not a valid snapshot
+Local Variables:
+         const unsigned char *bytes, the bytes of the snapshot
+         size_t counts[], the number of cards in each hand and pile
+         vector<int> *piles[], where the ids of each hand and pile go
+         size_t limits[], the most cards each hand and pile may hold
+         const char *names[], the name of each hand and pile
+         size_t position, where the next card id is
+Algorithm:
+         1) Check the magic, version, size, and round
+         2) Read the round, next player, and scores from the header
+         3) Read the card ids of each hand and pile, checking each holds
+            no more cards, or copies of a card, than a game can
+         4) Create the hands and piles from the card ids
+Assistance Received: none
+********************************************************************* */
+bool GameFile::parseSnapshot(std::string_view data)
+{
+   this->errorLine = 0;
+   this->errorColumn = 0;
+   this->errorMessage.clear();
+
+   if (!isSnapshot(data) || data.size() < SNAPSHOT_HEADER_SIZE)
+   {
+      return setError(0, 0, "not a game snapshot");
+   }
+
+   const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data.data());
+   if (bytes[4] != SNAPSHOT_VERSION)
+   {
+      return setError(0, 0, "unsupported snapshot version " + std::to_string(bytes[4]));
+   }
+
+   size_t counts[] = { bytes[12], bytes[13], bytes[14], bytes[15] };
+   if (data.size() != SNAPSHOT_HEADER_SIZE + counts[0] + counts[1] + counts[2] + counts[3])
+   {
+      return setError(0, 0, "snapshot is " + std::to_string(data.size()) + " bytes, expected "
+         + std::to_string(SNAPSHOT_HEADER_SIZE + counts[0] + counts[1] + counts[2] + counts[3]));
+   }
+
+   if (bytes[5] < FIRST_ROUND || bytes[5] > LAST_ROUND)
+   {
+      return setError(0, 0, "round must be from " + std::to_string(FIRST_ROUND) + " to " + std::to_string(LAST_ROUND));
+   }
+
+   if (bytes[6] > 1)
+   {
+      return setError(0, 0, "next player must be Computer or Human");
+   }
+
+   this->gameRound = bytes[5];
+   this->nextPlayer = bytes[6];
+   this->computerScore = bytes[8] | (bytes[9] << 8);
+   this->humanScore = bytes[10] | (bytes[11] << 8);
+
+   std::vector<int> *piles[] = { &this->computerHandIds, &this->humanHandIds, &this->drawPileIds, &this->discardPileIds };
+   const size_t limits[] = { Hand::MAX_CARDS, Hand::MAX_CARDS, GameState::DECK_SIZE, GameState::DECK_SIZE };
+   const char *names[] = { "computer hand", "human hand", "draw pile", "discard pile" };
+
+   size_t position = SNAPSHOT_HEADER_SIZE;
+   for (int pile = 0; pile < 4; pile++)
    {
-      std::cout << "Invalid file name!\n";
-      saveGameToFile(gameState);
+      piles[pile]->assign(bytes + position, bytes + position + counts[pile]);
+
+      for (int id : *piles[pile])
+      {
+         if (id >= Card::NUMBER_OF_IDS)
+         {
+            return setError(0, 0, "snapshot byte " + std::to_string(position) + " is not a card");
+         }
+         position++;
+      }
+
+      if (checkCardIds(*piles[pile], limits[pile], names[pile]))
+      {
+         return true;
+      }
    }
-}
\ No newline at end of file
+
+   createCards();
+
+   return false;
+}
@@ -2,12 +2,13 @@
 #define GAMEFILE_H
 
 #include "card.h"         // to add cards to 
+#include "hand.h"         // to store hands
+#include "gameState.h"      // to convert to and from card ids
 #include <string>
 #include <deque>         // to store discard pile
 #include <vector>         // to store hands and drawing pile
 #include <fstream>         // to read file
-#include <unordered_map>   // to store values of the game file
-#include <regex>         
+#include <string_view>   // tokens of the game file
 
 
 class GameFile
@@ -17,13 +18,55 @@ class GameFile
       GameFile() = default;
       ~GameFile() = default;
 
-      // Open a file and return true or false if open failed
+      // Ask the user for a file, read it, and return true if opening it failed
       bool openFile();
 
-      // Creates the keys and values for the unordered map 
-      // where the key is the variable (i.e. score, hand, etc)
-      // and the value is what's after the colon: (i.e. "1", "S6 S5 S4", etc)
-      void parseFile();
+      // Parse the file that was opened with openFile()
+      // Returns true if the file is not a valid game file (the error is printed)
+      bool parseFile();
+
+      // Read and parse the given file without asking the user for anything
+      // Returns true if it could not be read or is not a valid game file
+      bool loadFromFile(const std::string &fileName);
+
+      // Parse a game file that is already in memory in a single pass
+      // Returns true if it is not a valid game file
+      bool parseBuffer(std::string_view text);
+
+      // Load a binary snapshot that is already in memory
+      // Returns true if it is not a valid snapshot
+      bool parseSnapshot(std::string_view data);
+
+      // Check if data starts with the snapshot magic
+      static bool isSnapshot(std::string_view data);
+
+      // Check if a file name has the snapshot extension, meaning it's saved as a binary snapshot
+      static bool isSnapshotFileName(const std::string &fileName);
+
+      // Set the game state to save
+      void setGameState(int round, int computerScore, int humanScore, int nextPlayer, const Hand &computerHand,
+         const Hand &humanHand, const std::vector<Card> &drawPile, const std::deque<Card> &discardPile);
+
+      // Set the game state to save from a GameState
+      void setGameState(const GameState &state);
+
+      // Get the game state as a GameState, the player to move being the next player
+      // Returns true if a hand or pile is too big for one or holds a card more than twice
+      bool toGameState(GameState &state);
+
+      // Return the game state as a binary snapshot
+      std::string serializeSnapshot() const;
+
+      // Return the game state as a text game file, laid out as Game saves it
+      std::string serializeText() const;
+
+      // Get the line, column, and description of the last parse error
+      int getErrorLine() const;
+      int getErrorColumn() const;
+      std::string getErrorMessage() const;
+
+      // Get the last parse error as "line L, column C: message"
+      std::string getError() const;
 
       // Get the game round
       int getGameRound() const;
@@ -38,10 +81,10 @@ class GameFile
       int getNextPlayer() const;
 
       // Get the computer's hand
-      std::vector<Card> getComputerHand() const;
+      const Hand& getComputerHand() const;
 
       // Get the human's hand
-      std::vector<Card> getHumanHand() const;
+      const Hand& getHumanHand() const;
 
       // Get the draw pile
       std::vector<Card> getDrawPile() const;
@@ -49,8 +92,21 @@ class GameFile
       // Get the discard pile
       std::deque<Card> getDiscardPile() const;
 
-      // Saves the current game state into user specified file
-      void saveGameToFile(std::string gameState);
+      // Ask the user for the name of the file to save the game to
+      std::string getSaveFileName();
+
+      // Saves the game state into the file, returns true if it could not be written
+      bool saveGameToFile(const std::string &fileName, std::string_view gameState);
+
+      // Binary snapshot format, all numbers are little endian:
+      //   0  magic "FCSV"      4  version        5  round         6  next player   7  unused
+      //   8  computer score    10 human score    12 computer hand count           13 human hand count
+      //   14 draw pile count   15 discard pile count
+      //   16 card ids of the computer hand, human hand, draw pile, then discard pile (one byte each)
+      static const char SNAPSHOT_MAGIC[4];
+      static const unsigned char SNAPSHOT_VERSION = 1;
+      static const int SNAPSHOT_HEADER_SIZE = 16;
+      static const std::string SNAPSHOT_EXTENSION;
 
 
    private:
@@ -59,33 +115,57 @@ class GameFile
       int humanScore;
       int nextPlayer;
 
-      std::vector<Card> computerHand;
-      std::vector<Card> humanHand;
+      Hand computerHand;
+      Hand humanHand;
       std::vector<Card> drawPile;
 
       std::deque<Card> discardPile;
       
-      std::ifstream loadFile;
+      // The contents of the file opened with openFile()
+      std::string fileContents;
 
-      std::ofstream saveFile;
+      // Card ids read from the file, turned into cards once the round is known
+      std::vector<int> computerHandIds;
+      std::vector<int> humanHandIds;
+      std::vector<int> drawPileIds;
+      std::vector<int> discardPileIds;
 
-      // Hashmap to store values from game file
-      std::unordered_map<std::string, std::string> gameValues;
+      // Where and why parsing failed
+      int errorLine = 0;
+      int errorColumn = 0;
+      std::string errorMessage;
 
       // Ask user for filename and return name
       std::string getGameFileName();
 
-      // Parse the integer values of the game file
-      void parseInt();
+      // Read a whole file into contents, returns true if it could not be read
+      static bool readFile(const std::string &fileName, std::string &contents);
+
+      // Load the file contents as a snapshot, journal, or text game file
+      bool parseContents();
+
+      // Recover a game by replaying its whole journal
+      bool parseJournal(std::string_view journal);
+
+      // Parse a single "Key: value" line of the game file
+      bool parseLine(std::string_view line, int lineNumber, int &section, int &scoresSeen, int &handsSeen, unsigned &keysSeen);
+
+      // Parse a whole number value
+      bool parseNumber(std::string_view value, int lineNumber, int column, int &number);
+
+      // Parse a list of cards separated by whitespace straight into card ids,
+      // at most limit of them and no more than two of any card
+      bool parseCardIds(std::string_view value, int lineNumber, int column, size_t limit, std::vector<int> &ids);
 
-      // Parse the list of cards from the game file
-      void parseCards();
+      // Check that a hand or pile of card ids holds at most limit cards and
+      // no more than two of any card. Returns true (with the error set) if not
+      bool checkCardIds(const std::vector<int> &ids, size_t limit, const std::string &name);
 
-      // Create a vector of cards from the game file
-      std::vector<Card> createVectorOfCards(std::vector<std::string> cardStrings);
+      // Record where and why parsing failed, always returns true
+      bool setError(int line, int column, const std::string &message);
 
-      // Create a deque of cards from the game file
-      std::deque<Card> createDequeOfCards(std::vector<std::string> cardStrings);
+      // Create the hands and piles from the card ids once the round is known
+      void createCards();
 };
 
 
@@ -0,0 +1,647 @@
+#include "gameState.h"
+#include "round.h"
+#include "player.h"   // Player::bestArrangement()
+#include "meldEvaluator.h"
+#include "evaluationCache.h"
+#include "zobrist.h"
+#include <algorithm>   // std::copy
+#include <cassert>
+
+namespace
+{
+   // Number of copies of card id in a hand
+   int copiesInHand(const unsigned char *hand, int size, int id)
+   {
+      int copies = 0;
+      for (int i = 0; i < size; i++)
+      {
+         copies += hand[i] == id;
+      }
+      return copies;
+   }
+
+   // The value of the cards of a hand left after CombinationFinder arranges
+   // it, from the cache if it has the hand
+   int arrangedDeadwood(const unsigned char *ids, int size, int round)
+   {
+      EvaluationCache &cache = EvaluationCache::shared();
+      std::uint64_t key = EvaluationCache::key(ids, size, round);
+
+      EvaluationCache::Entry entry;
+      if (cache.find(key, entry))
+      {
+         return entry.deadwood;
+      }
+
+      Hand hand;
+      for (int i = 0; i < size; i++)
+      {
+         hand.add(Card::fromId(ids[i], round));
+      }
+
+      entry.deadwood = Player::bestArrangement(hand).takeResult().deadwoodScore;
+      cache.record(key, entry);
+      return entry.deadwood;
+   }
+}
+
+/* *********************************************************************
+Function Name: startRound()
+Purpose: Create the state at the start of a round
+Parameters:
+         int round, the round to start
+         unsigned seed, the seed the deck is shuffled with
+         int firstPlayer, the player to move first
+         int computerScore, the computer's score so far
+         int humanScore, the human's score so far
+Return Value: a GameState, the state after the deal
+Local Variables:
+         GameState state, the state being created
+         Round shuffled, the round's shuffled deck
+         const vector<Card> &deck, the shuffled cards, top first
+Algorithm:
+         1) Shuffle the round's deck the same way Round does
+         2) Put the cards in the draw pile with the top last
+         3) Deal round + 2 cards from the top to each player in turn
+         4) Turn over the top of the draw pile to start the discard pile
+         5) Hash the state
+Assistance Received: none
+********************************************************************* */
+GameState startRound(int round, unsigned seed, int firstPlayer, int computerScore, int humanScore)
+{
+   GameState state = GameState();
+   state.round = round;
+   state.seed = seed;
+   state.playerToMove = firstPlayer;
+   state.phase = GameState::Phase::DRAW;
+   state.scores[0] = computerScore;
+   state.scores[1] = humanScore;
+
+   Round shuffled(round, seed);
+   const std::vector<Card> &deck = shuffled.getDrawPile();
+
+   state.drawSize = deck.size();
+   for (int i = 0; i < state.drawSize; i++)
+   {
+      state.drawPile[state.drawSize - 1 - i] = deck[i].getId();
+   }
+
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      for (int i = 0; i < round + Card::getWildCardOffset(); i++)
+      {
+         state.hands[player][state.handSizes[player]++] = state.drawPile[--state.drawSize];
+      }
+   }
+
+   state.discardPile[state.discardSize++] = state.drawPile[--state.drawSize];
+   state.hash = Zobrist::hash(state);
+
+   return state;
+}
+
+/* *********************************************************************
+Function Name: legalActions()
+Purpose: Find every legal action in a state
+Parameters:
+         const GameState &state, the state
+         Action actions[], where to put the actions
+Return Value: an int, the number of actions
+Local Variables:
+         int count, the number of actions found
+         const unsigned char *hand, the hand of the player to move
+Algorithm:
+         1) Nothing can be done once the round is over
+         2) When drawing, the deck can be drawn from unless it's empty
+            and the discard pile unless it's empty
+         3) When discarding, any card in the hand can be discarded (each
+            different card once)
+Assistance Received: none
+********************************************************************* */
+int legalActions(const GameState &state, Action actions[GameState::MAX_ACTIONS])
+{
+   int count = 0;
+
+   if (state.phase == GameState::Phase::DRAW)
+   {
+      if (state.drawSize > 0)
+      {
+         actions[count++] = { Action::Type::DRAW_DECK, 0 };
+      }
+
+      if (state.discardSize > 0)
+      {
+         actions[count++] = { Action::Type::DRAW_DISCARD, 0 };
+      }
+   }
+   else if (state.phase == GameState::Phase::DISCARD)
+   {
+      const unsigned char *hand = state.hands[state.playerToMove];
+      for (int i = 0; i < state.handSizes[state.playerToMove]; i++)
+      {
+         // Discarding either copy of a card is the same action
+         bool seen = false;
+         for (int j = 0; j < i && !seen; j++)
+         {
+            seen = hand[j] == hand[i];
+         }
+
+         if (!seen)
+         {
+            actions[count++] = { Action::Type::DISCARD, hand[i] };
+         }
+      }
+   }
+
+   return count;
+}
+
+/* *********************************************************************
+Function Name: isLegal()
+Purpose: Check if an action can be made in a state
+Parameters:
+         const GameState &state, the state
+         Action action, the action to check
+Return Value: a bool, true if the action is legal
+Local Variables:
+         none
+Algorithm:
+         1) Draws need the draw phase and a card in the pile
+         2) Discards need the discard phase and the card in the hand
+Assistance Received: none
+********************************************************************* */
+bool isLegal(const GameState &state, Action action)
+{
+   switch (action.type)
+   {
+      case Action::Type::DRAW_DECK:
+         return state.phase == GameState::Phase::DRAW && state.drawSize > 0;
+
+      case Action::Type::DRAW_DISCARD:
+         return state.phase == GameState::Phase::DRAW && state.discardSize > 0;
+
+      case Action::Type::DISCARD:
+         if (state.phase != GameState::Phase::DISCARD)
+         {
+            return false;
+         }
+
+         for (int i = 0; i < state.handSizes[state.playerToMove]; i++)
+         {
+            if (state.hands[state.playerToMove][i] == action.card)
+            {
+               return true;
+            }
+         }
+         return false;
+
+      default:
+         return false;
+   }
+}
+
+/* *********************************************************************
+Function Name: apply()
+Purpose: Make an action and return the new state, leaving the old one
+   as it was
+Parameters:
+         const GameState &state, the state
+         Action action, a legal action in the state
+Return Value: a GameState, the state after the action
+Local Variables:
+         GameState next, the new state
+         UndoRecord record, unused record of the change
+Algorithm:
+         1) Copy the state
+         2) Make the action on the copy
+Assistance Received: none
+********************************************************************* */
+GameState apply(const GameState &state, Action action)
+{
+   GameState next = state;
+   UndoRecord record;
+   applyInPlace(next, action, record);
+
+   return next;
+}
+
+/* *********************************************************************
+Function Name: applyInPlace()
+Purpose: Make an action on the state itself, recording what changed so
+   it can be taken back
+Parameters:
+         GameState &state, the state
+         Action action, a legal action in the state
+         UndoRecord &record, filled with what changed
+Return Value: none
+Local Variables:
+         int player, the player to move
+         unsigned char *hand, their hand
+         int card, the card drawn
+         bool wentOut, whether their cards can all be melded
+Algorithm:
+         1) Record the turn and scores before the action, and take the
+            turn's key out of the hash
+         2) Draws move the top of a pile to the end of the hand (like
+            Deck::drawFromDeck() or Deck::drawFromDiscard() then
+            Player::addToHand()), asserting the pile isn't empty and the
+            hand isn't full
+         3) Discards move the card to the top of the discard pile with
+            the last card in the hand taking its place (like
+            Player::discardCard() then Deck::addToDiscardPile())
+         4) After a discard, check if the player went out the way
+            Game::movePlayer() does: the first two times a player goes
+            out the next player gets a last turn, otherwise a last turn
+            ends the round
+         5) When the round ends, add each player's cards left to their
+            score
+         6) XOR the keys of the cards moved and of the new turn into the
+            hash: a card joining a hand takes the key of the copy it is,
+            and the top of the discard pile swaps its key for the new top's
+Assistance Received: none
+********************************************************************* */
+void applyInPlace(GameState &state, Action action, UndoRecord &record)
+{
+   int player = state.playerToMove;
+   unsigned char *hand = state.hands[player];
+
+   record.action = action;
+   record.index = 0;
+   record.playerToMove = state.playerToMove;
+   record.phase = state.phase;
+   record.goneOutCount = state.goneOutCount;
+   record.lastTurn = state.lastTurn;
+   record.scores[0] = state.scores[0];
+   record.scores[1] = state.scores[1];
+
+   state.hash ^= Zobrist::turnKey(state);
+
+   if (action.type == Action::Type::DRAW_DECK || action.type == Action::Type::DRAW_DISCARD)
+   {
+      assert(state.handSizes[player] < GameState::MAX_HAND);
+
+      int card;
+      if (action.type == Action::Type::DRAW_DECK)
+      {
+         assert(state.drawSize > 0);
+         card = state.drawPile[--state.drawSize];
+      }
+      else
+      {
+         assert(state.discardSize > 0);
+         state.hash ^= Zobrist::discardTopKey(state);
+         card = state.discardPile[--state.discardSize];
+         state.hash ^= Zobrist::discardTopKey(state);
+      }
+
+      state.hash ^= Zobrist::handKey(player, card, copiesInHand(hand, state.handSizes[player], card));
+      hand[state.handSizes[player]++] = card;
+      state.phase = GameState::Phase::DISCARD;
+      state.hash ^= Zobrist::turnKey(state);
+      return;
+   }
+
+   // Discard
+   assert(state.discardSize < GameState::DECK_SIZE);
+   for (int i = 0; i < state.handSizes[player]; i++)
+   {
+      if (hand[i] == action.card)
+      {
+         record.index = i;
+         hand[i] = hand[--state.handSizes[player]];
+         break;
+      }
+   }
+   state.hash ^= Zobrist::handKey(player, action.card, copiesInHand(hand, state.handSizes[player], action.card));
+
+   state.hash ^= Zobrist::discardTopKey(state);
+   state.discardPile[state.discardSize++] = action.card;
+   state.hash ^= Zobrist::discardTopKey(state);
+
+   bool wentOut = canGoOut(hand, state.handSizes[player], state.round);
+   if (wentOut && state.goneOutCount < GameState::PLAYER_COUNT)
+   {
+      state.goneOutCount++;
+      state.lastTurn = true;
+   }
+   else if (state.lastTurn)
+   {
+      state.phase = GameState::Phase::ROUND_OVER;
+      for (int i = 0; i < GameState::PLAYER_COUNT; i++)
+      {
+         state.scores[i] += deadwoodScore(state.hands[i], state.handSizes[i], state.round);
+      }
+      state.hash ^= Zobrist::turnKey(state);
+      return;
+   }
+
+   state.playerToMove = (player + 1) % GameState::PLAYER_COUNT;
+   state.phase = GameState::Phase::DRAW;
+   state.hash ^= Zobrist::turnKey(state);
+}
+
+/* *********************************************************************
+Function Name: undo()
+Purpose: Take back the last action made on the state
+Parameters:
+         GameState &state, the state
+         const UndoRecord &record, the record of the last action
+Return Value: none
+Local Variables:
+         int player, the player who made the action
+         unsigned char *hand, their hand
+         int card, the card drawn
+Algorithm:
+         1) Put back the turn and scores, swapping the turn's key in the
+            hash
+         2) Draws move the end of the hand back to the top of the pile
+         3) Discards move the top of the discard pile back to where it
+            was in the hand, and the card that took its place back to
+            the end
+         4) XOR the keys of the cards moved again, which takes them back
+            out of the hash
+Assistance Received: none
+********************************************************************* */
+void undo(GameState &state, const UndoRecord &record)
+{
+   int player = record.playerToMove;
+   unsigned char *hand = state.hands[player];
+
+   state.hash ^= Zobrist::turnKey(state);
+   state.playerToMove = record.playerToMove;
+   state.phase = record.phase;
+   state.goneOutCount = record.goneOutCount;
+   state.lastTurn = record.lastTurn;
+   state.scores[0] = record.scores[0];
+   state.scores[1] = record.scores[1];
+   state.hash ^= Zobrist::turnKey(state);
+
+   if (record.action.type == Action::Type::DISCARD)
+   {
+      state.hash ^= Zobrist::discardTopKey(state);
+      state.discardSize--;
+      state.hash ^= Zobrist::discardTopKey(state);
+
+      state.hash ^= Zobrist::handKey(player, record.action.card, copiesInHand(hand, state.handSizes[player], record.action.card));
+      hand[state.handSizes[player]++] = hand[record.index];
+      hand[record.index] = record.action.card;
+      return;
+   }
+
+   int card = hand[--state.handSizes[player]];
+   state.hash ^= Zobrist::handKey(player, card, copiesInHand(hand, state.handSizes[player], card));
+
+   if (record.action.type == Action::Type::DRAW_DECK)
+   {
+      state.drawPile[state.drawSize++] = card;
+   }
+   else
+   {
+      state.hash ^= Zobrist::discardTopKey(state);
+      state.discardPile[state.discardSize++] = card;
+      state.hash ^= Zobrist::discardTopKey(state);
+   }
+}
+
+/* *********************************************************************
+Function Name: UndoStack::apply()
+Purpose: Make an action on the state and push its undo record
+Parameters:
+         GameState &state, the state
+         Action action, a legal action in the state
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Assert there's room for the record
+         2) Make the action, filling the next record
+         3) Push the record
+Assistance Received: none
+********************************************************************* */
+void UndoStack::apply(GameState &state, Action action)
+{
+   assert(this->size < CAPACITY);
+   applyInPlace(state, action, this->records[this->size]);
+   this->size++;
+}
+
+/* *********************************************************************
+Function Name: UndoStack::undo()
+Purpose: Take back the last action made with apply()
+Parameters:
+         GameState &state, the state
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Assert there's a record to take back
+         2) Pop the last record
+         3) Take back its action
+Assistance Received: none
+********************************************************************* */
+void UndoStack::undo(GameState &state)
+{
+   assert(this->size > 0);
+   this->size--;
+   ::undo(state, this->records[this->size]);
+}
+
+/* *********************************************************************
+Function Name: UndoStack::empty()
+Purpose: Check if there are no actions to take back
+Parameters:
+         none
+Return Value: a bool, true if the stack is empty
+Local Variables:
+         none
+Algorithm:
+         1) Check the size
+Assistance Received: none
+********************************************************************* */
+bool UndoStack::empty() const
+{
+   return this->size == 0;
+}
+
+/* *********************************************************************
+Function Name: winnerOf()
+Purpose: Find the player who wins with the given scores
+Parameters:
+         const int scores[], each player's score
+Return Value: an int, the index of the player with the lowest score, or
+   -1 if every player has the same score
+Local Variables:
+         int winner, the lowest scoring player so far
+         bool tie, whether every player so far has the same score
+Algorithm:
+         1) The lowest score wins
+         2) If every score is the same, it's a tie
+Assistance Received: none
+********************************************************************* */
+int winnerOf(const int scores[GameState::PLAYER_COUNT])
+{
+   int winner = 0;
+   bool tie = true;
+   for (int i = 1; i < GameState::PLAYER_COUNT; i++)
+   {
+      tie = tie && scores[i] == scores[0];
+      if (scores[i] < scores[winner])
+      {
+         winner = i;
+      }
+   }
+
+   return tie ? -1 : winner;
+}
+
+/* *********************************************************************
+Function Name: canGoOut()
+Purpose: Check if the cards of a hand can all be arranged in books and
+   runs
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+         int round, the round (to know the wild card)
+Return Value: a bool, true if no cards are left after the best arrangement
+Local Variables:
+         none
+Algorithm:
+         1) Rule out most hands quickly: MeldEvaluator finds the least
+            that can be left, never more than the best arrangement, so a
+            hand it can't arrange fully can't go out
+         2) Otherwise check that the best arrangement leaves nothing (every
+            card is worth something)
+Assistance Received: none
+********************************************************************* */
+bool canGoOut(const unsigned char *ids, int size, int round)
+{
+   if (!MeldEvaluator(round).canGoOut(ids, size))
+   {
+      return false;
+   }
+
+   return arrangedDeadwood(ids, size, round) == 0;
+}
+
+/* *********************************************************************
+Function Name: deadwoodScore()
+Purpose: Get the value of the cards of a hand left after their best
+   arrangement
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+         int round, the round (to know the wild card)
+Return Value: an int, the value of the cards left
+Local Variables:
+         none
+Algorithm:
+         1) Find the best arrangement (or take it from the cache) and
+            return the value of the cards left, the way a round is scored
+Assistance Received: none
+********************************************************************* */
+int deadwoodScore(const unsigned char *ids, int size, int round)
+{
+   return arrangedDeadwood(ids, size, round);
+}
+
+/* *********************************************************************
+Function Name: deadwoodScore()
+Purpose: Get the value of the cards of a hand left after their best
+   arrangement
+Parameters:
+         const Hand &hand, the hand
+         int round, the round (to know the wild card)
+Return Value: an int, the value of the cards left
+Local Variables:
+         unsigned char ids[], the card ids of the hand
+         int size, the number of cards
+Algorithm:
+         1) Copy the ids and score them
+Assistance Received: none
+********************************************************************* */
+int deadwoodScore(const Hand &hand, int round)
+{
+   unsigned char ids[Hand::MAX_CARDS];
+   int size = 0;
+   for (const Card &card : hand)
+   {
+      ids[size++] = card.getId();
+   }
+
+   return deadwoodScore(ids, size, round);
+}
+
+/* *********************************************************************
+Function Name: bestDiscard()
+Purpose: Find the card leaving the rest of a hand the least after its
+   best arrangement
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+         int round, the round (to know the wild card)
+         int &deadwood, set to the value the rest is left with
+Return Value: an int, the index in ids of the card to discard
+Local Variables:
+         EvaluationCache &cache, where hands evaluated before are kept
+         uint64_t key, the hand's key
+         EvaluationCache::Entry entry, the hand's entry
+         unsigned char rest[], the hand without a card
+         int best, the index of the best discard so far
+Algorithm:
+         1) If the cache knows the discard, score the rest (from the cache
+            too, usually) and return it
+         2) Otherwise score the rest without each different card, keeping
+            the first that leaves the least
+         3) Record the hand's discard, with what the whole hand is left
+            with
+Assistance Received: none
+********************************************************************* */
+int bestDiscard(const unsigned char *ids, int size, int round, int &deadwood)
+{
+   EvaluationCache &cache = EvaluationCache::shared();
+   std::uint64_t key = EvaluationCache::key(ids, size, round);
+   unsigned char rest[Hand::MAX_CARDS];
+
+   EvaluationCache::Entry entry;
+   if (cache.find(key, entry) && entry.discard != EvaluationCache::NO_DISCARD)
+   {
+      for (int i = 0; i < size; i++)
+      {
+         if (ids[i] == entry.discard)
+         {
+            std::copy(ids, ids + i, rest);
+            std::copy(ids + i + 1, ids + size, rest + i);
+            deadwood = arrangedDeadwood(rest, size - 1, round);
+            return i;
+         }
+      }
+   }
+
+   int best = -1;
+   for (int i = 0; i < size; i++)
+   {
+      // Another copy of a card already tried leaves the same
+      if (copiesInHand(ids, i, ids[i]) > 0)
+      {
+         continue;
+      }
+
+      std::copy(ids, ids + i, rest);
+      std::copy(ids + i + 1, ids + size, rest + i);
+      int left = arrangedDeadwood(rest, size - 1, round);
+      if (best == -1 || left < deadwood)
+      {
+         best = i;
+         deadwood = left;
+      }
+   }
+
+   if (best != -1 && cache.isRecording())
+   {
+      entry.deadwood = arrangedDeadwood(ids, size, round);
+      entry.discard = ids[best];
+      cache.record(key, entry);
+   }
+
+   return best;
+}
@@ -0,0 +1,150 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include "hand.h"
+#include <type_traits>   // std::is_trivially_copyable
+
+// One step of a turn: draw from the deck or the discard pile, then discard a card
+struct Action
+{
+   enum class Type : unsigned char {
+      DRAW_DECK = 0,
+      DRAW_DISCARD,
+      DISCARD
+   };
+
+   Type type;
+
+   // Id of the card discarded (see Card::getId())
+   unsigned char card;
+};
+
+// The whole state of a game as card ids in fixed size arrays, so it can be
+// copied with a memcpy and searched without allocating. Piles keep their top
+// card last. Game, GameFile, and the journal convert to and from it.
+struct GameState
+{
+   static const int PLAYER_COUNT = 2;
+   static const int MAX_HAND = Hand::MAX_CARDS;
+
+   // Two decks of every card
+   static const int DECK_SIZE = 2 * Card::NUMBER_OF_IDS;
+
+   // Most actions in a state: discarding any card of a full hand
+   static const int MAX_ACTIONS = MAX_HAND;
+
+   // What the player to move does next
+   enum class Phase : unsigned char {
+      DRAW = 0,
+      DISCARD,
+      ROUND_OVER
+   };
+
+   unsigned char hands[PLAYER_COUNT][MAX_HAND];
+   unsigned char handSizes[PLAYER_COUNT];
+   unsigned char drawPile[DECK_SIZE];
+   unsigned char discardPile[DECK_SIZE];
+   unsigned char drawSize;
+   unsigned char discardSize;
+   unsigned short scores[PLAYER_COUNT];
+   unsigned char round;
+   unsigned char playerToMove;
+   Phase phase;
+
+   // Players who went out this round, and whether the current turn is a last turn
+   unsigned char goneOutCount;
+   bool lastTurn;
+
+   // Seed the decks are shuffled with
+   unsigned seed;
+
+   // Zobrist hash of what the players can see (see Zobrist), kept up to date
+   // by applyInPlace() and undo()
+   unsigned long long hash;
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must be copyable with memcpy");
+
+// What applyInPlace() changed, so undo() can put it back without copying the state
+struct UndoRecord
+{
+   Action action;
+
+   // Where the discarded card was in the hand
+   unsigned char index;
+
+   // The turn before the action
+   unsigned char playerToMove;
+   GameState::Phase phase;
+   unsigned char goneOutCount;
+   bool lastTurn;
+
+   // The scores before the action (they change when it ends the round)
+   unsigned short scores[GameState::PLAYER_COUNT];
+};
+
+// Fixed capacity stack of undo records for searching a line of actions
+// and taking them back, without allocating
+struct UndoStack
+{
+   // Deepest line of actions that can be taken back
+   static const int CAPACITY = 512;
+
+   UndoRecord records[CAPACITY];
+   int size = 0;
+
+   // Make the action on the state and push its undo record
+   void apply(GameState &state, Action action);
+
+   // Take back the last action made with apply()
+   void undo(GameState &state);
+
+   // Check if there are no actions to take back
+   bool empty() const;
+};
+
+// Start a round: shuffle the deck with the seed like Round, deal round + 2 cards
+// to each player, and turn over the first discard
+GameState startRound(int round, unsigned seed, int firstPlayer, int computerScore, int humanScore);
+
+// Fill actions with every legal action in the state and return how many there are
+int legalActions(const GameState &state, Action actions[GameState::MAX_ACTIONS]);
+
+// Check if an action can be made in the state
+bool isLegal(const GameState &state, Action action);
+
+// Return the state after making a legal action. When the round ends, every
+// player's cards left after their best arrangement are added to their score
+GameState apply(const GameState &state, Action action);
+
+// Make a legal action on the state itself, filling record with what changed
+// Every action takes constant time besides checking if the player went out,
+// including updating the hash
+void applyInPlace(GameState &state, Action action, UndoRecord &record);
+
+// Take back the action that filled record, which must be the last one made
+void undo(GameState &state, const UndoRecord &record);
+
+// The player with the lowest score, who wins the game (see
+// Game::determineWinner()), or -1 if every player has the same score
+int winnerOf(const int scores[GameState::PLAYER_COUNT]);
+
+// These evaluate hands with CombinationFinder like Player, through the
+// shared EvaluationCache, recording what they find while it's recording
+
+// Check if the cards of a hand can all be arranged in books and runs
+bool canGoOut(const unsigned char *ids, int size, int round);
+
+// The value of the cards of a hand left after their best arrangement, the
+// one Player::goOut() checks, so rounds score the same with or without a
+// SolutionTable (which only the computer's search uses)
+int deadwoodScore(const unsigned char *ids, int size, int round);
+
+// The value of the cards of a hand left after their best arrangement, as above
+int deadwoodScore(const Hand &hand, int round);
+
+// The index of the card leaving the rest of a hand the least after its best
+// arrangement, setting deadwood to what the rest is left with
+int bestDiscard(const unsigned char *ids, int size, int round, int &deadwood);
+
+#endif
@@ -0,0 +1,507 @@
+/************************************************************
+* Measures how many whole games the computer plays a second: two
+* Computers play all 11 rounds against each other on a GameState, dealt
+* from fixed seeds, deciding every draw with Computer::move() and every
+* discard with Computer::getCardToDiscard(), as in Game. The same games
+* are played on 1 thread and then on more, up to one per core, to show
+* how the throughput scales.
+*
+* Usage: gamebench [-g games] [-s seed] [-d difficulty] [-j threads]
+*                  [-o file] [-l label] [-b baseline] [-t percent]
+*    -g games        games played at each thread count (default 100)
+*    -s seed         game i is dealt from seed + i (default 1)
+*    -d difficulty   how long the computers think, 0 to 3 (default 0)
+*    -j threads      most threads to scale to (default: one per core)
+*    -o file         where to write the results as JSON (default
+*                    gamebench.json)
+*    -l label        written with the results, such as the commit measured
+*    -b baseline     results of an earlier run to compare against
+*    -t percent      slowdown from the baseline flagged as a regression
+*                    (default 5)
+*
+* It reports games and turns a second, and the mean time of each call to
+* move() and getCardToDiscard(). A turn is one player's draw and discard.
+* The computers' messages are thrown away. Rounds end as in SelfPlay:
+* players passing a card back and forth draw from the deck instead, and a
+* round whose deck runs out is scored as it stands. Exits with 1 if any
+* thread count of the baseline got slower by more than the threshold.
+************************************************************/
+
+#include "computer.h"
+#include "gameState.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace
+{
+   // The last round of a game
+   const int LAST_ROUND = 11;
+
+   // Takes whatever is written to it and keeps none of it. With no buffer
+   // it holds no state, so every thread can write to it at once
+   class NullBuffer : public std::streambuf
+   {
+      protected:
+         virtual int overflow(int c) override { return c; }
+   };
+
+   // What playing some games took
+   struct Totals
+   {
+      long long games = 0;
+      long long turns = 0;
+      long long moves = 0;
+      long long discards = 0;
+      double moveSeconds = 0;
+      double discardSeconds = 0;
+
+      // Every player's score added up, the same for the same games
+      long long points = 0;
+
+      void add(const Totals &other)
+      {
+         this->games += other.games;
+         this->turns += other.turns;
+         this->moves += other.moves;
+         this->discards += other.discards;
+         this->moveSeconds += other.moveSeconds;
+         this->discardSeconds += other.discardSeconds;
+         this->points += other.points;
+      }
+   };
+
+   // What the games did on a number of threads
+   struct Result
+   {
+      unsigned threads = 0;
+      double gamesPerSecond = 0;
+      double turnsPerSecond = 0;
+      double moveMicroseconds = 0;
+      double discardMicroseconds = 0;
+      double speedup = 0;
+      double efficiency = 0;
+   };
+
+   // Seconds since start
+   double secondsSince(std::chrono::steady_clock::time_point start)
+   {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+
+   // The hand of a player in a state
+   Hand handOf(const GameState &state, int player)
+   {
+      Hand hand;
+      for (int i = 0; i < state.handSizes[player]; i++)
+      {
+         hand.add(Card::fromId(state.hands[player][i], state.round));
+      }
+
+      return hand;
+   }
+
+   // Play a whole game between two computers dealt from seed, the way Game
+   // asks them for their moves
+   Totals playGame(unsigned seed, Difficulty difficulty)
+   {
+      Computer computers[GameState::PLAYER_COUNT];
+      for (Computer &computer : computers)
+      {
+         computer.setDifficulty(difficulty);
+      }
+
+      Totals totals;
+      int scores[GameState::PLAYER_COUNT] = { 0, 0 };
+      int firstPlayer = 0;
+      std::vector<unsigned long long> seen;
+
+      for (int round = 1; round <= LAST_ROUND; round++)
+      {
+         GameState state = startRound(round, seed + round * 0x9e3779b9u, firstPlayer, scores[0], scores[1]);
+
+         std::vector<int> discardPile(state.discardPile, state.discardPile + state.discardSize);
+         for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+         {
+            computers[player].observeRoundStart(round, state.handSizes[1 - player], discardPile);
+         }
+
+         UndoRecord record;
+         seen.clear();
+         while (state.phase != GameState::Phase::ROUND_OVER
+            && !(state.phase == GameState::Phase::DRAW && state.drawSize == 0))
+         {
+            int player = state.playerToMove;
+            unsigned char goneOut = state.goneOutCount;
+            Computer &computer = computers[player];
+            Card top = state.discardSize == 0 ? Card() : Card::fromId(state.discardPile[state.discardSize - 1], state.round);
+
+            computer.setHand(handOf(state, player));
+            computer.setTopOfDiscard(top);
+            computer.setGameState(state);
+
+            Action action;
+            if (state.phase == GameState::Phase::DRAW)
+            {
+               action = { Action::Type::DRAW_DECK, 0 };
+               if (state.discardSize > 0)
+               {
+                  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                  int choice = computer.move();
+                  totals.moveSeconds += secondsSince(start);
+                  totals.moves++;
+
+                  // Players passing a card back and forth would never end
+                  // the round (see SelfPlay)
+                  if (choice == static_cast<int>(Player::moveOption::DRAW_DISCARD)
+                     && std::find(seen.begin(), seen.end(), state.hash) == seen.end())
+                  {
+                     action.type = Action::Type::DRAW_DISCARD;
+                  }
+               }
+
+               bool fromDiscard = action.type == Action::Type::DRAW_DISCARD;
+               Card card = fromDiscard ? top : Card::fromId(state.drawPile[state.drawSize - 1], state.round);
+               if (fromDiscard)
+               {
+                  seen.push_back(state.hash);
+               }
+               else
+               {
+                  seen.clear();
+               }
+
+               applyInPlace(state, action, record);
+               for (int other = 0; other < GameState::PLAYER_COUNT; other++)
+               {
+                  computers[other].observeDraw(other == player, fromDiscard, card);
+               }
+            }
+            else
+            {
+               std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+               std::string name = computer.getCardToDiscard().second;
+               totals.discardSeconds += secondsSince(start);
+               totals.discards++;
+
+               int index = computer.findIndexInHand(name);
+               if (index == -1)
+               {
+                  int deadwood;
+                  index = bestDiscard(state.hands[player], state.handSizes[player], state.round, deadwood);
+               }
+               action = { Action::Type::DISCARD, state.hands[player][index] };
+
+               applyInPlace(state, action, record);
+               for (int other = 0; other < GameState::PLAYER_COUNT; other++)
+               {
+                  computers[other].observeDiscard(other == player, Card::fromId(action.card, round));
+               }
+               totals.turns++;
+            }
+
+            if (state.goneOutCount > goneOut)
+            {
+               firstPlayer = player;
+            }
+         }
+
+         if (state.phase == GameState::Phase::ROUND_OVER)
+         {
+            scores[0] = state.scores[0];
+            scores[1] = state.scores[1];
+         }
+         else
+         {
+            for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+            {
+               scores[player] += deadwoodScore(state.hands[player], state.handSizes[player], state.round);
+            }
+         }
+      }
+
+      totals.games = 1;
+      totals.points = scores[0] + scores[1];
+
+      return totals;
+   }
+
+   // Play games across threads, returning what they took and how long in all
+   Totals playGames(int games, unsigned seed, Difficulty difficulty, unsigned threads, double &seconds)
+   {
+      std::vector<Totals> played(games);
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      parallelFor(played.size(), [&](size_t i)
+      {
+         played[i] = playGame(seed + static_cast<unsigned>(i), difficulty);
+      }, threads);
+      seconds = secondsSince(start);
+
+      Totals totals;
+      for (const Totals &game : played)
+      {
+         totals.add(game);
+      }
+
+      return totals;
+   }
+
+   // The number after "key": in a line of JSON, or -1 if there's none
+   double numberAfter(const std::string &line, const std::string &key)
+   {
+      size_t position = line.find("\"" + key + "\":");
+      if (position == std::string::npos)
+      {
+         return -1;
+      }
+
+      return std::atof(line.c_str() + position + key.size() + 3);
+   }
+
+   // Read the results and points of an earlier run. Returns true if it
+   // could not be read
+   bool readBaseline(const std::string &fileName, std::vector<Result> &results, long long &points)
+   {
+      std::ifstream file(fileName);
+      if (!file)
+      {
+         return true;
+      }
+
+      std::string line;
+      while (std::getline(file, line))
+      {
+         if (numberAfter(line, "threads") > 0)
+         {
+            Result result;
+            result.threads = static_cast<unsigned>(numberAfter(line, "threads"));
+            result.gamesPerSecond = numberAfter(line, "games_per_second");
+            result.turnsPerSecond = numberAfter(line, "turns_per_second");
+            result.moveMicroseconds = numberAfter(line, "move_us");
+            result.discardMicroseconds = numberAfter(line, "discard_us");
+            results.push_back(result);
+         }
+         else if (numberAfter(line, "points") >= 0)
+         {
+            points = static_cast<long long>(numberAfter(line, "points"));
+         }
+      }
+
+      return results.empty();
+   }
+
+   // Percent a measure got worse from the baseline: slower throughput or
+   // longer latency
+   double slowdown(double baseline, double current, bool higherIsBetter)
+   {
+      if (baseline <= 0)
+      {
+         return 0;
+      }
+
+      return 100 * (higherIsBetter ? (baseline - current) / baseline : (current - baseline) / baseline);
+   }
+
+   // Write the results as JSON
+   std::string toJson(const std::vector<Result> &results, const std::string &text, unsigned seed, int games,
+      Difficulty difficulty, long long points)
+   {
+      std::string label;
+      for (char c : text)
+      {
+         if (c == '"' || c == '\\')
+         {
+            label += '\\';
+         }
+         label += c;
+      }
+
+      std::ostringstream json;
+      json << std::fixed << std::setprecision(2);
+      json << "{\n  \"benchmark\": \"gamebench\",\n  \"label\": \"" << label << "\",\n  \"seed\": " << seed
+         << ",\n  \"games\": " << games << ",\n  \"difficulty\": " << static_cast<int>(difficulty)
+         << ",\n  \"points\": " << points << ",\n  \"results\": [\n";
+      for (size_t i = 0; i < results.size(); i++)
+      {
+         const Result &result = results[i];
+         json << "    { \"threads\": " << result.threads << ", \"games_per_second\": " << result.gamesPerSecond
+            << ", \"turns_per_second\": " << result.turnsPerSecond << ", \"move_us\": " << result.moveMicroseconds
+            << ", \"discard_us\": " << result.discardMicroseconds << ", \"speedup\": " << result.speedup
+            << ", \"efficiency\": " << result.efficiency << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+      }
+      json << "  ]\n}\n";
+
+      return json.str();
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   int games = 100;
+   unsigned seed = 1;
+   Difficulty difficulty = Difficulty::HEURISTIC;
+   unsigned maxThreads = defaultThreadCount();
+   std::string fileName = "gamebench.json";
+   std::string label;
+   std::string baselineName;
+   double threshold = 5;
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if (argument == "-g" && i + 1 < argc)
+      {
+         games = std::max(1, std::atoi(argv[++i]));
+      }
+      else if (argument == "-s" && i + 1 < argc)
+      {
+         seed = std::strtoul(argv[++i], nullptr, 10);
+      }
+      else if (argument == "-d" && i + 1 < argc)
+      {
+         int level = std::atoi(argv[++i]);
+         if (level < static_cast<int>(Difficulty::HEURISTIC) || level > static_cast<int>(Difficulty::HARD))
+         {
+            std::cerr << "Difficulty must be from 0 to 3\n";
+            return EXIT_FAILURE;
+         }
+         difficulty = static_cast<Difficulty>(level);
+      }
+      else if (argument == "-j" && i + 1 < argc)
+      {
+         maxThreads = std::max(1, std::atoi(argv[++i]));
+      }
+      else if (argument == "-o" && i + 1 < argc)
+      {
+         fileName = argv[++i];
+      }
+      else if (argument == "-l" && i + 1 < argc)
+      {
+         label = argv[++i];
+      }
+      else if (argument == "-b" && i + 1 < argc)
+      {
+         baselineName = argv[++i];
+      }
+      else if (argument == "-t" && i + 1 < argc)
+      {
+         threshold = std::atof(argv[++i]);
+      }
+      else
+      {
+         std::cerr << "Usage: " << argv[0] << " [-g games] [-s seed] [-d difficulty] [-j threads] [-o file] [-l label]"
+            << " [-b baseline] [-t percent]\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   std::vector<Result> baseline;
+   long long baselinePoints = -1;
+   if (!baselineName.empty() && readBaseline(baselineName, baseline, baselinePoints))
+   {
+      std::cerr << "Could not read results from " << baselineName << "\n";
+      return EXIT_FAILURE;
+   }
+
+   // 1 thread, then doubling up to the most
+   std::vector<unsigned> threadCounts;
+   for (unsigned threads = 1; threads < maxThreads; threads *= 2)
+   {
+      threadCounts.push_back(threads);
+   }
+   threadCounts.push_back(maxThreads);
+
+   NullBuffer nothing;
+   std::streambuf *console = std::cout.rdbuf();
+
+   std::vector<Result> results;
+   long long points = 0;
+   std::cout << std::setw(8) << "threads" << std::setw(10) << "games/s" << std::setw(10) << "turns/s" << std::setw(11)
+      << "move us" << std::setw(11) << "discard us" << std::setw(9) << "speedup" << std::setw(12) << "efficiency" << "\n";
+   for (unsigned threads : threadCounts)
+   {
+      double seconds;
+      std::cout.rdbuf(&nothing);
+      Totals totals = playGames(games, seed, difficulty, threads, seconds);
+      std::cout.rdbuf(console);
+
+      Result result;
+      result.threads = threads;
+      result.gamesPerSecond = totals.games / seconds;
+      result.turnsPerSecond = totals.turns / seconds;
+      result.moveMicroseconds = totals.moves == 0 ? 0 : 1e6 * totals.moveSeconds / totals.moves;
+      result.discardMicroseconds = totals.discards == 0 ? 0 : 1e6 * totals.discardSeconds / totals.discards;
+      result.speedup = result.gamesPerSecond / (results.empty() ? result.gamesPerSecond : results[0].gamesPerSecond);
+      result.efficiency = result.speedup / threads;
+      results.push_back(result);
+      points = totals.points;
+
+      std::cout << std::fixed << std::setprecision(1) << std::setw(8) << threads << std::setw(10) << result.gamesPerSecond
+         << std::setw(10) << result.turnsPerSecond << std::setw(11) << result.moveMicroseconds << std::setw(11)
+         << result.discardMicroseconds << std::setprecision(2) << std::setw(9) << result.speedup << std::setw(12)
+         << result.efficiency << "\n";
+   }
+
+   std::ofstream file(fileName, std::ios::trunc);
+   file << toJson(results, label, seed, games, difficulty, points);
+   if (!file)
+   {
+      std::cerr << "Could not write " << fileName << "\n";
+      return EXIT_FAILURE;
+   }
+   std::cout << "Wrote " << fileName << "\n";
+
+   if (baseline.empty())
+   {
+      return EXIT_SUCCESS;
+   }
+
+   // Compare each thread count the baseline also ran
+   std::cout << "\nAgainst " << baselineName << " (percent slower, flagged beyond " << threshold << "%):\n";
+   if (baselinePoints != -1 && baselinePoints != points)
+   {
+      std::cout << "The games played out differently from the baseline's, so they did different work\n";
+   }
+
+   bool regressed = false;
+   std::cout << std::setw(8) << "threads" << std::setw(10) << "games/s" << std::setw(10) << "turns/s" << std::setw(11)
+      << "move us" << std::setw(11) << "discard us" << "\n";
+   for (const Result &result : results)
+   {
+      for (const Result &before : baseline)
+      {
+         if (before.threads != result.threads)
+         {
+            continue;
+         }
+
+         double changes[] = {
+            slowdown(before.gamesPerSecond, result.gamesPerSecond, true),
+            slowdown(before.turnsPerSecond, result.turnsPerSecond, true),
+            slowdown(before.moveMicroseconds, result.moveMicroseconds, false),
+            slowdown(before.discardMicroseconds, result.discardMicroseconds, false)
+         };
+
+         bool flagged = false;
+         std::cout << std::fixed << std::setprecision(1) << std::setw(8) << result.threads;
+         for (int i = 0; i < 4; i++)
+         {
+            std::cout << std::setw(i < 2 ? 10 : 11) << changes[i];
+            flagged = flagged || changes[i] > threshold;
+         }
+         std::cout << (flagged ? "   REGRESSION" : "") << "\n";
+         regressed = regressed || flagged;
+      }
+   }
+
+   return regressed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,714 @@
+/************************************************************
+* Keeps a corpus of saved positions whose hands have known optimal
+* deadwood, and checks how close the ways of scoring a hand come to it.
+*
+* Usage: golden generate [-d dir] [-n positions] [-s seed] [-j threads]
+*        golden check [-d dir] [-e evaluator] [-a gap] [-j threads]
+*    -d dir          where the corpus is (default: ../TEST_CASES/golden)
+*    generate        deal positions and write their hands and the optimal
+*                    deadwood of each to golden.txt, saving every 100th
+*                    position as a text game file as well
+*    -n positions    positions to deal, spread evenly over the rounds
+*                    (default 2200)
+*    -s seed         seed the positions are dealt from (default 1)
+*    check           score every hand of the corpus with an evaluator and
+*                    report how far it is from the optimum, and how fast
+*    -e evaluator    finder, books, runs, meld, deadwood, reference, or
+*                    all (default)
+*    -a gap          fail if an evaluator's mean gap is above gap points
+*    -j threads      number of threads to use (default: one per core)
+*
+* Positions are dealt with startRound() and played on with random legal
+* actions to a draw, before anyone has gone out. Each gives three hands:
+* the computer's, the human's, and the hand of the player to move with
+* the top of the discard pile drawn (a card more than the others).
+* golden.txt keeps every position in three lines, the round, the optimal
+* deadwood of each hand, the player to move and the top of the discard
+* pile, then the card ids of the computer's hand and of the human's, so
+* check reads the corpus as it was made and never deals it again. The
+* sample game files are only checked to still load, with the hands the
+* index has for them.
+* The optimum is found by a search of every way of splitting the hand into
+* books and runs (see referenceDeadwood()), which is too slow for play but
+* shares nothing with the evaluators but the cards, and generate fails if
+* MeldEvaluator, which is meant to be exact, ever disagrees with it.
+* check exits with 1 if an evaluator leaves less than the optimum on any
+* hand, since the evaluator or the corpus must then be wrong, or if its
+* mean gap is above -a.
+************************************************************/
+
+#include "combinationFinder.h"
+#include "gameFile.h"
+#include "gameState.h"
+#include "meldEvaluator.h"
+#include "parallel.h"
+#include "player.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+   // First line of the index of the corpus
+   const std::string HEADER = "Five Crowns golden positions 3";
+
+   // Name of the index of the corpus in its directory
+   const std::string INDEX_NAME = "golden.txt";
+
+   // Start of the names of the positions saved as game files
+   const std::string SAMPLE_PREFIX = "position_";
+
+   // Every this many positions is saved as a game file
+   const int SAMPLE_EVERY = 100;
+
+   // The hands of each position
+   const int HANDS = 3;
+   const char *HAND_NAMES[HANDS] = { "computer", "human", "drawn" };
+
+   // The last round of a game
+   const int LAST_ROUND = 11;
+
+   // Most random actions played on from the deal
+   const int MAX_ACTIONS = 40;
+
+   // The hands dealt in full in each position: the computer's and the
+   // human's
+   const int DEALT = 2;
+
+   // A position of the corpus: its number, round, the optimal deadwood of
+   // each of its hands, the player to move (0 for the computer), the top of
+   // the discard pile, and the card ids of the hands dealt
+   struct Golden
+   {
+      int position = 0;
+      int round = 0;
+      int optimal[HANDS] = { 0, 0, 0 };
+      int nextPlayer = 0;
+      int top = 0;
+      std::vector<int> ids[DEALT];
+   };
+
+   // A hand to score, and the least it can be left with
+   struct Case
+   {
+      Hand hand;
+      std::vector<unsigned char> ids;
+      int round = 0;
+      int optimal = 0;
+   };
+
+   // A way of scoring a hand
+   struct Evaluator
+   {
+      const char *name;
+      int (*score)(const Case &hand);
+   };
+
+   // Check if cards make a book or a run: three or more cards where every
+   // card that isn't wild has the same number, or the same suit with no
+   // number twice and few enough gaps for the wild cards to fill
+   bool isMeld(const std::vector<Card> &cards)
+   {
+      if (cards.size() < 3)
+      {
+         return false;
+      }
+
+      std::vector<int> naturals;
+      for (const Card &card : cards)
+      {
+         if (!card.isWild())
+         {
+            naturals.push_back(card.getId());
+         }
+      }
+      if (naturals.empty())
+      {
+         return true;
+      }
+
+      bool book = true;
+      bool run = cards.size() <= static_cast<size_t>(Card::NUMBER_OF_NUMBERS);
+      int lowest = Card::NUMBER_OF_NUMBERS;
+      int highest = -1;
+      std::vector<bool> numbers(Card::NUMBER_OF_NUMBERS, false);
+      for (int id : naturals)
+      {
+         int number = id % Card::NUMBER_OF_NUMBERS;
+         book = book && number == naturals[0] % Card::NUMBER_OF_NUMBERS;
+         run = run && id / Card::NUMBER_OF_NUMBERS == naturals[0] / Card::NUMBER_OF_NUMBERS && !numbers[number];
+         numbers[number] = true;
+         lowest = std::min(lowest, number);
+         highest = std::max(highest, number);
+      }
+
+      return book || (run && highest - lowest + 1 <= static_cast<int>(cards.size()));
+   }
+
+   // The least a hand can be left with, found by trying every way of
+   // splitting it into books and runs: the first card left is either left
+   // over or in a book or run with some of the others, and the best of
+   // what's left is kept for each set of cards
+   int referenceDeadwood(const Case &hand)
+   {
+      int size = hand.hand.size();
+      int masks = 1 << size;
+
+      std::vector<bool> meld(masks, false);
+      std::vector<Card> cards;
+      for (int mask = 0; mask < masks; mask++)
+      {
+         cards.clear();
+         for (int i = 0; i < size; i++)
+         {
+            if (mask & (1 << i))
+            {
+               cards.push_back(hand.hand[i]);
+            }
+         }
+         meld[mask] = isMeld(cards);
+      }
+
+      // best[mask] is the least the cards in mask can be left with, worked
+      // out from smaller sets first
+      std::vector<int> best(masks, 0);
+      for (int mask = 1; mask < masks; mask++)
+      {
+         int first = 0;
+         while (!(mask & (1 << first)))
+         {
+            first++;
+         }
+
+         int rest = mask & ~(1 << first);
+         int least = hand.hand[first].getValue() + best[rest];
+         for (int others = rest; others != 0; others = (others - 1) & rest)
+         {
+            int used = others | (1 << first);
+            if (meld[used])
+            {
+               least = std::min(least, best[mask & ~used]);
+            }
+         }
+         best[mask] = least;
+      }
+
+      return best[masks - 1];
+   }
+
+   // The evaluators check can measure
+   const Evaluator EVALUATORS[] = {
+      { "finder", [](const Case &hand) { return Player::bestArrangement(hand.hand).getScore(); } },
+      { "books", [](const Case &hand)
+         {
+            CombinationFinder finder(hand.hand);
+            finder.findCombinations(CombinationFinder::Order::BOOKS_FIRST);
+            return finder.getScore();
+         } },
+      { "runs", [](const Case &hand)
+         {
+            CombinationFinder finder(hand.hand);
+            finder.findCombinations(CombinationFinder::Order::RUNS_FIRST);
+            return finder.getScore();
+         } },
+      { "meld", [](const Case &hand) { return MeldEvaluator(hand.round).deadwood(hand.ids.data(), hand.ids.size()); } },
+      { "deadwood", [](const Case &hand) { return deadwoodScore(hand.ids.data(), hand.ids.size(), hand.round); } },
+      { "reference", referenceDeadwood }
+   };
+
+   // Make a case of a hand in a round
+   Case makeCase(const Hand &hand, int round)
+   {
+      Case made;
+      made.hand = hand;
+      made.round = round;
+      for (const Card &card : hand)
+      {
+         made.ids.push_back(card.getId());
+      }
+
+      return made;
+   }
+
+   // A position as it's kept in the index, from a saved position
+   Golden goldenOf(const GameFile &file, int position)
+   {
+      Golden golden;
+      golden.position = position;
+      golden.round = file.getGameRound();
+      golden.nextPlayer = file.getNextPlayer();
+      golden.top = file.getDiscardPile().front().getId();
+      const Hand *dealt[DEALT] = { &file.getComputerHand(), &file.getHumanHand() };
+      for (int hand = 0; hand < DEALT; hand++)
+      {
+         for (const Card &card : *dealt[hand])
+         {
+            golden.ids[hand].push_back(card.getId());
+         }
+      }
+
+      return golden;
+   }
+
+   // The hands of a position: the computer's, the human's, and the player
+   // to move's with the top of the discard pile
+   void handsOf(const Golden &golden, Hand hands[])
+   {
+      for (int hand = 0; hand < DEALT; hand++)
+      {
+         hands[hand] = Hand();
+         for (int id : golden.ids[hand])
+         {
+            hands[hand].add(Card::fromId(id, golden.round));
+         }
+      }
+      hands[2] = hands[golden.nextPlayer];
+      hands[2].add(Card::fromId(golden.top, golden.round));
+   }
+
+   // Deal a position in a round and play random legal actions on it, until
+   // a player is to draw and no one has gone out
+   GameState dealPosition(int round, std::mt19937 &generator)
+   {
+      while (true)
+      {
+         GameState state = startRound(round, generator(), generator() % GameState::PLAYER_COUNT, generator() % 200,
+            generator() % 200);
+
+         int actions = generator() % (MAX_ACTIONS + 1);
+         UndoRecord record;
+         for (int i = 0; (i < actions || state.phase == GameState::Phase::DISCARD) && state.phase != GameState::Phase::ROUND_OVER
+            && state.goneOutCount == 0 && !(state.phase == GameState::Phase::DRAW && state.drawSize == 0); i++)
+         {
+            Action legal[GameState::MAX_ACTIONS];
+            int count = legalActions(state, legal);
+            applyInPlace(state, legal[generator() % count], record);
+         }
+
+         if (state.phase == GameState::Phase::DRAW && state.goneOutCount == 0 && state.drawSize > 0 && state.discardSize > 0)
+         {
+            return state;
+         }
+      }
+   }
+
+   // The name of the game file a position is saved as
+   std::string sampleName(int position)
+   {
+      char name[32];
+      std::snprintf(name, sizeof(name), "%s%04d.txt", SAMPLE_PREFIX.c_str(), position);
+      return name;
+   }
+
+   // Deal every position of a corpus from a seed across threads, as the
+   // text of a game file and as kept in the index
+   void dealCorpus(int positions, unsigned seed, unsigned threads, std::vector<std::string> &texts, std::vector<Golden> &golden)
+   {
+      texts.assign(positions, std::string());
+      golden.assign(positions, Golden());
+      parallelFor(positions, [&](size_t i)
+      {
+         std::mt19937 generator(seed ^ static_cast<unsigned>(i * 0x9e3779b9u));
+
+         GameFile file;
+         file.setGameState(dealPosition(i % LAST_ROUND + 1, generator));
+         texts[i] = file.serializeText();
+         golden[i] = goldenOf(file, i);
+      }, threads);
+   }
+
+   // Deal the corpus into a directory. Returns true if it could not be made
+   bool generate(const std::string &directory, int positions, unsigned seed, unsigned threads)
+   {
+      std::error_code error;
+      std::filesystem::create_directories(directory, error);
+
+      std::vector<std::string> texts;
+      std::vector<Golden> golden;
+      dealCorpus(positions, seed, threads, texts, golden);
+
+      // Solve every position on every thread
+      std::vector<int> disagreements(positions, 0);
+      parallelFor(positions, [&](size_t i)
+      {
+         Hand hands[HANDS];
+         handsOf(golden[i], hands);
+         for (int hand = 0; hand < HANDS; hand++)
+         {
+            Case made = makeCase(hands[hand], golden[i].round);
+            golden[i].optimal[hand] = referenceDeadwood(made);
+            if (MeldEvaluator(golden[i].round).deadwood(made.ids.data(), made.ids.size()) != golden[i].optimal[hand])
+            {
+               disagreements[i]++;
+            }
+         }
+      }, threads);
+
+      bool failed = false;
+      for (int i = 0; i < positions; i++)
+      {
+         if (disagreements[i] > 0)
+         {
+            std::cerr << "position " << i << ": MeldEvaluator disagrees with the reference search\n";
+            failed = true;
+         }
+      }
+      if (failed)
+      {
+         return true;
+      }
+
+      // The sample of an older corpus would not match the new index
+      for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(directory, error))
+      {
+         if (entry.path().filename().string().compare(0, SAMPLE_PREFIX.size(), SAMPLE_PREFIX) == 0)
+         {
+            std::filesystem::remove(entry.path(), error);
+         }
+      }
+
+      std::ostringstream index;
+      index << HEADER << "\n# position round, the optimal deadwood of the computer's hand, the human's, and the drawn\n"
+         << "# hand, the player to move (0 the computer), and the top of the discard pile, then the card\n"
+         << "# ids of the computer's hand and of the human's\n"
+         << "# dealt from seed " << seed << "\n";
+
+      GameFile saver;
+      for (int i = 0; i < positions; i++)
+      {
+         if (i % SAMPLE_EVERY == 0 && saver.saveGameToFile(directory + "/" + sampleName(i), texts[i]))
+         {
+            return true;
+         }
+
+         index << golden[i].position << " " << golden[i].round;
+         for (int optimal : golden[i].optimal)
+         {
+            index << " " << optimal;
+         }
+         index << " " << golden[i].nextPlayer << " " << golden[i].top << "\n";
+         for (int hand = 0; hand < DEALT; hand++)
+         {
+            index << HAND_NAMES[hand];
+            for (int id : golden[i].ids[hand])
+            {
+               index << " " << id;
+            }
+            index << "\n";
+         }
+      }
+
+      return saver.saveGameToFile(directory + "/" + INDEX_NAME, index.str());
+   }
+
+   // Check that a position read from the index could have been dealt: a
+   // round of the game, a player to move, hands of the round's size, and
+   // no card more often than the two decks have it
+   bool isDealt(const Golden &golden)
+   {
+      if (golden.round < 1 || golden.round > LAST_ROUND || golden.nextPlayer < 0 || golden.nextPlayer >= DEALT
+         || golden.top < 0 || golden.top >= Card::NUMBER_OF_IDS)
+      {
+         return false;
+      }
+
+      int copies[Card::NUMBER_OF_IDS] = {};
+      copies[golden.top]++;
+      for (const std::vector<int> &ids : golden.ids)
+      {
+         if (static_cast<int>(ids.size()) != golden.round + 2)
+         {
+            return false;
+         }
+
+         for (int id : ids)
+         {
+            if (id < 0 || id >= Card::NUMBER_OF_IDS || ++copies[id] > 2)
+            {
+               return false;
+            }
+         }
+      }
+
+      return true;
+   }
+
+   // Read every position of the corpus from its index. Returns true if it
+   // could not be read
+   bool readIndex(const std::string &directory, std::vector<Golden> &golden)
+   {
+      std::ifstream file(directory + "/" + INDEX_NAME);
+      std::string line;
+      if (!std::getline(file, line) || line != HEADER)
+      {
+         return true;
+      }
+
+      // The next line that isn't empty or a comment
+      auto nextLine = [&file, &line]()
+      {
+         while (std::getline(file, line))
+         {
+            if (!line.empty() && line[0] != '#')
+            {
+               return true;
+            }
+         }
+
+         return false;
+      };
+
+      while (nextLine())
+      {
+         std::istringstream words(line);
+         Golden position;
+         words >> position.position >> position.round;
+         for (int &optimal : position.optimal)
+         {
+            words >> optimal;
+         }
+         words >> position.nextPlayer >> position.top;
+
+         // Positions are numbered in order, so their samples can be found
+         if (!words || position.position != static_cast<int>(golden.size()))
+         {
+            std::cerr << INDEX_NAME << ": position " << golden.size() << " can't be read\n";
+            return true;
+         }
+
+         for (int hand = 0; hand < DEALT; hand++)
+         {
+            std::string name;
+            int id;
+            if (!nextLine() || !(std::istringstream(line) >> name) || name != HAND_NAMES[hand])
+            {
+               std::cerr << INDEX_NAME << ": position " << position.position << " has no " << HAND_NAMES[hand] << "'s hand\n";
+               return true;
+            }
+
+            std::istringstream ids(line.substr(name.size()));
+            while (ids >> id)
+            {
+               position.ids[hand].push_back(id);
+            }
+            if (!ids.eof())
+            {
+               std::cerr << INDEX_NAME << ": position " << position.position << " has a " << HAND_NAMES[hand]
+                  << "'s hand that can't be read\n";
+               return true;
+            }
+         }
+
+         if (!isDealt(position))
+         {
+            std::cerr << INDEX_NAME << ": position " << position.position << " could not have been dealt\n";
+            return true;
+         }
+         golden.push_back(position);
+      }
+
+      return golden.empty();
+   }
+
+   // Make the hands of every position in the corpus into cases, and check
+   // that every saved position still loads with the hands the index has for
+   // it. Returns true if one doesn't
+   bool loadCases(const std::string &directory, const std::vector<Golden> &golden, std::vector<Case> &cases)
+   {
+      for (const Golden &position : golden)
+      {
+         int i = position.position;
+         if (i % SAMPLE_EVERY == 0)
+         {
+            GameFile file;
+            if (file.loadFromFile(directory + "/" + sampleName(i)))
+            {
+               std::cerr << sampleName(i) << ": " << file.getError() << "\n";
+               return true;
+            }
+
+            Golden saved = goldenOf(file, i);
+            if (saved.round != position.round || saved.nextPlayer != position.nextPlayer || saved.top != position.top
+               || saved.ids[0] != position.ids[0] || saved.ids[1] != position.ids[1])
+            {
+               std::cerr << sampleName(i) << ": not the position " << INDEX_NAME << " has, generate the corpus again\n";
+               return true;
+            }
+         }
+
+         Hand hands[HANDS];
+         handsOf(position, hands);
+         for (int hand = 0; hand < HANDS; hand++)
+         {
+            cases.push_back(makeCase(hands[hand], position.round));
+            cases.back().optimal = position.optimal[hand];
+         }
+      }
+
+      return false;
+   }
+
+   // Score every case with an evaluator across threads, print how far it
+   // is from the optimum by round and how fast it went. Returns true if it
+   // left less than the optimum on any hand, or its mean gap is above
+   // allowed (if allowed isn't negative)
+   bool check(const Evaluator &evaluator, const std::vector<Case> &cases, unsigned threads, double allowed)
+   {
+      std::vector<int> scores(cases.size());
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      parallelFor(cases.size(), [&](size_t i)
+      {
+         scores[i] = evaluator.score(cases[i]);
+      }, threads);
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      // Hands, exact hands, gap, largest gap, and hands below the optimum,
+      // by round, with every round last
+      const int ROUNDS = LAST_ROUND + 1;
+      std::vector<long long> hands(ROUNDS, 0);
+      std::vector<long long> exact(ROUNDS, 0);
+      std::vector<long long> gap(ROUNDS, 0);
+      std::vector<int> largest(ROUNDS, 0);
+      std::vector<long long> below(ROUNDS, 0);
+      for (size_t i = 0; i < cases.size(); i++)
+      {
+         int difference = scores[i] - cases[i].optimal;
+         for (int round : { cases[i].round - 1, ROUNDS - 1 })
+         {
+            hands[round]++;
+            exact[round] += difference == 0;
+            gap[round] += difference;
+            largest[round] = std::max(largest[round], difference);
+            below[round] += difference < 0;
+         }
+      }
+
+      std::cout << "\n" << evaluator.name << ": " << std::fixed << std::setprecision(0) << cases.size() / seconds
+         << " hands/s, " << std::setprecision(2) << 1e6 * seconds / cases.size() << " us a hand on " << threads << (threads == 1 ? " thread\n" : " threads\n");
+      std::cout << std::setw(7) << "round" << std::setw(8) << "hands" << std::setw(9) << "exact %" << std::setw(10) << "mean gap"
+         << std::setw(9) << "max gap" << std::setw(7) << "below" << "\n";
+      for (int round = 0; round < ROUNDS; round++)
+      {
+         if (hands[round] == 0)
+         {
+            continue;
+         }
+
+         std::cout << std::setw(7) << (round == ROUNDS - 1 ? std::string("all") : std::to_string(round + 1)) << std::setw(8)
+            << hands[round] << std::setprecision(1) << std::setw(9) << 100.0 * exact[round] / hands[round]
+            << std::setprecision(2) << std::setw(10) << static_cast<double>(gap[round]) / hands[round] << std::setw(9)
+            << largest[round] << std::setw(7) << below[round] << "\n";
+      }
+
+      double meanGap = static_cast<double>(gap[ROUNDS - 1]) / std::max(hands[ROUNDS - 1], 1LL);
+      if (below[ROUNDS - 1] > 0)
+      {
+         std::cout << evaluator.name << " left less than the optimum on " << below[ROUNDS - 1] << " hands\n";
+      }
+      if (allowed >= 0 && meanGap > allowed)
+      {
+         std::cout << evaluator.name << "'s mean gap is above " << allowed << " points\n";
+      }
+
+      return below[ROUNDS - 1] > 0 || (allowed >= 0 && meanGap > allowed);
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   std::string directory = "../TEST_CASES/golden";
+   std::string evaluatorName = "all";
+   std::vector<std::string> words;
+   int positions = 2200;
+   unsigned seed = 1;
+   double allowed = -1;
+   unsigned threads = defaultThreadCount();
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if (argument == "-d" && i + 1 < argc)
+      {
+         directory = argv[++i];
+      }
+      else if (argument == "-e" && i + 1 < argc)
+      {
+         evaluatorName = argv[++i];
+      }
+      else if (argument == "-n" && i + 1 < argc)
+      {
+         positions = std::max(1, std::atoi(argv[++i]));
+      }
+      else if (argument == "-s" && i + 1 < argc)
+      {
+         seed = std::strtoul(argv[++i], nullptr, 10);
+      }
+      else if (argument == "-a" && i + 1 < argc)
+      {
+         allowed = std::atof(argv[++i]);
+      }
+      else if (argument == "-j" && i + 1 < argc)
+      {
+         threads = std::max(1, std::atoi(argv[++i]));
+      }
+      else
+      {
+         words.push_back(argument);
+      }
+   }
+
+   std::vector<const Evaluator *> evaluators;
+   for (const Evaluator &evaluator : EVALUATORS)
+   {
+      if (evaluatorName == "all" || evaluatorName == evaluator.name)
+      {
+         evaluators.push_back(&evaluator);
+      }
+   }
+
+   if (words.size() != 1 || (words[0] != "generate" && words[0] != "check") || evaluators.empty())
+   {
+      std::cerr << "Usage: " << argv[0] << " generate [-d dir] [-n positions] [-s seed] [-j threads]\n"
+         << "       " << argv[0] << " check [-d dir] [-e finder|books|runs|meld|deadwood|reference|all] [-a gap] [-j threads]\n";
+      return EXIT_FAILURE;
+   }
+
+   if (words[0] == "generate")
+   {
+      if (generate(directory, positions, seed, threads))
+      {
+         std::cerr << "Could not make the corpus in " << directory << "\n";
+         return EXIT_FAILURE;
+      }
+
+      std::cout << "Wrote " << positions << " positions to " << directory << "\n";
+      return EXIT_SUCCESS;
+   }
+
+   std::vector<Golden> golden;
+   std::vector<Case> cases;
+   if (readIndex(directory, golden) || loadCases(directory, golden, cases))
+   {
+      std::cerr << "Could not read the corpus in " << directory << "\n";
+      return EXIT_FAILURE;
+   }
+   std::cout << cases.size() << " hands in " << golden.size() << " positions\n";
+
+   bool failed = false;
+   for (const Evaluator *evaluator : evaluators)
+   {
+      failed = check(*evaluator, cases, threads, allowed) || failed;
+   }
+
+   return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
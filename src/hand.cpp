@@ -0,0 +1,348 @@
+#include "hand.h"
+
+/* *********************************************************************
+Function Name: Hand()
+Purpose: Constructor that adds every card passed in
+Parameters:
+         const vector<Card> &cards, the cards to add to the hand
+Return Value: The Hand object
+Local Variables:
+         none
+Algorithm:
+         1) Add each card to the hand
+Assistance Received: none
+********************************************************************* */
+Hand::Hand(const std::vector<Card> &cards)
+{
+   for (const Card &card : cards)
+   {
+      add(card);
+   }
+}
+
+/* *********************************************************************
+Function Name: add()
+Purpose: Add a card to the end of the hand
+Parameters:
+         const Card &card, the card to add
+Return Value: none
+Local Variables:
+         int id, the id of the card
+Algorithm:
+         1) Make sure the hand has room and the card is a real card
+            that we don't already hold both copies of
+         2) Remember where this copy of the id is stored
+         3) Store the card at the end of the hand
+Assistance Received: none
+********************************************************************* */
+void Hand::add(const Card &card)
+{
+   int id = card.getId();
+
+   if (this->numberOfCards >= MAX_CARDS)
+   {
+      throw std::out_of_range("hand is full");
+   }
+
+   if (id < 0 || this->counts[id] >= MAX_COPIES)
+   {
+      throw std::out_of_range("can't add " + card.toString() + " to the hand");
+   }
+
+   this->slots[id][this->counts[id]] = this->numberOfCards;
+   this->counts[id]++;
+
+   this->cards[this->numberOfCards] = card;
+   this->numberOfCards++;
+}
+
+/* *********************************************************************
+Function Name: removeAt()
+Purpose: Remove and return the card at index. The last card in the hand
+   takes its place
+Parameters:
+         int index, the index of the card to remove
+Return Value: a Card, the card removed
+Local Variables:
+         int id, the id of the card at index
+Algorithm:
+         1) Make sure the index is in the hand
+         2) Find which copy of the id is stored at index
+         3) Remove that copy
+Assistance Received: none
+********************************************************************* */
+Card Hand::removeAt(int index)
+{
+   if (index < 0 || index >= this->numberOfCards)
+   {
+      throw std::out_of_range("no card at index " + std::to_string(index));
+   }
+
+   int id = this->cards[index].getId();
+
+   int copy = (this->slots[id][0] == index) ? 0 : 1;
+
+   return removeCopy(id, copy);
+}
+
+/* *********************************************************************
+Function Name: removeById()
+Purpose: Remove and return a card with the given id
+Parameters:
+         int id, the id of the card to remove
+Return Value: a Card, the card removed
+Local Variables:
+         none
+Algorithm:
+         1) Make sure the card is in the hand
+         2) Remove the last copy of the id
+Assistance Received: none
+********************************************************************* */
+Card Hand::removeById(int id)
+{
+   if (!contains(id))
+   {
+      throw std::out_of_range("card is not in the hand");
+   }
+
+   return removeCopy(id, this->counts[id] - 1);
+}
+
+/* *********************************************************************
+Function Name: removeCopy()
+Purpose: Remove the card whose copy of id is stored at slots[id][copy]
+Parameters:
+         int id, the id of the card to remove
+         int copy, which copy of the id to remove
+Return Value: a Card, the card removed
+Local Variables:
+         int index, the index of the card being removed
+         int last, the index of the last card in the hand
+         Card removed, the card being removed
+         int movedId, the id of the last card
+Algorithm:
+         1) Swap the copy being removed with the last copy of the id
+            so the copies stay packed, and forget the last copy
+         2) Move the last card of the hand into the empty index and
+            update where its copy is stored
+         3) Return the removed card
+Assistance Received: none
+********************************************************************* */
+Card Hand::removeCopy(int id, int copy)
+{
+   int index = this->slots[id][copy];
+   int last = this->numberOfCards - 1;
+   Card removed = this->cards[index];
+
+   // Keep the remaining copies of the id at the front of slots
+   this->counts[id]--;
+   this->slots[id][copy] = this->slots[id][this->counts[id]];
+
+   // Fill the hole with the last card
+   if (index != last)
+   {
+      this->cards[index] = this->cards[last];
+
+      int movedId = this->cards[index].getId();
+      for (int i = 0; i < this->counts[movedId]; i++)
+      {
+         if (this->slots[movedId][i] == last)
+         {
+            this->slots[movedId][i] = index;
+            break;
+         }
+      }
+   }
+
+   this->numberOfCards--;
+
+   return removed;
+}
+
+/* *********************************************************************
+Function Name: indexOf()
+Purpose: Get the index of a card with the given id
+Parameters:
+         int id, the id of the card
+Return Value: an int, the index of the card, -1 if it's not in the hand
+Local Variables:
+         none
+Algorithm:
+         1) If the hand holds the id, return where its last copy is
+         2) Otherwise return -1
+Assistance Received: none
+********************************************************************* */
+int Hand::indexOf(int id) const
+{
+   if (!contains(id))
+   {
+      return -1;
+   }
+
+   return this->slots[id][this->counts[id] - 1];
+}
+
+/* *********************************************************************
+Function Name: contains()
+Purpose: Check if a card with the given id is in the hand
+Parameters:
+         int id, the id of the card
+Return Value: a bool, whether or not the card is in the hand
+Local Variables:
+         none
+Algorithm:
+         1) Return whether the count of the id is above 0
+Assistance Received: none
+********************************************************************* */
+bool Hand::contains(int id) const
+{
+   return count(id) > 0;
+}
+
+/* *********************************************************************
+Function Name: count()
+Purpose: Get the number of cards with the given id in the hand
+Parameters:
+         int id, the id of the card
+Return Value: an int, the number of copies of the card in the hand
+Local Variables:
+         none
+Algorithm:
+         1) If the id isn't a card, return 0
+         2) Return the count of the id
+Assistance Received: none
+********************************************************************* */
+int Hand::count(int id) const
+{
+   if (id < 0 || id >= Card::NUMBER_OF_IDS)
+   {
+      return 0;
+   }
+
+   return this->counts[id];
+}
+
+/* *********************************************************************
+Function Name: clear()
+Purpose: Remove every card from the hand
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Reset the count of each card in the hand
+         2) Set the number of cards to 0
+Assistance Received: none
+********************************************************************* */
+void Hand::clear()
+{
+   for (int i = 0; i < this->numberOfCards; i++)
+   {
+      this->counts[this->cards[i].getId()] = 0;
+   }
+
+   this->numberOfCards = 0;
+}
+
+/* *********************************************************************
+Function Name: size()
+Purpose: Get the number of cards in the hand
+Parameters:
+         none
+Return Value: a const int, the number of cards
+Local Variables:
+         none
+Algorithm:
+         1) Return the number of cards
+Assistance Received: none
+********************************************************************* */
+int Hand::size() const
+{
+   return this->numberOfCards;
+}
+
+/* *********************************************************************
+Function Name: empty()
+Purpose: Check if the hand has no cards
+Parameters:
+         none
+Return Value: a const bool, whether or not the hand is empty
+Local Variables:
+         none
+Algorithm:
+         1) Return whether the number of cards is 0
+Assistance Received: none
+********************************************************************* */
+bool Hand::empty() const
+{
+   return this->numberOfCards == 0;
+}
+
+/* *********************************************************************
+Function Name: operator []()
+Purpose: Get the card at index
+Parameters:
+         int index, the index of the card
+Return Value: a const reference to the Card at index
+Local Variables:
+         none
+Algorithm:
+         1) Return the card at index
+Assistance Received: none
+********************************************************************* */
+const Card& Hand::operator[](int index) const
+{
+   return this->cards[index];
+}
+
+/* *********************************************************************
+Function Name: begin()
+Purpose: Get a pointer to the first card so the hand can be iterated
+Parameters:
+         none
+Return Value: a const Card pointer, the first card
+Local Variables:
+         none
+Algorithm:
+         1) Return the start of the cards
+Assistance Received: none
+********************************************************************* */
+const Card* Hand::begin() const
+{
+   return this->cards;
+}
+
+/* *********************************************************************
+Function Name: end()
+Purpose: Get a pointer past the last card so the hand can be iterated
+Parameters:
+         none
+Return Value: a const Card pointer, one past the last card
+Local Variables:
+         none
+Algorithm:
+         1) Return the start of the cards plus the number of cards
+Assistance Received: none
+********************************************************************* */
+const Card* Hand::end() const
+{
+   return this->cards + this->numberOfCards;
+}
+
+/* *********************************************************************
+Function Name: toVector()
+Purpose: Copy the cards into a vector
+Parameters:
+         none
+Return Value: a vector<Card>, the cards in the hand
+Local Variables:
+         none
+Algorithm:
+         1) Construct a vector from the first card to the last
+Assistance Received: none
+********************************************************************* */
+std::vector<Card> Hand::toVector() const
+{
+   return std::vector<Card>(begin(), end());
+}
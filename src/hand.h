@@ -0,0 +1,82 @@
+#ifndef HAND_H
+#define HAND_H
+
+#include "card.h"
+#include <vector>
+#include <stdexcept>   // std::out_of_range
+
+// The cards in a player's hand, stored inline with room for the largest hand
+// (13 cards dealt plus the card drawn). Alongside the cards it keeps how many
+// of each card id are held and where they are, so checking for a card and
+// removing a card by id or index never searches the hand.
+class Hand
+{
+   public:
+      Hand() = default;
+      ~Hand() = default;
+
+      // Constructor that adds every card passed in
+      Hand(const std::vector<Card> &cards);
+
+      // Most cards a hand can hold
+      static const int MAX_CARDS = 14;
+
+      // Add a card to the end of the hand
+      void add(const Card &card);
+
+      // Remove and return the card at index
+      // The last card in the hand takes its place
+      Card removeAt(int index);
+
+      // Remove and return a card with the given id
+      Card removeById(int id);
+
+      // Get the index of a card with the given id, -1 if it's not in the hand
+      int indexOf(int id) const;
+
+      // Check if a card with the given id is in the hand
+      bool contains(int id) const;
+
+      // Get the number of cards with the given id in the hand
+      int count(int id) const;
+
+      // Remove every card from the hand
+      void clear();
+
+      // Get the number of cards in the hand
+      int size() const;
+
+      // Check if the hand has no cards
+      bool empty() const;
+
+      // Get the card at index
+      const Card& operator[](int index) const;
+
+      // Iterate over the cards in the hand
+      const Card* begin() const;
+      const Card* end() const;
+
+      // Copy the cards into a vector
+      std::vector<Card> toVector() const;
+
+   private:
+      // Copies of the same card a hand can hold (there are two decks)
+      static const int MAX_COPIES = 2;
+
+      // The cards in the hand
+      Card cards[MAX_CARDS];
+
+      // The number of cards in the hand
+      int numberOfCards = 0;
+
+      // The number of cards of each id in the hand
+      unsigned char counts[Card::NUMBER_OF_IDS] = { 0 };
+
+      // The index in cards of each copy of each id
+      signed char slots[Card::NUMBER_OF_IDS][MAX_COPIES] = { { 0 } };
+
+      // Remove the card whose copy of id is stored at slots[id][copy]
+      Card removeCopy(int id, int copy);
+};
+
+#endif
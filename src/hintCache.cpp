@@ -0,0 +1,172 @@
+#include "hintCache.h"
+
+/* *********************************************************************
+Function Name: ~HintCache()
+Purpose: Stop the worker before the hints go away
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Stop the worker
+Assistance Received: none
+********************************************************************* */
+HintCache::~HintCache()
+{
+   stop();
+}
+
+/* *********************************************************************
+Function Name: start()
+Purpose: Start working out the help for the start of a turn
+Parameters:
+         const Hand &hand, the Human's hand
+         const Card &discardCard, the card on top of the discard pile
+         const Card &deckCard, the card on top of the deck
+Return Value: none
+Local Variables:
+         Hand drawn, the hand after drawing a card
+Algorithm:
+         1) Stop any earlier work and forget its hints
+         2) Queue the draw help, then the discard help after drawing the
+            discard card, then after drawing the top of the deck
+         3) Start the worker
+Assistance Received: none
+********************************************************************* */
+void HintCache::start(const Hand &hand, const Card &discardCard, const Card &deckCard)
+{
+   stop();
+
+   this->jobs.clear();
+   this->entries.clear();
+
+   this->jobs.push_back({ hand, discardCard, Computer::Help::DRAW_HELP });
+
+   for (const Card &card : { discardCard, deckCard })
+   {
+      if (card.getId() != -1 && hand.size() < Hand::MAX_CARDS && hand.count(card.getId()) < 2)
+      {
+         Hand drawn = hand;
+         drawn.add(card);
+         this->jobs.push_back({ drawn, discardCard, Computer::Help::DISCARD_HELP });
+      }
+   }
+
+   this->stopping = false;
+   this->worker = std::thread(&HintCache::work, this);
+}
+
+/* *********************************************************************
+Function Name: stop()
+Purpose: Stop working out hints and wait for the worker
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Tell the worker to stop, it checks between hints
+         2) Wait for it to finish
+Assistance Received: none
+********************************************************************* */
+void HintCache::stop()
+{
+   this->stopping = true;
+   if (this->worker.joinable())
+   {
+      this->worker.join();
+   }
+}
+
+/* *********************************************************************
+Function Name: find()
+Purpose: Get a hint worked out ahead of time
+Parameters:
+         const Hand &hand, the Human's hand now
+         const Card &discardCard, the card on top of the discard pile now
+         Computer::Help helpType, the help asked for
+         Computer::Hint &hint, set to the hint if it was found
+Return Value: a bool, true if the hint was worked out for this hand (and
+   discard card, for draw help)
+Local Variables:
+         vector<int> ids, the ids of the hand's cards
+Algorithm:
+         1) Look for an entry of the same type for the same hand
+         2) Draw help also needs the same discard card
+Assistance Received: none
+********************************************************************* */
+bool HintCache::find(const Hand &hand, const Card &discardCard, Computer::Help helpType, Computer::Hint &hint) const
+{
+   std::vector<int> ids = handIds(hand);
+
+   std::lock_guard<std::mutex> lock(this->mutex);
+   for (const Entry &entry : this->entries)
+   {
+      if (entry.hint.type == helpType && entry.hand == ids
+         && (helpType != Computer::Help::DRAW_HELP || entry.discardCard == discardCard.getId()))
+      {
+         hint = entry.hint;
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: work()
+Purpose: Work out each queued hint
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         Entry entry, the hint and what it's for
+Algorithm:
+         1) Until told to stop, work out each hint the way
+            Computer::help() does
+         2) Store it with its hand and discard card
+Assistance Received: none
+********************************************************************* */
+void HintCache::work()
+{
+   for (const Job &job : this->jobs)
+   {
+      if (this->stopping)
+      {
+         return;
+      }
+
+      Entry entry;
+      entry.hand = handIds(job.hand);
+      entry.discardCard = job.discardCard.getId();
+      entry.hint = Computer::findHint(job.hand, job.discardCard, job.helpType);
+
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->entries.push_back(entry);
+   }
+}
+
+/* *********************************************************************
+Function Name: handIds()
+Purpose: Get the ids of the cards in a hand
+Parameters:
+         const Hand &hand, the hand
+Return Value: a vector<int>, the ids in the hand's order
+Local Variables:
+         vector<int> ids, the ids
+Algorithm:
+         1) Copy the id of each card
+Assistance Received: none
+********************************************************************* */
+std::vector<int> HintCache::handIds(const Hand &hand)
+{
+   std::vector<int> ids;
+   ids.reserve(hand.size());
+   for (const Card &card : hand)
+   {
+      ids.push_back(card.getId());
+   }
+
+   return ids;
+}
@@ -0,0 +1,70 @@
+#ifndef HINTCACHE_H
+#define HINTCACHE_H
+
+#include "computer.h"
+#include <atomic>      // std::atomic
+#include <mutex>       // std::mutex
+#include <thread>      // std::thread
+#include <vector>
+
+// Works out the Human's draw and discard help on a worker thread as soon as
+// their turn starts, so asking for help is answered right away. Each hint is
+// kept with the hand and discard card it was worked out for and only
+// returned for the same ones, so a hint for a state that changed is never used.
+class HintCache
+{
+   public:
+      HintCache() = default;
+
+      // Stops the worker
+      ~HintCache();
+
+      HintCache(const HintCache &) = delete;
+      HintCache& operator=(const HintCache &) = delete;
+
+      // Start working out the help for the start of a turn: which pile to
+      // draw from, then which card to discard after drawing the discard card
+      // or the top of the deck (blank when a pile is empty). Stops any
+      // earlier work and forgets its hints
+      void start(const Hand &hand, const Card &discardCard, const Card &deckCard);
+
+      // Stop working out hints and wait for the worker
+      void stop();
+
+      // Get the hint for the hand and discard card if it was worked out
+      bool find(const Hand &hand, const Card &discardCard, Computer::Help helpType, Computer::Hint &hint) const;
+
+   private:
+      // A hint and the hand and discard card it's for
+      struct Entry
+      {
+         std::vector<int> hand;
+         int discardCard;
+         Computer::Hint hint;
+      };
+
+      // A hint to work out
+      struct Job
+      {
+         Hand hand;
+         Card discardCard;
+         Computer::Help helpType;
+      };
+
+      // Work out the hints in order until done or told to stop
+      void work();
+
+      // Ids of the cards in a hand, in order
+      static std::vector<int> handIds(const Hand &hand);
+
+      std::thread worker;
+      std::atomic<bool> stopping{ false };
+
+      // Guards entries while the worker fills them
+      mutable std::mutex mutex;
+
+      std::vector<Job> jobs;
+      std::vector<Entry> entries;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define HUMAN_H
 
 #include "player.h"
+#include <limits>     // std::numeric_limits
 
 class Human : public Player
 {
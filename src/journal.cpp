@@ -0,0 +1,276 @@
+#include "journal.h"
+
+const char Journal::MAGIC[3] = { 'F', 'C', 'J' };
+
+/* *********************************************************************
+Function Name: ~Journal()
+Purpose: Write anything still buffered when the journal is destroyed
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Flush the buffer
+Assistance Received: none
+********************************************************************* */
+Journal::~Journal()
+{
+   flush();
+}
+
+/* *********************************************************************
+Function Name: open()
+Purpose: Start a new journal in the file
+Parameters:
+         const string &fileName, the file to write the journal to
+Return Value: a bool, true if the file could not be opened
+Local Variables:
+         none
+Algorithm:
+         1) Write out and close any journal already open
+         2) Open the file, replacing what was in it
+         3) Write the magic and version
+Assistance Received: none
+********************************************************************* */
+bool Journal::open(const std::string &fileName)
+{
+   if (this->file.is_open())
+   {
+      flush();
+      this->file.close();
+   }
+
+   this->buffer.clear();
+   this->file.open(fileName, std::ios::binary | std::ios::trunc);
+   if (!this->file)
+   {
+      return true;
+   }
+
+   this->buffer.append(MAGIC, sizeof(MAGIC));
+   this->buffer += static_cast<char>(VERSION);
+   flush();
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: isOpen()
+Purpose: Check if a journal is being written
+Parameters:
+         none
+Return Value: a bool, true if a journal file is open
+Local Variables:
+         none
+Algorithm:
+         1) Return if the file is open
+Assistance Received: none
+********************************************************************* */
+bool Journal::isOpen() const
+{
+   return this->file.is_open();
+}
+
+/* *********************************************************************
+Function Name: recordSeed()
+Purpose: Record the seed of the game
+Parameters:
+         unsigned seed, the seed the decks are shuffled with
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add a seed record with the 4 bytes of the seed
+Assistance Received: none
+********************************************************************* */
+void Journal::recordSeed(unsigned seed)
+{
+   addRecord(Record::SEED);
+   for (int i = 0; i < 4; i++)
+   {
+      this->buffer += static_cast<char>((seed >> (8 * i)) & 0xFF);
+   }
+   flushIfFull();
+}
+
+/* *********************************************************************
+Function Name: recordState()
+Purpose: Record the whole game state, used after each deal and when a
+   game is loaded
+Parameters:
+         string_view snapshot, the GameFile snapshot of the game
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add a state record with the length of the snapshot
+         2) Add the snapshot
+Assistance Received: none
+********************************************************************* */
+void Journal::recordState(std::string_view snapshot)
+{
+   addRecord(Record::STATE);
+   this->buffer += static_cast<char>(snapshot.size() & 0xFF);
+   this->buffer += static_cast<char>((snapshot.size() >> 8) & 0xFF);
+   this->buffer.append(snapshot.data(), snapshot.size());
+   flushIfFull();
+}
+
+/* *********************************************************************
+Function Name: recordDrawDeck()
+Purpose: Record the player to move drawing from the deck
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add a draw deck record
+Assistance Received: none
+********************************************************************* */
+void Journal::recordDrawDeck()
+{
+   addRecord(Record::DRAW_DECK);
+   flushIfFull();
+}
+
+/* *********************************************************************
+Function Name: recordDrawDiscard()
+Purpose: Record the player to move drawing from the discard pile
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add a draw discard record
+Assistance Received: none
+********************************************************************* */
+void Journal::recordDrawDiscard()
+{
+   addRecord(Record::DRAW_DISCARD);
+   flushIfFull();
+}
+
+/* *********************************************************************
+Function Name: recordDiscard()
+Purpose: Record the player to move discarding a card, ending their turn
+Parameters:
+         int id, the id of the card discarded
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add a discard record with the card id
+Assistance Received: none
+********************************************************************* */
+void Journal::recordDiscard(int id)
+{
+   addRecord(Record::DISCARD);
+   this->buffer += static_cast<char>(id);
+   flushIfFull();
+}
+
+/* *********************************************************************
+Function Name: recordRoundEnd()
+Purpose: Record the scores at the end of a round
+Parameters:
+         int computerScore, the computer's score after the round
+         int humanScore, the human's score after the round
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add a round end record with both scores
+         2) Write the batch so a finished round is never lost
+Assistance Received: none
+********************************************************************* */
+void Journal::recordRoundEnd(int computerScore, int humanScore)
+{
+   addRecord(Record::ROUND_END);
+   this->buffer += static_cast<char>(computerScore & 0xFF);
+   this->buffer += static_cast<char>((computerScore >> 8) & 0xFF);
+   this->buffer += static_cast<char>(humanScore & 0xFF);
+   this->buffer += static_cast<char>((humanScore >> 8) & 0xFF);
+   flush();
+}
+
+/* *********************************************************************
+Function Name: flush()
+Purpose: Write everything buffered to the file
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) If a file is open, write the buffer with a single write and
+            flush the file (records made without a file are dropped)
+         2) Clear the buffer
+Assistance Received: none
+********************************************************************* */
+void Journal::flush()
+{
+   if (!this->buffer.empty() && this->file.is_open())
+   {
+      this->file.write(this->buffer.data(), this->buffer.size());
+      this->file.flush();
+   }
+
+   this->buffer.clear();
+}
+
+/* *********************************************************************
+Function Name: isJournal()
+Purpose: Check if data is a journal
+Parameters:
+         string_view data, the contents of a file
+Return Value: a bool, true if data starts with the journal magic
+Local Variables:
+         none
+Algorithm:
+         1) Compare the start of data with the magic
+Assistance Received: none
+********************************************************************* */
+bool Journal::isJournal(std::string_view data)
+{
+   return data.size() >= HEADER_SIZE && data.compare(0, sizeof(MAGIC), std::string_view(MAGIC, sizeof(MAGIC))) == 0;
+}
+
+/* *********************************************************************
+Function Name: addRecord()
+Purpose: Add the type byte of a record to the buffer
+Parameters:
+         Record type, the type of record
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add the type as a byte
+Assistance Received: none
+********************************************************************* */
+void Journal::addRecord(Record type)
+{
+   this->buffer += static_cast<char>(type);
+}
+
+/* *********************************************************************
+Function Name: flushIfFull()
+Purpose: Write the batch of records once enough are buffered
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) If the buffer has reached the flush size, flush it
+Assistance Received: none
+********************************************************************* */
+void Journal::flushIfFull()
+{
+   if (this->buffer.size() >= FLUSH_SIZE)
+   {
+      flush();
+   }
+}
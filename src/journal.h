@@ -0,0 +1,85 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include <string_view>
+#include <fstream>
+
+// Append-only record of a game. Every round starts with a snapshot of the
+// state after the deal (see GameFile), followed by each draw and discard as
+// one or two bytes, so a game can be recovered after a crash or replayed with
+// JournalReader. Records are buffered and written in batches.
+//
+// File format: the magic "FCJ" and a version byte, then records that each
+// start with a type byte. Numbers are little endian.
+//   SEED         4 byte seed of the game
+//   STATE        2 byte length then a GameFile snapshot (the player to move is its next player)
+//   DRAW_DECK    none
+//   DRAW_DISCARD none
+//   DISCARD      1 byte card id
+//   ROUND_END    2 byte computer score then 2 byte human score
+class Journal
+{
+   public:
+      Journal() = default;
+
+      // Write anything still buffered
+      ~Journal();
+
+      enum class Record {
+         UNDEFINED = 0,
+         SEED,
+         STATE,
+         DRAW_DECK,
+         DRAW_DISCARD,
+         DISCARD,
+         ROUND_END
+      };
+
+      static const char MAGIC[3];
+      static const unsigned char VERSION = 1;
+      static const int HEADER_SIZE = 4;
+
+      // Start a new journal in the file, returns true if it could not be opened
+      bool open(const std::string &fileName);
+
+      // Check if a journal is being written
+      bool isOpen() const;
+
+      // Record the seed of the game
+      void recordSeed(unsigned seed);
+
+      // Record the whole game state (a GameFile snapshot)
+      void recordState(std::string_view snapshot);
+
+      // Record the player to move drawing from the deck or discard pile
+      void recordDrawDeck();
+      void recordDrawDiscard();
+
+      // Record the player to move discarding the card with the id, ending their turn
+      void recordDiscard(int id);
+
+      // Record the scores at the end of a round, then write the batch
+      void recordRoundEnd(int computerScore, int humanScore);
+
+      // Write everything buffered to the file
+      void flush();
+
+      // Check if data starts with the journal magic
+      static bool isJournal(std::string_view data);
+
+   private:
+      // Records are written once this many bytes are buffered
+      static const int FLUSH_SIZE = 64;
+
+      std::ofstream file;
+      std::string buffer;
+
+      // Add a type byte to the buffer
+      void addRecord(Record type);
+
+      // Write the batch if it's big enough
+      void flushIfFull();
+};
+
+#endif
@@ -0,0 +1,491 @@
+#include "journalReader.h"
+#include <algorithm>   // std::count, std::find
+
+namespace
+{
+   // Copies of the same card a hand can hold (there are two decks)
+   const long MAX_COPIES = 2;
+}
+
+/* *********************************************************************
+Function Name: load()
+Purpose: Start reading a journal
+Parameters:
+         string_view journal, the contents of the journal
+Return Value: a bool, true if it is not a journal
+Local Variables:
+         none
+Algorithm:
+         1) Check the magic and version
+         2) Clear the state and start after the header
+Assistance Received: none
+********************************************************************* */
+bool JournalReader::load(std::string_view journal)
+{
+   *this = JournalReader();
+
+   if (!Journal::isJournal(journal))
+   {
+      return setError("not a journal");
+   }
+
+   if (static_cast<unsigned char>(journal[3]) != Journal::VERSION)
+   {
+      return setError("unsupported journal version " + std::to_string(static_cast<unsigned char>(journal[3])));
+   }
+
+   this->journal = journal;
+   this->position = Journal::HEADER_SIZE;
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: readRecord()
+Purpose: Decode the next record of the journal without applying it
+Parameters:
+         Journal::Record &type, set to the type of the record
+         string_view &payload, set to the bytes after the type
+Return Value: a bool, true if the record is cut off or unknown
+Local Variables:
+         size_t size, the number of bytes after the type
+Algorithm:
+         1) Read the type of the record
+         2) Find the size of its payload from its type (state records
+            store their size)
+         3) Make sure the whole record is in the journal
+         4) Move past the record
+Assistance Received: none
+********************************************************************* */
+bool JournalReader::readRecord(Journal::Record &type, std::string_view &payload)
+{
+   if (atEnd())
+   {
+      return setError("no record left");
+   }
+
+   type = static_cast<Journal::Record>(this->journal[this->position]);
+   size_t size = 0;
+
+   switch (type)
+   {
+      case Journal::Record::SEED:
+         size = 4;
+         break;
+
+      case Journal::Record::STATE:
+         if (this->position + 3 > this->journal.size())
+         {
+            return setError("state record is cut off");
+         }
+         size = 2 + readNumber(this->journal, this->position + 1, 2);
+         break;
+
+      case Journal::Record::DRAW_DECK:
+      case Journal::Record::DRAW_DISCARD:
+         size = 0;
+         break;
+
+      case Journal::Record::DISCARD:
+         size = 1;
+         break;
+
+      case Journal::Record::ROUND_END:
+         size = 4;
+         break;
+
+      default:
+         return setError("unknown record " + std::to_string(static_cast<int>(type)));
+   }
+
+   if (this->position + 1 + size > this->journal.size())
+   {
+      return setError("record is cut off");
+   }
+
+   payload = this->journal.substr(this->position + 1, size);
+   this->position += 1 + size;
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: replay()
+Purpose: Apply the records of the journal to the state
+Parameters:
+         long long maxActions, the most draws and discards to apply,
+            -1 for no limit
+Return Value: a bool, true if a record is not valid
+Local Variables:
+         long long applied, the draws and discards applied by this call
+         Journal::Record type, the type of the current record
+         string_view payload, the bytes of the current record
+         vector<unsigned char> &hand, the hand of the player to move
+Algorithm:
+         1) Read the next record
+         2) Seed and state records replace the seed and state
+         3) Draw records move the top of a pile to the end of the hand
+            of the player to move, unless it already holds both copies
+         4) Discard records move the card from the hand to the top of
+            the discard pile, the last card in the hand taking its place
+            (like Hand::removeAt()), and end the turn
+         5) Round end records set the scores
+         6) Stop at the end of the journal or after maxActions draws and
+            discards
+Assistance Received: none
+********************************************************************* */
+bool JournalReader::replay(long long maxActions)
+{
+   long long applied = 0;
+
+   while (!atEnd() && (maxActions < 0 || applied < maxActions))
+   {
+      Journal::Record type;
+      std::string_view payload;
+      if (readRecord(type, payload))
+      {
+         return true;
+      }
+
+      std::vector<unsigned char> &hand = this->hands[this->playerToMove];
+
+      switch (type)
+      {
+         case Journal::Record::SEED:
+            this->seed = readNumber(payload, 0, 4);
+            break;
+
+         case Journal::Record::STATE:
+            if (loadState(payload.substr(2)))
+            {
+               return true;
+            }
+            break;
+
+         case Journal::Record::DRAW_DECK:
+            if (this->drawPile.empty() || hand.size() >= Hand::MAX_CARDS)
+            {
+               return setError("draw from an empty deck or into a full hand");
+            }
+            if (std::count(hand.begin(), hand.end(), this->drawPile.back()) >= MAX_COPIES)
+            {
+               return setError("draw of a third " + Card::fromId(this->drawPile.back(), this->round).toString() + " into the hand");
+            }
+            hand.push_back(this->drawPile.back());
+            this->drawPile.pop_back();
+            this->actionCount++;
+            applied++;
+            break;
+
+         case Journal::Record::DRAW_DISCARD:
+            if (this->discardPile.empty() || hand.size() >= Hand::MAX_CARDS)
+            {
+               return setError("draw from an empty discard pile or into a full hand");
+            }
+            if (std::count(hand.begin(), hand.end(), this->discardPile.back()) >= MAX_COPIES)
+            {
+               return setError("draw of a third " + Card::fromId(this->discardPile.back(), this->round).toString() + " into the hand");
+            }
+            hand.push_back(this->discardPile.back());
+            this->discardPile.pop_back();
+            this->actionCount++;
+            applied++;
+            break;
+
+         case Journal::Record::DISCARD:
+         {
+            unsigned char id = payload[0];
+            std::vector<unsigned char>::iterator card = std::find(hand.begin(), hand.end(), id);
+            if (card == hand.end())
+            {
+               return setError("discard of a card not in the hand");
+            }
+
+            *card = hand.back();
+            hand.pop_back();
+            this->discardPile.push_back(id);
+            this->playerToMove = 1 - this->playerToMove;
+            this->actionCount++;
+            applied++;
+            break;
+         }
+
+         case Journal::Record::ROUND_END:
+            this->scores[0] = readNumber(payload, 0, 2);
+            this->scores[1] = readNumber(payload, 2, 2);
+            break;
+
+         default:
+            break;
+      }
+   }
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: atEnd()
+Purpose: Check if every record was replayed
+Parameters:
+         none
+Return Value: a bool, true if there are no records left
+Local Variables:
+         none
+Algorithm:
+         1) Compare the position with the size of the journal
+Assistance Received: none
+********************************************************************* */
+bool JournalReader::atEnd() const
+{
+   return this->position >= this->journal.size();
+}
+
+/* *********************************************************************
+Function Name: getActionCount()
+Purpose: Get the number of draws and discards applied so far
+Parameters:
+         none
+Return Value: a long long, the number of actions
+Local Variables:
+         none
+Algorithm:
+         1) Return the action count
+Assistance Received: none
+********************************************************************* */
+long long JournalReader::getActionCount() const
+{
+   return this->actionCount;
+}
+
+/* *********************************************************************
+Function Name: getSeed()
+Purpose: Get the seed of the game
+Parameters:
+         none
+Return Value: an unsigned, the seed, 0 if it wasn't recorded
+Local Variables:
+         none
+Algorithm:
+         1) Return the seed
+Assistance Received: none
+********************************************************************* */
+unsigned JournalReader::getSeed() const
+{
+   return this->seed;
+}
+
+/* *********************************************************************
+Function Name: getRound()
+Purpose: Get the current round
+Parameters:
+         none
+Return Value: an int, the round
+Local Variables:
+         none
+Algorithm:
+         1) Return the round
+Assistance Received: none
+********************************************************************* */
+int JournalReader::getRound() const
+{
+   return this->round;
+}
+
+/* *********************************************************************
+Function Name: getScore()
+Purpose: Get a player's score
+Parameters:
+         int player, 0 for Computer, 1 for Human
+Return Value: an int, the player's score
+Local Variables:
+         none
+Algorithm:
+         1) Return the player's score
+Assistance Received: none
+********************************************************************* */
+int JournalReader::getScore(int player) const
+{
+   return this->scores[player];
+}
+
+/* *********************************************************************
+Function Name: getPlayerToMove()
+Purpose: Get the player whose turn it is
+Parameters:
+         none
+Return Value: an int, 0 for Computer, 1 for Human
+Local Variables:
+         none
+Algorithm:
+         1) Return the player to move
+Assistance Received: none
+********************************************************************* */
+int JournalReader::getPlayerToMove() const
+{
+   return this->playerToMove;
+}
+
+/* *********************************************************************
+Function Name: getError()
+Purpose: Get why replaying failed
+Parameters:
+         none
+Return Value: a string, the error and where in the journal it is
+Local Variables:
+         none
+Algorithm:
+         1) Return the error
+Assistance Received: none
+********************************************************************* */
+std::string JournalReader::getError() const
+{
+   return this->error;
+}
+
+/* *********************************************************************
+Function Name: toGameFile()
+Purpose: Set the game file to the current state so it can be loaded
+   into a Game
+Parameters:
+         GameFile &gameFile, the game file to set
+Return Value: a bool, true if there is no state or a hand can't hold its
+   cards (see getError())
+Local Variables:
+         Hand playerHands[], the hands as cards
+         vector<Card> draw, the draw pile as cards, top first
+         deque<Card> discard, the discard pile as cards, top first
+Algorithm:
+         1) Make sure a state was loaded
+         2) Create the cards of each hand in order, making sure each
+            fits and holds no card more than twice
+         3) Create the cards of each pile from the top down
+         4) Set the game file's state
+Assistance Received: none
+********************************************************************* */
+bool JournalReader::toGameFile(GameFile &gameFile)
+{
+   if (this->round == 0)
+   {
+      return setError("no state record before the end of the journal");
+   }
+
+   Hand playerHands[2];
+   for (int player = 0; player < 2; player++)
+   {
+      if (this->hands[player].size() > Hand::MAX_CARDS)
+      {
+         return setError("a hand has more than " + std::to_string(Hand::MAX_CARDS) + " cards");
+      }
+
+      for (unsigned char id : this->hands[player])
+      {
+         if (std::count(this->hands[player].begin(), this->hands[player].end(), id) > MAX_COPIES)
+         {
+            return setError("a hand has " + Card::fromId(id, this->round).toString() + " more than twice");
+         }
+         playerHands[player].add(Card::fromId(id, this->round));
+      }
+   }
+
+   std::vector<Card> draw;
+   draw.reserve(this->drawPile.size());
+   for (std::vector<unsigned char>::const_reverse_iterator id = this->drawPile.rbegin(); id != this->drawPile.rend(); ++id)
+   {
+      draw.push_back(Card::fromId(*id, this->round));
+   }
+
+   std::deque<Card> discard;
+   for (std::vector<unsigned char>::const_reverse_iterator id = this->discardPile.rbegin(); id != this->discardPile.rend(); ++id)
+   {
+      discard.push_back(Card::fromId(*id, this->round));
+   }
+
+   gameFile.setGameState(this->round, this->scores[0], this->scores[1], this->playerToMove, playerHands[0], playerHands[1], draw, discard);
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: loadState()
+Purpose: Set the state to a GameFile snapshot
+Parameters:
+         string_view snapshot, the bytes of the snapshot
+Return Value: a bool, true if it is not a valid snapshot
+Local Variables:
+         GameFile file, parses and checks the snapshot
+         GameState state, the snapshot's card ids
+Algorithm:
+         1) Parse the snapshot as a game file would, which checks its
+            round, player to move, and that no hand or pile holds more
+            cards, or copies of a card, than a game can
+         2) Copy the round, scores, and player to move
+         3) Copy the ids of each hand, and of each pile with the top last
+Assistance Received: none
+********************************************************************* */
+bool JournalReader::loadState(std::string_view snapshot)
+{
+   GameFile file;
+   GameState state;
+   if (file.parseSnapshot(snapshot) || file.toGameState(state))
+   {
+      return setError("state record: " + file.getErrorMessage());
+   }
+
+   this->round = state.round;
+   this->playerToMove = state.playerToMove;
+   this->scores[0] = state.scores[0];
+   this->scores[1] = state.scores[1];
+
+   for (int player = 0; player < 2; player++)
+   {
+      this->hands[player].assign(state.hands[player], state.hands[player] + state.handSizes[player]);
+   }
+   this->drawPile.assign(state.drawPile, state.drawPile + state.drawSize);
+   this->discardPile.assign(state.discardPile, state.discardPile + state.discardSize);
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: readNumber()
+Purpose: Read a little endian number from journal bytes
+Parameters:
+         string_view bytes, the bytes to read from
+         size_t offset, where the number starts
+         int count, the number of bytes in the number
+Return Value: an unsigned, the number
+Local Variables:
+         unsigned number, the number being read
+Algorithm:
+         1) Add each byte, lowest first
+Assistance Received: none
+********************************************************************* */
+unsigned JournalReader::readNumber(std::string_view bytes, size_t offset, int count)
+{
+   unsigned number = 0;
+   for (int i = 0; i < count; i++)
+   {
+      number |= static_cast<unsigned>(static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+   }
+
+   return number;
+}
+
+/* *********************************************************************
+Function Name: setError()
+Purpose: Record why replaying failed
+Parameters:
+         const string &message, what went wrong
+Return Value: a bool, always true so callers can return it
+Local Variables:
+         none
+Algorithm:
+         1) Store the message with the byte of the journal it's at
+Assistance Received: none
+********************************************************************* */
+bool JournalReader::setError(const std::string &message)
+{
+   this->error = "journal byte " + std::to_string(this->position) + ": " + message;
+
+   return true;
+}
@@ -0,0 +1,84 @@
+#ifndef JOURNALREADER_H
+#define JOURNALREADER_H
+
+#include "journal.h"
+#include "gameFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Rebuilds the state of a game by replaying its journal (see Journal).
+// The state is kept as card ids with the top of each pile at the back so
+// every record is applied without creating any cards; toGameFile() turns it
+// into cards once replaying stops.
+class JournalReader
+{
+   public:
+      JournalReader() = default;
+      ~JournalReader() = default;
+
+      // Start reading a journal, returns true if it is not a journal
+      // The data is not copied and must outlive the reader
+      bool load(std::string_view journal);
+
+      // Replay records until the end of the journal or until maxActions more draws and
+      // discards were applied (-1 for no limit)
+      // Returns true if a record is not valid (see getError())
+      bool replay(long long maxActions = -1);
+
+      // Decode the next record without applying it, setting its type and the bytes after the type
+      // Returns true if the record is cut off or unknown
+      bool readRecord(Journal::Record &type, std::string_view &payload);
+
+      // Read a little endian number of count bytes starting at offset
+      static unsigned readNumber(std::string_view bytes, size_t offset, int count);
+
+      // Check if every record was replayed
+      bool atEnd() const;
+
+      // Get the number of draws and discards applied so far
+      long long getActionCount() const;
+
+      // Get the seed of the game, 0 if it wasn't recorded
+      unsigned getSeed() const;
+
+      // Get the current round
+      int getRound() const;
+
+      // Get a player's score (0 for Computer, 1 for Human)
+      int getScore(int player) const;
+
+      // Get the player to move (0 for Computer, 1 for Human)
+      int getPlayerToMove() const;
+
+      // Get why replaying failed
+      std::string getError() const;
+
+      // Set the game file to the current state so it can be loaded into a Game
+      // Returns true if there is no state or a hand can't hold its cards (see getError())
+      bool toGameFile(GameFile &gameFile);
+
+   private:
+      std::string_view journal;
+      size_t position = 0;
+      long long actionCount = 0;
+      std::string error;
+
+      unsigned seed = 0;
+      int round = 0;
+      int scores[2] = { 0 };
+      int playerToMove = 0;
+
+      // Card ids of each hand in hand order, and of each pile with the top last
+      std::vector<unsigned char> hands[2];
+      std::vector<unsigned char> drawPile;
+      std::vector<unsigned char> discardPile;
+
+      // Set the state to a GameFile snapshot, returns true if it is not valid
+      bool loadState(std::string_view snapshot);
+
+      // Record why replaying failed, always returns true
+      bool setError(const std::string &message);
+};
+
+#endif
@@ -0,0 +1,196 @@
+/************************************************************
+* Keeps a league of computers (see league.h): registers them, plays
+* the matches between them across every core, and rates them. Each is
+* set up with a strategy and a difficulty as the game sets up its
+* computer, and decides every move through Computer::move() and
+* getCardToDiscard() (see selfPlay.h), so the ratings are of the
+* computer the game ships. Ratings are fitted again after every match
+* and the league is saved, so the ladder can be stopped at any time. A
+* computer added later plays only the pairings it's in.
+*
+* Usage: ladder [-f file] add name [setup]
+*        ladder [-f file] run [-g pairs] [-w rounds] [-s seed] [-j threads]
+*        ladder [-f file] show
+*    -f file         the league (default: fivecrowns.lge)
+*    add             register a computer, "difficulty=D,name=value,..."
+*                    with the difficulty 0 to 3 as the game's -d and the
+*                    strategy's parameters as its -p (default: the game's
+*                    defaults, difficulty 0)
+*    run             play every pairing until it has played -g deals, or
+*                    -w Swiss rounds of -g deals a pairing
+*    show            print the ratings
+*    -g pairs        deals a pairing plays, each from both seats (default: 50)
+*    -w rounds       Swiss rounds to play instead of a round robin
+*    -s seed         seed of the deals (default: 1)
+*    -j threads      number of threads to use (default: one per core)
+************************************************************/
+
+#include "league.h"
+#include "selfPlay.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Print the league's ratings, best first
+static void printRatings(const League &league)
+{
+   std::cout << std::left << std::setw(20) << "computer" << std::right << std::setw(8) << "elo" << std::setw(10) << "95%"
+      << std::setw(8) << "games" << "\n";
+   for (const League::Rating &rating : league.ratings())
+   {
+      std::cout << std::left << std::setw(20) << league.entry(rating.index).name << std::right << std::fixed << std::setprecision(0)
+         << std::setw(8) << rating.elo << std::setw(6) << "+/- " << std::setw(4) << rating.interval << std::setw(8) << rating.games
+         << "\n";
+   }
+}
+
+// Play a match for a pairing, record it, save the league, and print the ratings.
+// The deals are drawn from the seed, the pairing's names, and the games it has
+// played, so a pairing that plays again gets new deals. Returns true if the
+// league could not be saved
+static bool playPairing(League &league, const std::string &fileName, int first, int second, int pairs, unsigned seed,
+   unsigned threads)
+{
+   const League::Entry &a = league.entry(first);
+   const League::Entry &b = league.entry(second);
+   unsigned deals = seed ^ static_cast<unsigned>(std::hash<std::string>()(a.name + " " + b.name))
+      ^ static_cast<unsigned>(league.recordOf(first, second).games) * 0x9e3779b9u;
+
+   SelfPlay::MatchResult match = SelfPlay(a.setup, b.setup).playMatch(pairs, deals, threads);
+   league.record(first, second, match);
+
+   std::cout << "\n" << a.name << " against " << b.name << ": " << match.wins << "-" << match.losses << "-" << match.draws
+      << std::fixed << std::setprecision(2) << ", " << match.meanDifference << " points a game, "
+      << match.games / match.seconds << " games/s\n";
+   printRatings(league);
+
+   return league.save(fileName);
+}
+
+int main(int argc, char *argv[])
+{
+   std::string fileName = League::DEFAULT_FILE_NAME;
+   std::vector<std::string> words;
+   int pairs = 50;
+   int rounds = 0;
+   unsigned seed = 1;
+   unsigned threads = 0;
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if (argument == "-f" && i + 1 < argc)
+      {
+         fileName = argv[++i];
+      }
+      else if (argument == "-g" && i + 1 < argc)
+      {
+         pairs = std::max(1, std::atoi(argv[++i]));
+      }
+      else if (argument == "-w" && i + 1 < argc)
+      {
+         rounds = std::atoi(argv[++i]);
+      }
+      else if (argument == "-s" && i + 1 < argc)
+      {
+         seed = std::strtoul(argv[++i], nullptr, 10);
+      }
+      else if (argument == "-j" && i + 1 < argc)
+      {
+         threads = std::atoi(argv[++i]);
+      }
+      else
+      {
+         words.push_back(argument);
+      }
+   }
+
+   bool usable = !words.empty() && ((words[0] == "add" && (words.size() == 2 || words.size() == 3))
+      || ((words[0] == "run" || words[0] == "show") && words.size() == 1));
+   if (!usable)
+   {
+      std::cerr << "Usage: " << argv[0] << " [-f file] add name [setup]\n"
+         << "       " << argv[0] << " [-f file] run [-g pairs] [-w rounds] [-s seed] [-j threads]\n"
+         << "       " << argv[0] << " [-f file] show\n";
+      return EXIT_FAILURE;
+   }
+
+   League league;
+   if (league.load(fileName))
+   {
+      std::cerr << fileName << " is not a league\n";
+      return EXIT_FAILURE;
+   }
+
+   if (words[0] == "add")
+   {
+      ComputerSetup setup;
+      if (words.size() == 3 && setup.parse(words[2]))
+      {
+         std::cerr << "A setup must be name=value pairs separated by commas, with the difficulty 0 to 3\n";
+         return EXIT_FAILURE;
+      }
+      if (league.add(words[1], setup))
+      {
+         std::cerr << "There is already a computer named " << words[1] << ", or the name has spaces\n";
+         return EXIT_FAILURE;
+      }
+      if (league.save(fileName))
+      {
+         std::cerr << "Could not write " << fileName << "\n";
+         return EXIT_FAILURE;
+      }
+
+      std::cout << "Added " << words[1] << ": " << setup.toString() << "\n";
+      return EXIT_SUCCESS;
+   }
+
+   if (words[0] == "run")
+   {
+      if (league.size() < 2)
+      {
+         std::cerr << "Add at least two computers first\n";
+         return EXIT_FAILURE;
+      }
+
+      // A round robin plays the pairings short of games, new ones first,
+      // making up only the games each is short of
+      if (rounds == 0)
+      {
+         for (const std::pair<int, int> &pairing : league.roundRobin(2 * pairs))
+         {
+            int deals = pairs - league.recordOf(pairing.first, pairing.second).games / 2;
+            if (deals > 0 && playPairing(league, fileName, pairing.first, pairing.second, deals, seed, threads))
+            {
+               std::cerr << "Could not write " << fileName << "\n";
+               return EXIT_FAILURE;
+            }
+         }
+      }
+
+      // Swiss rounds pair computers of about the same rating, by the
+      // ratings as the round starts
+      for (int round = 0; round < rounds; round++)
+      {
+         for (const std::pair<int, int> &pairing : league.swissRound())
+         {
+            if (playPairing(league, fileName, pairing.first, pairing.second, pairs, seed, threads))
+            {
+               std::cerr << "Could not write " << fileName << "\n";
+               return EXIT_FAILURE;
+            }
+         }
+      }
+
+      std::cout << "\n";
+   }
+
+   printRatings(league);
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,480 @@
+#include "league.h"
+#include <algorithm>   // std::min, std::max, std::stable_sort
+#include <cmath>       // std::exp, std::log, std::sqrt, std::fabs
+#include <cstdio>      // std::rename, std::remove
+#include <fstream>
+#include <sstream>     // std::istringstream
+#include <utility>     // std::swap
+
+const std::string League::DEFAULT_FILE_NAME = "fivecrowns.lge";
+const std::string League::HEADER = "Five Crowns league 2";
+
+/* *********************************************************************
+Function Name: load()
+Purpose: Read a league from a file
+Parameters:
+         const string &fileName, the file
+Return Value: a bool, true if it could not be read (the league is then
+   empty)
+Local Variables:
+         ifstream file, the file
+         string line, one line of it
+         istringstream fields, the line split at spaces
+         string kind, what the line holds
+Algorithm:
+         1) A file that doesn't exist is an empty league
+         2) Check the header
+         3) Register each "computer name setup" line
+         4) Add each "result first second games wins losses draws" line
+            to the pairing of the computers named
+         5) Fail on anything else
+Assistance Received: none
+********************************************************************* */
+bool League::load(const std::string &fileName)
+{
+   this->entries.clear();
+   this->records.clear();
+
+   std::ifstream file(fileName);
+   if (!file)
+   {
+      return false;
+   }
+
+   std::string line;
+   if (!std::getline(file, line) || line != HEADER)
+   {
+      return true;
+   }
+
+   while (std::getline(file, line))
+   {
+      if (line.empty())
+      {
+         continue;
+      }
+
+      std::istringstream fields(line);
+      std::string kind;
+      fields >> kind;
+      if (kind == "computer")
+      {
+         std::string name;
+         std::string text;
+         ComputerSetup setup;
+         if (!(fields >> name >> text) || setup.parse(text) || add(name, setup))
+         {
+            this->entries.clear();
+            this->records.clear();
+            return true;
+         }
+      }
+      else if (kind == "result")
+      {
+         std::string first;
+         std::string second;
+         Record record;
+         if (!(fields >> first >> second >> record.games >> record.wins >> record.losses >> record.draws)
+            || find(first) == -1 || find(second) == -1 || find(first) == find(second))
+         {
+            this->entries.clear();
+            this->records.clear();
+            return true;
+         }
+
+         SelfPlay::MatchResult match;
+         match.games = record.games;
+         match.wins = record.wins;
+         match.losses = record.losses;
+         match.draws = record.draws;
+         this->record(find(first), find(second), match);
+      }
+      else
+      {
+         this->entries.clear();
+         this->records.clear();
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: save()
+Purpose: Write the league to a file
+Parameters:
+         const string &fileName, the file
+Return Value: a bool, true if it could not be written
+Local Variables:
+         string temporary, the file written before it's renamed
+         ofstream file, the temporary file
+Algorithm:
+         1) Write the header, every computer, and every pairing's results
+            to a temporary file
+         2) Rename it over the file, so a league is never half written
+Assistance Received: none
+********************************************************************* */
+bool League::save(const std::string &fileName) const
+{
+   std::string temporary = fileName + ".tmp";
+   std::ofstream file(temporary, std::ios::trunc);
+   file << HEADER << "\n";
+   for (const Entry &entry : this->entries)
+   {
+      file << "computer " << entry.name << " " << entry.setup.toString() << "\n";
+   }
+   for (const std::pair<const std::pair<int, int>, Record> &pairing : this->records)
+   {
+      const Record &record = pairing.second;
+      file << "result " << this->entries[pairing.first.first].name << " " << this->entries[pairing.first.second].name << " "
+         << record.games << " " << record.wins << " " << record.losses << " " << record.draws << "\n";
+   }
+   file.close();
+
+   if (!file)
+   {
+      std::remove(temporary.c_str());
+      return true;
+   }
+
+   return std::rename(temporary.c_str(), fileName.c_str()) != 0;
+}
+
+/* *********************************************************************
+Function Name: add()
+Purpose: Register a computer under a name
+Parameters:
+         const string &name, the name, without spaces
+         const ComputerSetup &setup, how the computer is set up
+Return Value: a bool, true if the name is taken or not valid
+Local Variables:
+         none
+Algorithm:
+         1) Refuse an empty name, one with spaces, or one taken
+         2) Add the computer
+Assistance Received: none
+********************************************************************* */
+bool League::add(const std::string &name, const ComputerSetup &setup)
+{
+   if (name.empty() || name.find_first_of(" \t\n") != std::string::npos || find(name) != -1)
+   {
+      return true;
+   }
+
+   this->entries.push_back({ name, setup });
+   return false;
+}
+
+/* *********************************************************************
+Function Name: size()
+Purpose: Get the number of computers
+Parameters:
+         none
+Return Value: an int, the number of computers
+Local Variables:
+         none
+Algorithm:
+         1) Return the number of entries
+Assistance Received: none
+********************************************************************* */
+int League::size() const
+{
+   return this->entries.size();
+}
+
+/* *********************************************************************
+Function Name: entry()
+Purpose: Get a registered computer
+Parameters:
+         int index, its index
+Return Value: an Entry, its name and parameters
+Local Variables:
+         none
+Algorithm:
+         1) Return the entry
+Assistance Received: none
+********************************************************************* */
+const League::Entry &League::entry(int index) const
+{
+   return this->entries[index];
+}
+
+/* *********************************************************************
+Function Name: find()
+Purpose: Find a computer by its name
+Parameters:
+         const string &name, the name
+Return Value: an int, its index, or -1 if there's none
+Local Variables:
+         none
+Algorithm:
+         1) Look through the entries
+Assistance Received: none
+********************************************************************* */
+int League::find(const std::string &name) const
+{
+   for (size_t i = 0; i < this->entries.size(); i++)
+   {
+      if (this->entries[i].name == name)
+      {
+         return i;
+      }
+   }
+
+   return -1;
+}
+
+/* *********************************************************************
+Function Name: record()
+Purpose: Add the games of a match between two computers
+Parameters:
+         int first, int second, the computers, first as the match's
+            first computer
+         const MatchResult &match, the match
+Return Value: none
+Local Variables:
+         Record &record, the pairing's results, from the lower index's side
+Algorithm:
+         1) Add the games to the pairing, turning wins and losses around
+            if first is the higher index
+Assistance Received: none
+********************************************************************* */
+void League::record(int first, int second, const SelfPlay::MatchResult &match)
+{
+   Record &record = this->records[{ std::min(first, second), std::max(first, second) }];
+   record.games += match.games;
+   record.draws += match.draws;
+   record.wins += first < second ? match.wins : match.losses;
+   record.losses += first < second ? match.losses : match.wins;
+}
+
+/* *********************************************************************
+Function Name: recordOf()
+Purpose: Get the results between two computers
+Parameters:
+         int first, int second, the computers
+Return Value: a Record, the results from first's side
+Local Variables:
+         Record record, the pairing's results
+Algorithm:
+         1) Find the pairing, empty if it hasn't played
+         2) Turn wins and losses around if first is the higher index
+Assistance Received: none
+********************************************************************* */
+League::Record League::recordOf(int first, int second) const
+{
+   Record record;
+   std::map<std::pair<int, int>, Record>::const_iterator found
+      = this->records.find({ std::min(first, second), std::max(first, second) });
+   if (found != this->records.end())
+   {
+      record = found->second;
+      if (first > second)
+      {
+         std::swap(record.wins, record.losses);
+      }
+   }
+
+   return record;
+}
+
+/* *********************************************************************
+Function Name: ratings()
+Purpose: Work out every computer's Elo rating from every result
+Parameters:
+         none
+Return Value: a vector<Rating>, the ratings, best first
+Local Variables:
+         int count, the number of computers
+         vector<double> strength, each one's Bradley-Terry strength
+         vector<double> scored, the points each scored (a tie is half)
+         vector<int> played, the games each has played
+         vector<double> sums, next, one round of the fit
+         double eloPerLog, Elo points per natural log of strength
+         vector<double> information, the curvature of the likelihood
+         vector<Rating> result, the ratings
+Algorithm:
+         1) Count each pairing's games with PRIOR_DRAWS more drawn ones
+         2) Fit the strengths by the minorization-maximization updates:
+            each is its points over the sum, over its pairings, of the
+            games over both strengths. Keep their geometric mean at 1,
+            and stop once no strength moves
+         3) A rating is 400 log10 of the strength, so 400 points are ten
+            to one odds, centred on the computers that have played
+         4) Half the 95% interval is 1.96 over the square root of the
+            information: the sum over pairings of games times p (1 - p)
+         5) Sort the ratings, best first
+Assistance Received: none
+********************************************************************* */
+std::vector<League::Rating> League::ratings() const
+{
+   int count = this->entries.size();
+   std::vector<double> strength(count, 1.0);
+   std::vector<double> scored(count, 0.0);
+   std::vector<int> played(count, 0);
+
+   for (const std::pair<const std::pair<int, int>, Record> &pairing : this->records)
+   {
+      const Record &record = pairing.second;
+      scored[pairing.first.first] += record.wins + (record.draws + PRIOR_DRAWS) / 2;
+      scored[pairing.first.second] += record.losses + (record.draws + PRIOR_DRAWS) / 2;
+      played[pairing.first.first] += record.games;
+      played[pairing.first.second] += record.games;
+   }
+
+   for (int iteration = 0; iteration < FIT_ITERATIONS; iteration++)
+   {
+      std::vector<double> sums(count, 0.0);
+      for (const std::pair<const std::pair<int, int>, Record> &pairing : this->records)
+      {
+         int i = pairing.first.first;
+         int j = pairing.first.second;
+         double games = pairing.second.games + PRIOR_DRAWS;
+         sums[i] += games / (strength[i] + strength[j]);
+         sums[j] += games / (strength[i] + strength[j]);
+      }
+
+      double logSum = 0;
+      int rated = 0;
+      std::vector<double> next = strength;
+      for (int i = 0; i < count; i++)
+      {
+         if (sums[i] > 0)
+         {
+            next[i] = scored[i] / sums[i];
+            logSum += std::log(next[i]);
+            rated++;
+         }
+      }
+
+      double change = 0;
+      for (int i = 0; i < count; i++)
+      {
+         if (sums[i] > 0)
+         {
+            next[i] /= std::exp(logSum / rated);
+            change = std::max(change, std::fabs(std::log(next[i] / strength[i])));
+         }
+      }
+
+      strength = next;
+      if (change < FIT_TOLERANCE)
+      {
+         break;
+      }
+   }
+
+   double eloPerLog = 400 / std::log(10.0);
+   std::vector<double> information(count, 0.0);
+   for (const std::pair<const std::pair<int, int>, Record> &pairing : this->records)
+   {
+      int i = pairing.first.first;
+      int j = pairing.first.second;
+      double p = strength[i] / (strength[i] + strength[j]);
+      double games = pairing.second.games + PRIOR_DRAWS;
+      information[i] += games * p * (1 - p);
+      information[j] += games * p * (1 - p);
+   }
+
+   std::vector<Rating> result(count);
+   for (int i = 0; i < count; i++)
+   {
+      result[i].index = i;
+      result[i].elo = eloPerLog * std::log(strength[i]);
+      result[i].interval = information[i] > 0 ? 1.96 * eloPerLog / std::sqrt(information[i]) : 0;
+      result[i].games = played[i];
+   }
+
+   std::stable_sort(result.begin(), result.end(), [](const Rating &a, const Rating &b) { return a.elo > b.elo; });
+
+   return result;
+}
+
+/* *********************************************************************
+Function Name: roundRobin()
+Purpose: Find the pairings that still have games to play
+Parameters:
+         int games, the games every pairing should have played
+Return Value: a vector<pair<int, int>>, the pairings short of games,
+   fewest played first
+Local Variables:
+         vector<pair<int, int>> pairings, the pairings found
+Algorithm:
+         1) Take every pair of computers that has played fewer games
+         2) Sort them by the games they've played, so a new computer's
+            pairings come first
+Assistance Received: none
+********************************************************************* */
+std::vector<std::pair<int, int>> League::roundRobin(int games) const
+{
+   std::vector<std::pair<int, int>> pairings;
+   for (int i = 0; i < size(); i++)
+   {
+      for (int j = i + 1; j < size(); j++)
+      {
+         if (recordOf(i, j).games < games)
+         {
+            pairings.push_back({ i, j });
+         }
+      }
+   }
+
+   std::stable_sort(pairings.begin(), pairings.end(), [this](const std::pair<int, int> &a, const std::pair<int, int> &b)
+   {
+      return recordOf(a.first, a.second).games < recordOf(b.first, b.second).games;
+   });
+
+   return pairings;
+}
+
+/* *********************************************************************
+Function Name: swissRound()
+Purpose: Pair computers of about the same rating
+Parameters:
+         none
+Return Value: a vector<pair<int, int>>, the pairings of the round
+Local Variables:
+         vector<Rating> order, the computers by rating
+         vector<bool> paired, whether each place in order is paired
+         int best, the place of the opponent chosen
+Algorithm:
+         1) Go through the computers best first
+         2) Pair each one not paired yet with the next one not paired
+            that it has played least, the nearest of those in rating
+         3) With an odd number of computers, the last one sits out
+Assistance Received: none
+********************************************************************* */
+std::vector<std::pair<int, int>> League::swissRound() const
+{
+   std::vector<Rating> order = ratings();
+   std::vector<bool> paired(order.size(), false);
+   std::vector<std::pair<int, int>> pairings;
+
+   for (size_t i = 0; i < order.size(); i++)
+   {
+      if (paired[i])
+      {
+         continue;
+      }
+
+      int best = -1;
+      for (size_t j = i + 1; j < order.size(); j++)
+      {
+         if (!paired[j] && (best == -1
+            || recordOf(order[i].index, order[j].index).games < recordOf(order[i].index, order[best].index).games))
+         {
+            best = j;
+         }
+      }
+
+      if (best != -1)
+      {
+         paired[i] = true;
+         paired[best] = true;
+         pairings.push_back({ order[i].index, order[best].index });
+      }
+   }
+
+   return pairings;
+}
@@ -0,0 +1,106 @@
+#ifndef LEAGUE_H
+#define LEAGUE_H
+
+#include "selfPlay.h"
+#include <map>
+#include <string>
+#include <utility>     // std::pair
+#include <vector>
+
+// Computers registered under names, each set up with a strategy and a
+// difficulty as the game sets its computer up (see ComputerSetup), the
+// results of the games played between each pair of them, and Elo ratings
+// worked out from all of those results (see the ladder tool, ladder.cpp).
+// Games are won by the game's rules (see winnerOf()), a tie counting half a
+// win. Ratings are the Bradley-Terry maximum likelihood fit of every result,
+// with a small prior so a computer that has won or lost every game still
+// gets a finite rating, and their confidence intervals come from the
+// curvature of the likelihood. They are cheap to fit again after every
+// match, so they stay up to date as results come in.
+// The league is kept in a text file, so a new computer can join and play
+// only the pairings it's in.
+class League
+{
+   public:
+      // File the ladder tool reads and writes the league in
+      static const std::string DEFAULT_FILE_NAME;
+
+      // First line of the file
+      static const std::string HEADER;
+
+      // A registered computer
+      struct Entry
+      {
+         std::string name;
+         ComputerSetup setup;
+      };
+
+      // The results of the games between two computers, from the side of
+      // the one registered first
+      struct Record
+      {
+         int games = 0;
+         int wins = 0;
+         int losses = 0;
+         int draws = 0;
+      };
+
+      // A computer's rating, and half the width of its 95% confidence interval
+      struct Rating
+      {
+         int index = 0;
+         double elo = 0;
+         double interval = 0;
+         int games = 0;
+      };
+
+      // Read a league from a file. A file that doesn't exist is an empty
+      // league. Returns true if it could not be read
+      bool load(const std::string &fileName);
+
+      // Write the league to a file through a temporary file renamed over it.
+      // Returns true if it could not be written
+      bool save(const std::string &fileName) const;
+
+      // Register a computer under a name (without spaces). Returns true if
+      // the name is taken or not valid
+      bool add(const std::string &name, const ComputerSetup &setup);
+
+      // The number of computers, one of them, and the index of a name (-1
+      // if there's none)
+      int size() const;
+      const Entry &entry(int index) const;
+      int find(const std::string &name) const;
+
+      // Add the games of a match between two computers, first against second
+      void record(int first, int second, const SelfPlay::MatchResult &match);
+
+      // The results between two computers, from first's side
+      Record recordOf(int first, int second) const;
+
+      // Every computer's rating, best first. The ratings average 0
+      std::vector<Rating> ratings() const;
+
+      // Pairings that have played fewer than games games, fewest first
+      std::vector<std::pair<int, int>> roundRobin(int games) const;
+
+      // One Swiss round: computers in order of rating, each paired with
+      // the nearest one not paired yet that it has played least
+      std::vector<std::pair<int, int>> swissRound() const;
+
+   private:
+      // Games a computer is taken to have drawn against each one it has
+      // played, so every rating is finite
+      static constexpr double PRIOR_DRAWS = 1.0;
+
+      // Rounds of the fit, and the change in every rating it stops at
+      static const int FIT_ITERATIONS = 1000;
+      static constexpr double FIT_TOLERANCE = 1e-9;
+
+      std::vector<Entry> entries;
+
+      // Results keyed by the pair of indices, lower first
+      std::map<std::pair<int, int>, Record> records;
+};
+
+#endif
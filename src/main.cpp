@@ -7,13 +7,66 @@
 
 #include "game.h"
 
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 using namespace std;
 
-int main()
+// Usage: project [-d difficulty] [-p parameters] [-j file]
+//    -d difficulty   how long the computer thinks about each decision:
+//                    0 answers right away with its rule of thumb (default),
+//                    1 takes 10 ms, 2 takes 100 ms, and 3 takes 1 s
+//    -p parameters   the parameters of its rule of thumb, as printed by the
+//                    tune tool ("name=value,..."; see Strategy)
+//    -j file         journal the game to the file so it can be recovered or
+//                    replayed (see Journal), games aren't journaled otherwise
+int main(int argc, char *argv[])
 {
+   Difficulty difficulty = Difficulty::HEURISTIC;
+   Strategy strategy;
+   string journalFile;
+   for (int i = 1; i < argc; i++)
+   {
+      string argument = argv[i];
+      if (argument == "-d" && i + 1 < argc)
+      {
+         int level = atoi(argv[++i]);
+         if (level < static_cast<int>(Difficulty::HEURISTIC) || level > static_cast<int>(Difficulty::HARD))
+         {
+            cerr << "Difficulty must be from 0 to 3\n";
+            return EXIT_FAILURE;
+         }
+         difficulty = static_cast<Difficulty>(level);
+      }
+      else if (argument == "-p" && i + 1 < argc)
+      {
+         if (strategy.parse(argv[++i]))
+         {
+            cerr << "Parameters must be name=value pairs separated by commas, named:";
+            for (int parameter = 0; parameter < Strategy::SIZE; parameter++)
+            {
+               cerr << " " << Strategy::RANGES[parameter].name;
+            }
+            cerr << "\n";
+            return EXIT_FAILURE;
+         }
+      }
+      else if (argument == "-j" && i + 1 < argc)
+      {
+         journalFile = argv[++i];
+      }
+      else
+      {
+         cerr << "Usage: " << argv[0] << " [-d difficulty] [-p parameters] [-j file]\n";
+         return EXIT_FAILURE;
+      }
+   }
+
    Game game;
+   game.setDifficulty(difficulty);
+   game.setStrategy(strategy);
+   game.setJournalFile(journalFile);
    game.startGame();
 
 
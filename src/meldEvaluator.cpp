@@ -0,0 +1,276 @@
+#include "meldEvaluator.h"
+#include <climits>   // INT_MAX
+
+/* *********************************************************************
+Function Name: MeldEvaluator()
+Purpose: Create an evaluator for a round
+Parameters:
+         int round, the round (to know the wild card)
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the round and the table index of its wild card number
+            (round + 2, which is index round - 1 since numbers start at 3)
+Assistance Received: none
+********************************************************************* */
+MeldEvaluator::MeldEvaluator(int round)
+   : round(round), wildNumber(round + Card::getWildCardOffset() - 3)
+{
+}
+
+/* *********************************************************************
+Function Name: deadwood()
+Purpose: Find the value of the cards left after the best arrangement
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+Return Value: an int, the value of the cards left
+Local Variables:
+         Search state, the table of natural cards and the wild cards
+Algorithm:
+         1) Count the natural cards in the table and add up the wild cards
+         2) Search every way of arranging the natural cards, keeping the
+            least left
+Assistance Received: none
+********************************************************************* */
+int MeldEvaluator::deadwood(const unsigned char *ids, int size) const
+{
+   Search state = Search();
+   state.best = INT_MAX;
+
+   for (int i = 0; i < size; i++)
+   {
+      if (isWild(ids[i]))
+      {
+         state.wilds++;
+         state.wildValue += value(ids[i]);
+      }
+      else
+      {
+         state.table[ids[i] / NUMBERS][ids[i] % NUMBERS]++;
+      }
+   }
+
+   search(state, 0, state.wilds, false, 0);
+
+   return state.best;
+}
+
+/* *********************************************************************
+Function Name: canGoOut()
+Purpose: Check if every card can be arranged in books and runs
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+Return Value: a bool, true if nothing is left
+Local Variables:
+         none
+Algorithm:
+         1) Check that the best arrangement leaves nothing
+Assistance Received: none
+********************************************************************* */
+bool MeldEvaluator::canGoOut(const unsigned char *ids, int size) const
+{
+   return deadwood(ids, size) == 0;
+}
+
+/* *********************************************************************
+Function Name: value()
+Purpose: Get the value of a card in this round
+Parameters:
+         int id, the card's id
+Return Value: an int, 50 for jokers, 20 for wild cards, otherwise the
+   card's number
+Local Variables:
+         none
+Algorithm:
+         1) Jokers are worth 50 and wild cards 20, like Card
+         2) Other cards are worth their number (3 to 13)
+Assistance Received: none
+********************************************************************* */
+int MeldEvaluator::value(int id) const
+{
+   if (id >= Card::FIRST_JOKER_ID)
+   {
+      return 50;
+   }
+
+   if (id % NUMBERS == this->wildNumber)
+   {
+      return 20;
+   }
+
+   return id % NUMBERS + 3;
+}
+
+/* *********************************************************************
+Function Name: isWild()
+Purpose: Check if a card is wild in this round
+Parameters:
+         int id, the card's id
+Return Value: a bool, true for jokers and cards of the wild number
+Local Variables:
+         none
+Algorithm:
+         1) Check for a joker or the round's wild number
+Assistance Received: none
+********************************************************************* */
+bool MeldEvaluator::isWild(int id) const
+{
+   return id >= Card::FIRST_JOKER_ID || id % NUMBERS == this->wildNumber;
+}
+
+/* *********************************************************************
+Function Name: search()
+Purpose: Search the ways of arranging the natural cards left in the table
+Parameters:
+         Search &state, the table, wild cards, and best found so far
+         int position, the table index (suit * 11 + number) to continue
+            from, every natural card before it has been used
+         int wildsLeft, the wild cards not used yet
+         bool melded, whether a book or run has been made
+         int left, the value of the natural cards left over so far
+Return Value: none
+Local Variables:
+         int suit, the suit of the next natural card
+         int number, its number
+Algorithm:
+         1) Stop if this can't leave less than the best found
+         2) Find the next natural card. If there is none, the wild cards
+            are left over only if no book or run was made and there are
+            fewer than three of them; keep the total if it's the best
+         3) Otherwise take the card and try every book and run it can
+            start (it's the lowest card left of its suit, so it starts
+            any run it's in), then leaving it over
+Assistance Received: none
+********************************************************************* */
+void MeldEvaluator::search(Search &state, int position, int wildsLeft, bool melded, int left) const
+{
+   if (left >= state.best)
+   {
+      return;
+   }
+
+   while (position < SUITS * NUMBERS && state.table[position / NUMBERS][position % NUMBERS] == 0)
+   {
+      position++;
+   }
+
+   if (position == SUITS * NUMBERS)
+   {
+      int total = left;
+      if (!melded && state.wilds < MINIMUM_MELD)
+      {
+         total += state.wildValue;
+      }
+
+      if (total < state.best)
+      {
+         state.best = total;
+      }
+      return;
+   }
+
+   int suit = position / NUMBERS;
+   int number = position % NUMBERS;
+
+   state.table[suit][number]--;
+   searchRuns(state, position, suit, number, number + 1, number, 1, wildsLeft, left);
+   searchBooks(state, position, suit, number, suit, 1, wildsLeft, left);
+   search(state, position, wildsLeft, melded, left + number + 3);
+   state.table[suit][number]++;
+}
+
+/* *********************************************************************
+Function Name: searchBooks()
+Purpose: Try every book the card taken at [suit][number] can start
+Parameters:
+         Search &state, the table, wild cards, and best found so far
+         int position, the table index to continue the search from
+         int suit, the suit of the card that starts the book
+         int number, its number
+         int nextSuit, the first suit more cards can be added from
+         int size, the natural cards in the book so far
+         int wildsLeft, the wild cards not used yet
+         int left, the value of the natural cards left over so far
+Return Value: none
+Local Variables:
+         int needed, the wild cards needed to finish the book
+Algorithm:
+         1) If the book can be finished with the wild cards left, go on
+            searching with it made
+         2) Add one more card of the number from nextSuit on (suits in
+            order so every choice of cards is tried once) and try again
+Assistance Received: none
+********************************************************************* */
+void MeldEvaluator::searchBooks(Search &state, int position, int suit, int number, int nextSuit, int size, int wildsLeft, int left) const
+{
+   int needed = size < MINIMUM_MELD ? MINIMUM_MELD - size : 0;
+   if (needed <= wildsLeft)
+   {
+      search(state, position, wildsLeft - needed, true, left);
+   }
+
+   for (int other = nextSuit; other < SUITS; other++)
+   {
+      if (state.table[other][number] > 0)
+      {
+         state.table[other][number]--;
+         searchBooks(state, position, suit, number, other, size + 1, wildsLeft, left);
+         state.table[other][number]++;
+      }
+   }
+}
+
+/* *********************************************************************
+Function Name: searchRuns()
+Purpose: Try every run the card taken at [suit][number] can start
+Parameters:
+         Search &state, the table, wild cards, and best found so far
+         int position, the table index to continue the search from
+         int suit, the suit of the run
+         int number, the number of its lowest natural card
+         int next, the first number more cards can be added from
+         int highest, the number of its highest natural card so far
+         int size, the natural cards in the run so far
+         int wildsLeft, the wild cards not used yet
+         int left, the value of the natural cards left over so far
+Return Value: none
+Local Variables:
+         int length, the numbers the run covers
+         int needed, the wild cards needed to fill its gaps and make it
+            at least three long
+Algorithm:
+         1) If the run can be finished with the wild cards left, go on
+            searching with it made
+         2) Add the next higher card of the suit (one of each number) and
+            try again, stopping once there are too many gaps to fill
+Assistance Received: none
+********************************************************************* */
+void MeldEvaluator::searchRuns(Search &state, int position, int suit, int number, int next, int highest, int size, int wildsLeft, int left) const
+{
+   int length = highest - number + 1;
+   int needed = (length < MINIMUM_MELD ? MINIMUM_MELD : length) - size;
+   if (needed <= wildsLeft)
+   {
+      search(state, position, wildsLeft - needed, true, left);
+   }
+
+   for (int higher = next; higher < NUMBERS; higher++)
+   {
+      // Gaps only grow with higher cards
+      if ((higher - number + 1) - (size + 1) > wildsLeft)
+      {
+         break;
+      }
+
+      if (state.table[suit][higher] > 0)
+      {
+         state.table[suit][higher]--;
+         searchRuns(state, position, suit, number, higher + 1, higher, size + 1, wildsLeft, left);
+         state.table[suit][higher]++;
+      }
+   }
+}
+
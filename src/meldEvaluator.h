@@ -0,0 +1,64 @@
+#ifndef MELDEVALUATOR_H
+#define MELDEVALUATOR_H
+
+#include "card.h"
+
+// Finds the least a hand of card ids can be left with after arranging it in
+// books and runs, exactly and without allocating, for search and sampling
+// where CombinationFinder is too slow. Natural cards are grouped in a table
+// like CombinationFinder's and searched card by card: each either starts a
+// book or run with wild cards filling the gaps, or is left over. Once any
+// book or run is made the wild cards left can join it, and three or more
+// wild cards make one on their own.
+// Game still scores with CombinationFinder (Player::bestArrangement()), which
+// tries two orders and can leave more than this finds.
+class MeldEvaluator
+{
+   public:
+      // Evaluate hands in a round (to know the wild card)
+      explicit MeldEvaluator(int round);
+
+      // The value of the cards left after the best arrangement
+      int deadwood(const unsigned char *ids, int size) const;
+
+      // Check if every card can be arranged in books and runs
+      bool canGoOut(const unsigned char *ids, int size) const;
+
+      // The value of a card in this round
+      int value(int id) const;
+
+      // Check if a card is wild in this round
+      bool isWild(int id) const;
+
+   private:
+      static const int SUITS = Card::NUMBER_OF_SUITS;
+      static const int NUMBERS = Card::NUMBER_OF_NUMBERS;
+
+      // Shortest book or run
+      static const int MINIMUM_MELD = 3;
+
+      // The hand being searched
+      struct Search
+      {
+         unsigned char table[SUITS][NUMBERS];
+         int wilds;
+         int wildValue;
+         int best;
+      };
+
+      // Search the natural cards from table index position on
+      void search(Search &state, int position, int wildsLeft, bool melded, int left) const;
+
+      // Try every book the card at [suit][number] can start
+      void searchBooks(Search &state, int position, int suit, int number, int nextSuit, int size, int wildsLeft, int left) const;
+
+      // Try every run the card at [suit][number] can start
+      void searchRuns(Search &state, int position, int suit, int number, int next, int highest, int size, int wildsLeft, int left) const;
+
+      int round;
+
+      // Index of the wild card's number in the table
+      int wildNumber;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef MELDRESULT_H
+#define MELDRESULT_H
+
+#include "card.h"
+#include <vector>
+
+// The arrangement of a hand into books and runs made by CombinationFinder.
+// It is returned by value and moved to whoever needs it so the books, runs,
+// and remaining cards are never copied on their way out of the finder.
+struct MeldResult
+{
+   // Books made from the hand
+   std::vector<std::vector<Card>> books;
+
+   // Runs made from the hand
+   std::vector<std::vector<Card>> runs;
+
+   // Cards that could not be used in a book or run
+   std::vector<Card> deadwood;
+
+   // Sum of the values of the deadwood cards
+   int deadwoodScore = 0;
+
+   // Number of wild cards and jokers used in books and runs
+   int wildsUsed = 0;
+};
+
+#endif
@@ -0,0 +1,302 @@
+/************************************************************
+* Measures how fast hands are arranged into books and runs: building a
+* CombinationFinder, finding combinations books first and runs first,
+* findWorstCard(), getScore(), and Player::goOut(), over seeded random
+* hands of every size from 3 to 14 cards.
+*
+* Usage: meldbench [-n hands] [-s seed] [-o file] [-l label]
+*    -n hands   random hands of each size (default 2000)
+*    -s seed    seed the hands are dealt with (default 366)
+*    -o file    where to write the results as JSON (default
+*               meldbench.json)
+*    -l label   written with the results, such as the commit measured
+*
+* Each op is timed on its own, so the percentiles are of single calls
+* (a call to the clock costs some tens of ns, which only matters for
+* getScore()). Allocations are counted by replacing operator new. Hands
+* of up to 13 cards are dealt in the round they're the size of before
+* drawing, and 14 cards is the last round after drawing. findWorstCard()
+* and getScore() are timed on finders already arranged in the best
+* order.
+************************************************************/
+
+#include "card.h"
+#include "combinationFinder.h"
+#include "player.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+   // Allocations made so far, counted by the operator new below
+   long long allocations = 0;
+
+   // Hands of these many cards are measured
+   const int FIRST_SIZE = 3;
+   const int LAST_SIZE = 14;
+
+   // A player that only holds a hand, to time goOut()
+   class BenchPlayer : public Player
+   {
+      public:
+         virtual int chooseGameOption() override { return 0; }
+         virtual int move() override { return 0; }
+         virtual void printMenu() override {}
+         virtual std::pair<bool, std::string> getCardToDiscard() override { return { false, "" }; }
+         virtual std::string toString() const override { return "Bench"; }
+   };
+
+   // What one op did over every hand of one size
+   struct Result
+   {
+      std::string op;
+      int cards = 0;
+      int round = 0;
+      long long ops = 0;
+      double nsPerOp = 0;
+      double allocationsPerOp = 0;
+      double p50 = 0;
+      double p90 = 0;
+      double p99 = 0;
+   };
+
+   // Time op(i) for every hand, one call at a time
+   template <typename Op>
+   Result measure(const std::string &name, int cards, int round, int hands, Op op)
+   {
+      std::vector<double> times(hands);
+      long long before = allocations;
+      for (int i = 0; i < hands; i++)
+      {
+         std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+         op(i);
+         times[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      }
+      long long made = allocations - before;
+
+      Result result;
+      result.op = name;
+      result.cards = cards;
+      result.round = round;
+      result.ops = hands;
+      for (double time : times)
+      {
+         result.nsPerOp += time / hands;
+      }
+      result.allocationsPerOp = static_cast<double>(made) / hands;
+
+      std::sort(times.begin(), times.end());
+      result.p50 = times[hands * 50 / 100];
+      result.p90 = times[hands * 90 / 100];
+      result.p99 = times[hands * 99 / 100];
+
+      return result;
+   }
+
+   // Deal random hands of a size from two shuffled decks
+   std::vector<std::vector<Card>> dealHands(int cards, int round, int hands, std::mt19937 &generator)
+   {
+      std::vector<int> deck;
+      for (int copy = 0; copy < 2; copy++)
+      {
+         for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+         {
+            deck.push_back(id);
+         }
+      }
+
+      std::vector<std::vector<Card>> dealt(hands);
+      for (std::vector<Card> &hand : dealt)
+      {
+         std::shuffle(deck.begin(), deck.end(), generator);
+         for (int i = 0; i < cards; i++)
+         {
+            hand.push_back(Card::fromId(deck[i], round));
+         }
+      }
+
+      return dealt;
+   }
+
+   // Write the results as JSON
+   std::string toJson(const std::vector<Result> &results, const std::string &text, unsigned seed, int hands)
+   {
+      std::string label;
+      for (char c : text)
+      {
+         if (c == '"' || c == '\\')
+         {
+            label += '\\';
+         }
+         label += c;
+      }
+
+      std::ostringstream json;
+      json << std::fixed << std::setprecision(1);
+      json << "{\n  \"benchmark\": \"meldbench\",\n  \"label\": \"" << label << "\",\n  \"seed\": " << seed
+         << ",\n  \"hands\": " << hands << ",\n  \"results\": [\n";
+      for (size_t i = 0; i < results.size(); i++)
+      {
+         const Result &result = results[i];
+         json << "    { \"op\": \"" << result.op << "\", \"cards\": " << result.cards << ", \"round\": " << result.round
+            << ", \"ops\": " << result.ops << ", \"ns_per_op\": " << result.nsPerOp
+            << ", \"allocations_per_op\": " << std::setprecision(2) << result.allocationsPerOp << std::setprecision(1)
+            << ", \"p50_ns\": " << result.p50 << ", \"p90_ns\": " << result.p90 << ", \"p99_ns\": " << result.p99 << " }"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+      }
+      json << "  ]\n}\n";
+
+      return json.str();
+   }
+}
+
+// Count every allocation the code measured makes
+void *operator new(std::size_t size)
+{
+   allocations++;
+   void *memory = std::malloc(size == 0 ? 1 : size);
+   if (memory == nullptr)
+   {
+      throw std::bad_alloc();
+   }
+   return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+   std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+   std::free(memory);
+}
+
+int main(int argc, char *argv[])
+{
+   int hands = 2000;
+   unsigned seed = 366;
+   std::string fileName = "meldbench.json";
+   std::string label;
+
+   for (int i = 1; i + 1 < argc; i += 2)
+   {
+      std::string argument = argv[i];
+      if (argument == "-n")
+      {
+         hands = std::max(1, std::atoi(argv[i + 1]));
+      }
+      else if (argument == "-s")
+      {
+         seed = std::strtoul(argv[i + 1], nullptr, 10);
+      }
+      else if (argument == "-o")
+      {
+         fileName = argv[i + 1];
+      }
+      else if (argument == "-l")
+      {
+         label = argv[i + 1];
+      }
+   }
+
+   std::mt19937 generator(seed);
+   std::vector<Result> results;
+
+   // goOut() prints the books and runs of a hand that goes out
+   std::ofstream discard;
+   std::streambuf *console = std::cout.rdbuf();
+
+   for (int cards = FIRST_SIZE; cards <= LAST_SIZE; cards++)
+   {
+      int round = std::min(cards - Card::getWildCardOffset(), 11);
+      std::vector<std::vector<Card>> dealt = dealHands(cards, round, hands, generator);
+
+      // Warm up the caches and the allocator
+      for (int i = 0; i < std::min(hands, 100); i++)
+      {
+         CombinationFinder finder(dealt[i]);
+         finder.findBestCombinations();
+      }
+
+      results.push_back(measure("construct", cards, round, hands, [&](int i)
+      {
+         CombinationFinder finder(dealt[i]);
+      }));
+
+      results.push_back(measure("booksFirst", cards, round, hands, [&](int i)
+      {
+         CombinationFinder finder(dealt[i]);
+         finder.findCombinations(CombinationFinder::Order::BOOKS_FIRST);
+      }));
+
+      results.push_back(measure("runsFirst", cards, round, hands, [&](int i)
+      {
+         CombinationFinder finder(dealt[i]);
+         finder.findCombinations(CombinationFinder::Order::RUNS_FIRST);
+      }));
+
+      std::vector<CombinationFinder> arranged;
+      arranged.reserve(hands);
+      for (int i = 0; i < hands; i++)
+      {
+         arranged.emplace_back(dealt[i]);
+         arranged.back().findBestCombinations();
+      }
+      std::vector<CombinationFinder> scored = arranged;
+
+      results.push_back(measure("findWorstCard", cards, round, hands, [&](int i)
+      {
+         arranged[i].findWorstCard();
+      }));
+
+      results.push_back(measure("getScore", cards, round, hands, [&](int i)
+      {
+         scored[i].getScore();
+      }));
+
+      std::vector<BenchPlayer> players(hands);
+      for (int i = 0; i < hands; i++)
+      {
+         players[i].setHand(dealt[i]);
+      }
+
+      std::cout.rdbuf(discard.rdbuf());
+      results.push_back(measure("goOut", cards, round, hands, [&](int i)
+      {
+         players[i].goOut();
+      }));
+      std::cout.rdbuf(console);
+   }
+
+   std::cout << std::left << std::setw(15) << "op" << std::right << std::setw(6) << "cards" << std::setw(12) << "ns/op"
+      << std::setw(12) << "allocs/op" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << "\n";
+   std::cout << std::fixed;
+   for (const Result &result : results)
+   {
+      std::cout << std::left << std::setw(15) << result.op << std::right << std::setw(6) << result.cards << std::setprecision(0)
+         << std::setw(12) << result.nsPerOp << std::setprecision(1) << std::setw(12) << result.allocationsPerOp
+         << std::setprecision(0) << std::setw(10) << result.p50 << std::setw(10) << result.p90 << std::setw(10) << result.p99 << "\n";
+   }
+
+   std::ofstream file(fileName, std::ios::trunc);
+   file << toJson(results, label, seed, hands);
+   if (!file)
+   {
+      std::cerr << "Could not write " << fileName << "\n";
+      return EXIT_FAILURE;
+   }
+   std::cout << "Wrote " << fileName << "\n";
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,202 @@
+/************************************************************
+* Measures how fast actions can be made and taken back on a
+* GameState, the core of a tree search.
+*
+* Usage: movebench [-n lines] [-d depth]
+*    -n lines   number of random lines of actions per round (default 2000)
+*    -d depth   actions in each line (default 8)
+*
+* For every round it times draws and discards made and taken back with an
+* UndoStack (apart, since a discard also checks if the player went out),
+* then random lines of actions all taken back, checking the state comes
+* back exactly. The same lines are then played by copying the state with
+* apply() for comparison, checking the hash each action keeps against
+* hashing the state again. An op is one action made and taken back.
+************************************************************/
+
+#include "gameState.h"
+#include "zobrist.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace
+{
+   // Seconds since start
+   double secondsSince(std::chrono::steady_clock::time_point start)
+   {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   }
+
+   // Check if two states hold the same game. Slots past the end of a hand or
+   // pile are left as they were by undo(), so only the cards in play are compared
+   bool sameState(const GameState &first, const GameState &second)
+   {
+      if (first.drawSize != second.drawSize || first.discardSize != second.discardSize
+         || first.round != second.round || first.playerToMove != second.playerToMove
+         || first.phase != second.phase || first.goneOutCount != second.goneOutCount
+         || first.lastTurn != second.lastTurn || first.seed != second.seed || first.hash != second.hash)
+      {
+         return false;
+      }
+
+      for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+      {
+         if (first.handSizes[player] != second.handSizes[player] || first.scores[player] != second.scores[player]
+            || std::memcmp(first.hands[player], second.hands[player], first.handSizes[player]) != 0)
+         {
+            return false;
+         }
+      }
+
+      return std::memcmp(first.drawPile, second.drawPile, first.drawSize) == 0
+         && std::memcmp(first.discardPile, second.discardPile, first.discardSize) == 0;
+   }
+
+   // Pick a random legal action, returns false if there is none
+   bool randomAction(const GameState &state, std::mt19937 &generator, Action &action)
+   {
+      Action actions[GameState::MAX_ACTIONS];
+      int count = legalActions(state, actions);
+      if (count == 0)
+      {
+         return false;
+      }
+
+      action = actions[generator() % count];
+      return true;
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   int lines = 2000;
+   int depth = 8;
+
+   for (int i = 1; i + 1 < argc; i += 2)
+   {
+      std::string argument = argv[i];
+      if (argument == "-n")
+      {
+         lines = std::atoi(argv[i + 1]);
+      }
+      else if (argument == "-d")
+      {
+         depth = std::atoi(argv[i + 1]);
+      }
+   }
+
+   if (depth > UndoStack::CAPACITY)
+   {
+      depth = UndoStack::CAPACITY;
+   }
+
+   std::mt19937 generator(366);
+   static UndoStack stack;
+
+   long long drawOperations = 0;
+   long long discardOperations = 0;
+   long long lineOperations = 0;
+   long long copyOperations = 0;
+   double drawSeconds = 0;
+   double discardSeconds = 0;
+   double lineSeconds = 0;
+   double copySeconds = 0;
+
+   for (int round = 1; round <= 11; round++)
+   {
+      const GameState start = startRound(round, round, 0, 0, 0);
+
+      // Draws: take the top of each pile and put it back
+      std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+      GameState state = start;
+      for (int i = 0; i < lines * depth; i++)
+      {
+         stack.apply(state, { Action::Type::DRAW_DECK, 0 });
+         stack.undo(state);
+         stack.apply(state, { Action::Type::DRAW_DISCARD, 0 });
+         stack.undo(state);
+      }
+      drawSeconds += secondsSince(begin);
+      drawOperations += 2LL * lines * depth;
+
+      // Discards: discard each card of the hand after a draw and take it back
+      stack.apply(state, { Action::Type::DRAW_DECK, 0 });
+      Action discards[GameState::MAX_ACTIONS];
+      int discardCount = legalActions(state, discards);
+
+      begin = std::chrono::steady_clock::now();
+      for (int i = 0; i < lines / 10 + 1; i++)
+      {
+         for (int j = 0; j < discardCount; j++)
+         {
+            stack.apply(state, discards[j]);
+            stack.undo(state);
+         }
+      }
+      discardSeconds += secondsSince(begin);
+      discardOperations += static_cast<long long>(lines / 10 + 1) * discardCount;
+      stack.undo(state);
+
+      // Lines: random lines of actions made with the undo stack and all taken back
+      for (int line = 0; line < lines; line++)
+      {
+         Action actions[UndoStack::CAPACITY];
+         int length = 0;
+
+         begin = std::chrono::steady_clock::now();
+         while (length < depth && randomAction(state, generator, actions[length]))
+         {
+            stack.apply(state, actions[length]);
+            length++;
+         }
+         while (!stack.empty())
+         {
+            stack.undo(state);
+         }
+         lineSeconds += secondsSince(begin);
+         lineOperations += length;
+
+         if (!sameState(state, start))
+         {
+            std::cerr << "Round " << round << ", line " << line << ": undo did not restore the state\n";
+            return EXIT_FAILURE;
+         }
+
+         // The same line by copying the state with apply()
+         begin = std::chrono::steady_clock::now();
+         GameState copy = start;
+         for (int i = 0; i < length; i++)
+         {
+            copy = apply(copy, actions[i]);
+         }
+         copySeconds += secondsSince(begin);
+         copyOperations += length;
+
+         // The hash kept by each action must match hashing the state again
+         copy = start;
+         for (int i = 0; i < length; i++)
+         {
+            copy = apply(copy, actions[i]);
+            if (copy.hash != Zobrist::hash(copy))
+            {
+               std::cerr << "Round " << round << ", line " << line << ": hash out of date after action " << i << "\n";
+               return EXIT_FAILURE;
+            }
+         }
+      }
+   }
+
+   std::cout << "apply+undo, draws:        " << drawOperations / (drawSeconds > 0 ? drawSeconds : 1) << " ops/s\n";
+   std::cout << "apply+undo, discards:     " << discardOperations / (discardSeconds > 0 ? discardSeconds : 1) << " ops/s\n";
+   std::cout << "apply+undo, random lines: " << lineOperations / (lineSeconds > 0 ? lineSeconds : 1) << " ops/s ("
+      << lineOperations << " actions, depth " << depth << ")\n";
+   std::cout << "copy+apply, random lines: " << copyOperations / (copySeconds > 0 ? copySeconds : 1) << " ops/s\n";
+   std::cout << "sizeof(GameState) " << sizeof(GameState) << ", sizeof(UndoRecord) " << sizeof(UndoRecord) << "\n";
+
+   return EXIT_SUCCESS;
+}
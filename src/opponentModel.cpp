@@ -0,0 +1,465 @@
+#include "opponentModel.h"
+#include <algorithm>   // std::min, std::max
+
+/* *********************************************************************
+Function Name: startRound()
+Purpose: Start keeping track of a round
+Parameters:
+         int round, the round (to know the wild card)
+         int handSize, the cards the other player holds
+         const vector<int> &discardPile, ids of the cards face up in
+            the discard pile
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Nothing is known about the hand yet, so every card weighs the
+            same
+         2) Count the cards face up in the discard pile
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::startRound(int round, int handSize, const std::vector<int> &discardPile)
+{
+   this->round = round;
+   this->handSize = handSize;
+   this->tookDiscardLast = false;
+
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      this->weight[id] = 1.0f;
+      this->held[id] = 0;
+      this->faceUp[id] = 0;
+   }
+
+   for (int id : discardPile)
+   {
+      this->faceUp[id]++;
+   }
+}
+
+/* *********************************************************************
+Function Name: opponentDrewDeck()
+Purpose: Keep track of the other player drawing from the deck
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Their hand grows by a card no one saw
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::opponentDrewDeck()
+{
+   this->handSize++;
+   this->tookDiscardLast = false;
+}
+
+/* *********************************************************************
+Function Name: opponentTookDiscard()
+Purpose: Keep track of the other player taking the top of the discard
+   pile
+Parameters:
+         int id, the card they took
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) The card moves from the discard pile into their hand, where
+            it's known to be
+         2) They likely took it to go with cards they hold, so raise the
+            weight of cards that go with it
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::opponentTookDiscard(int id)
+{
+   this->handSize++;
+   this->tookDiscardLast = true;
+
+   if (this->faceUp[id] > 0)
+   {
+      this->faceUp[id]--;
+   }
+   this->held[id]++;
+
+   reweigh(id, TAKEN);
+}
+
+/* *********************************************************************
+Function Name: opponentDiscarded()
+Purpose: Keep track of the other player throwing a card away
+Parameters:
+         int id, the card they threw away
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) The card moves from their hand to the discard pile, and is no
+            longer known to be held if it was
+         2) They didn't want it, so lower the weight of cards that go
+            with it
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::opponentDiscarded(int id)
+{
+   this->handSize--;
+   this->faceUp[id]++;
+   if (this->held[id] > 0)
+   {
+      this->held[id]--;
+   }
+
+   reweigh(id, THROWN);
+}
+
+/* *********************************************************************
+Function Name: tookDiscard()
+Purpose: Keep track of the player the model is for taking the top of the
+   discard pile
+Parameters:
+         int id, the card taken
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) The card is no longer face up
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::tookDiscard(int id)
+{
+   if (this->faceUp[id] > 0)
+   {
+      this->faceUp[id]--;
+   }
+}
+
+/* *********************************************************************
+Function Name: discarded()
+Purpose: Keep track of the player the model is for throwing a card away
+Parameters:
+         int id, the card thrown away
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) The card is face up
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::discarded(int id)
+{
+   this->faceUp[id]++;
+}
+
+/* *********************************************************************
+Function Name: tookDiscardLastTurn()
+Purpose: Check if the other player took from the discard pile on their
+   last turn
+Parameters:
+         none
+Return Value: a bool, true if they did
+Local Variables:
+         none
+Algorithm:
+         1) Return the flag
+Assistance Received: none
+********************************************************************* */
+bool OpponentModel::tookDiscardLastTurn() const
+{
+   return this->tookDiscardLast;
+}
+
+/* *********************************************************************
+Function Name: expectedCopies()
+Purpose: Find how many of each card the other player is expected to hold
+Parameters:
+         const Hand &ownHand, the hand of the player the model is for
+         float copies[], set to the expected copies of each card id
+Return Value: none
+Local Variables:
+         int unseen[], the copies of each card that can't be seen and
+            aren't known to be held
+         int unknown, the cards in their hand that aren't known
+         float total, the weight of every unseen copy
+Algorithm:
+         1) Take the cards in the hand, face up, and known to be held out
+            of the two copies of each card
+         2) Spread the unknown cards in their hand over the unseen copies
+            by weight, never more than the copies left
+         3) Add the cards known to be held
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::expectedCopies(const Hand &ownHand, float copies[Card::NUMBER_OF_IDS]) const
+{
+   int unseen[Card::NUMBER_OF_IDS];
+   int unknown = this->handSize;
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      unseen[id] = COPIES_OF_EACH_CARD - this->faceUp[id] - this->held[id];
+      unknown -= this->held[id];
+   }
+
+   for (const Card &card : ownHand)
+   {
+      unseen[card.getId()]--;
+   }
+
+   float total = 0;
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      unseen[id] = std::max(unseen[id], 0);
+      total += unseen[id] * this->weight[id];
+   }
+
+   float share = total > 0 && unknown > 0 ? unknown / total : 0;
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      copies[id] = this->held[id] + std::min(unseen[id] * this->weight[id] * share, static_cast<float>(unseen[id]));
+   }
+}
+
+/* *********************************************************************
+Function Name: discardBenefits()
+Purpose: Find how much each card would help the other player if it were
+   thrown away
+Parameters:
+         const Hand &ownHand, the hand of the player the model is for
+         float benefit[], set to the benefit of each card id
+Return Value: none
+Local Variables:
+         float copies[], the expected copies of each card they hold
+         float padded[][], the expected copies of the natural cards of
+            each suit, with two empty numbers on each side
+         float sameNumber[], the expected cards of each number
+Algorithm:
+         1) Find the expected copies of each card, leaving out wild cards
+         2) For each number, add up the expected cards of every suit,
+            which would make a book with it
+         3) For each natural card, add the cards of its number and the
+            cards next to it in its suit, with cards two away counting
+            half. Each row is a straight loop over the numbers so the
+            compiler can vectorise it
+         4) Wild cards go with anything, so they're worth the whole hand
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::discardBenefits(const Hand &ownHand, float benefit[Card::NUMBER_OF_IDS]) const
+{
+   float copies[Card::NUMBER_OF_IDS];
+   expectedCopies(ownHand, copies);
+
+   float padded[SUITS][NUMBERS + 4] = { { 0 } };
+   for (int suit = 0; suit < SUITS; suit++)
+   {
+      for (int number = 0; number < NUMBERS; number++)
+      {
+         int id = suit * NUMBERS + number;
+         padded[suit][number + 2] = isWild(id) ? 0 : copies[id];
+      }
+   }
+
+   float sameNumber[NUMBERS] = { 0 };
+   for (int suit = 0; suit < SUITS; suit++)
+   {
+      for (int number = 0; number < NUMBERS; number++)
+      {
+         sameNumber[number] += padded[suit][number + 2];
+      }
+   }
+
+   for (int suit = 0; suit < SUITS; suit++)
+   {
+      const float *row = padded[suit] + 2;
+      float *out = benefit + suit * NUMBERS;
+      for (int number = 0; number < NUMBERS; number++)
+      {
+         out[number] = sameNumber[number] + row[number - 1] + row[number + 1] + 0.5f * (row[number - 2] + row[number + 2]);
+      }
+   }
+
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      if (isWild(id))
+      {
+         benefit[id] = static_cast<float>(this->handSize);
+      }
+   }
+}
+
+/* *********************************************************************
+Function Name: completionProbabilities()
+Purpose: Find how likely each card is to complete a book or run for the
+   other player if it were thrown away
+Parameters:
+         const Hand &ownHand, the hand of the player the model is for
+         float completion[], set to the probability for each card id
+Return Value: none
+Local Variables:
+         float copies[], the expected copies of each card they hold
+         float held[][], the probability they hold each natural card,
+            with two empty numbers on each side of each suit
+         float noWild, the probability they hold no wild card
+         float noneOfNumber[], noneOrOne[], the probability they hold
+            none, or at most one, of each number
+Algorithm:
+         1) Take the expected copies of each card (at most 1) as the
+            probability of holding it, as if the cards were independent
+         2) A book is completed with two cards of its number, a run with
+            two cards next to it in the suit (one each side, or both on
+            one side), and either with a wild card and one card that
+            goes with it
+         3) Combine the three ways, each suit a straight loop over the
+            numbers
+         4) Wild cards always complete one
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::completionProbabilities(const Hand &ownHand, float completion[Card::NUMBER_OF_IDS]) const
+{
+   float copies[Card::NUMBER_OF_IDS];
+   expectedCopies(ownHand, copies);
+
+   float noWild = 1.0f;
+   float held[SUITS][NUMBERS + 4] = { { 0 } };
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      float probability = std::min(copies[id], 1.0f);
+      if (isWild(id))
+      {
+         noWild *= 1.0f - probability;
+      }
+      else
+      {
+         held[id / NUMBERS][id % NUMBERS + 2] = probability;
+      }
+   }
+
+   // Chance of holding none, and at most one, of each number
+   float noneOfNumber[NUMBERS];
+   float noneOrOne[NUMBERS];
+   for (int number = 0; number < NUMBERS; number++)
+   {
+      float none = 1.0f;
+      float one = 0.0f;
+      for (int suit = 0; suit < SUITS; suit++)
+      {
+         float probability = held[suit][number + 2];
+         one = one * (1.0f - probability) + none * probability;
+         none *= 1.0f - probability;
+      }
+      noneOfNumber[number] = none;
+      noneOrOne[number] = none + one;
+   }
+
+   for (int suit = 0; suit < SUITS; suit++)
+   {
+      const float *row = held[suit] + 2;
+      float *out = completion + suit * NUMBERS;
+      for (int number = 0; number < NUMBERS; number++)
+      {
+         float noRun = (1.0f - row[number - 2] * row[number - 1]) * (1.0f - row[number - 1] * row[number + 1])
+            * (1.0f - row[number + 1] * row[number + 2]);
+         float noNeighbour = (1.0f - row[number - 2]) * (1.0f - row[number - 1]) * (1.0f - row[number + 1]) * (1.0f - row[number + 2]);
+         float noPartner = 1.0f - (1.0f - noneOfNumber[number] * noNeighbour) * (1.0f - noWild);
+         out[number] = 1.0f - noneOrOne[number] * noRun * noPartner;
+      }
+   }
+
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      if (isWild(id))
+      {
+         completion[id] = 1.0f;
+      }
+   }
+}
+
+/* *********************************************************************
+Function Name: isWild()
+Purpose: Check if a card is wild in the round
+Parameters:
+         int id, the card's id
+Return Value: a bool, true for jokers and cards of the wild number
+Local Variables:
+         none
+Algorithm:
+         1) Check for a joker or the round's wild number (round + 2,
+            which is number index round - 1 since numbers start at 3)
+Assistance Received: none
+********************************************************************* */
+bool OpponentModel::isWild(int id) const
+{
+   return id >= Card::FIRST_JOKER_ID || id % NUMBERS == this->round + Card::getWildCardOffset() - 3;
+}
+
+/* *********************************************************************
+Function Name: reweigh()
+Purpose: Scale the weights of the cards going with a card
+Parameters:
+         int id, the card
+         float factor, what to scale by
+Return Value: none
+Local Variables:
+         int suit, the card's suit
+         int number, its number
+         float half, the factor for cards two away in the suit
+Algorithm:
+         1) Wild cards say nothing about the rest of the hand
+         2) Scale the other natural cards of the same number, and the
+            cards one away in the suit, by factor
+         3) Scale the cards two away in the suit by half as much
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::reweigh(int id, float factor)
+{
+   if (isWild(id))
+   {
+      return;
+   }
+
+   int suit = id / NUMBERS;
+   int number = id % NUMBERS;
+   float half = 1.0f + (factor - 1.0f) / 2;
+
+   for (int other = 0; other < SUITS; other++)
+   {
+      if (other != suit)
+      {
+         scale(other * NUMBERS + number, factor);
+      }
+   }
+
+   for (int distance = 1; distance <= 2; distance++)
+   {
+      float by = distance == 1 ? factor : half;
+      if (number - distance >= 0)
+      {
+         scale(id - distance, by);
+      }
+      if (number + distance < NUMBERS)
+      {
+         scale(id + distance, by);
+      }
+   }
+}
+
+/* *********************************************************************
+Function Name: scale()
+Purpose: Scale the weight of a card
+Parameters:
+         int id, the card
+         float factor, what to scale by
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Wild cards keep their weight
+         2) Scale and keep the weight within its limits
+Assistance Received: none
+********************************************************************* */
+void OpponentModel::scale(int id, float factor)
+{
+   if (isWild(id))
+   {
+      return;
+   }
+
+   this->weight[id] = std::min(std::max(this->weight[id] * factor, LEAST_WEIGHT), MOST_WEIGHT);
+}
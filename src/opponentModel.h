@@ -0,0 +1,93 @@
+#ifndef OPPONENTMODEL_H
+#define OPPONENTMODEL_H
+
+#include "hand.h"
+#include <vector>
+
+// Keeps track of what the other player is likely to hold from what they do.
+// Cards they take from the discard pile are known to be in their hand, and
+// make cards that go with them (the same number, or nearby in the suit) more
+// likely; cards they throw away make those less likely. The rest of their
+// hand is spread over the cards that can't be seen, in proportion to those
+// weights. Every update touches a handful of weights, so it takes well under
+// a microsecond.
+class OpponentModel
+{
+   public:
+      OpponentModel() = default;
+
+      // Start a round (or a loaded game): the other player holds handSize
+      // cards and the discard pile (ids) is face up
+      void startRound(int round, int handSize, const std::vector<int> &discardPile);
+
+      // The other player drew from the deck
+      void opponentDrewDeck();
+
+      // The other player took card id from the top of the discard pile
+      void opponentTookDiscard(int id);
+
+      // The other player threw card id away
+      void opponentDiscarded(int id);
+
+      // The player the model is for took card id from the discard pile
+      void tookDiscard(int id);
+
+      // The player the model is for threw card id away
+      void discarded(int id);
+
+      // Check if the other player took from the discard pile on their last turn
+      bool tookDiscardLastTurn() const;
+
+      // Fill copies with the number of each card id the other player is
+      // expected to hold, given the hand of the player the model is for
+      void expectedCopies(const Hand &ownHand, float copies[Card::NUMBER_OF_IDS]) const;
+
+      // Fill benefit with the number of the other player's cards each card id
+      // is expected to go with in a book or run if it's thrown away. Wild
+      // cards go with anything, so they're worth their whole hand
+      void discardBenefits(const Hand &ownHand, float benefit[Card::NUMBER_OF_IDS]) const;
+
+      // Fill completion with the probability that each card id, if thrown
+      // away, completes a book or run with cards the other player holds: two
+      // natural cards that go with it, or one and a wild card. Wild cards
+      // go with anything, so they're taken to always complete one
+      void completionProbabilities(const Hand &ownHand, float completion[Card::NUMBER_OF_IDS]) const;
+
+   private:
+      static const int COPIES_OF_EACH_CARD = 2;
+      static const int SUITS = Card::NUMBER_OF_SUITS;
+      static const int NUMBERS = Card::NUMBER_OF_NUMBERS;
+
+      // How much taking a card raises the weight of cards going with it, and
+      // throwing one away lowers it. Cards two apart in a suit change half as much
+      static constexpr float TAKEN = 1.5f;
+      static constexpr float THROWN = 0.75f;
+
+      // Limits on a weight, so a long game can't make a card certain or impossible
+      static constexpr float LEAST_WEIGHT = 0.1f;
+      static constexpr float MOST_WEIGHT = 10.0f;
+
+      // Check if a card is wild in the round
+      bool isWild(int id) const;
+
+      // Scale the weights of the cards going with card id by factor
+      void reweigh(int id, float factor);
+
+      // Scale one weight, keeping it within its limits
+      void scale(int id, float factor);
+
+      int round = 1;
+      int handSize = 0;
+
+      // Weight of each card id being in the unknown part of the hand
+      float weight[Card::NUMBER_OF_IDS] = { 0 };
+
+      // Copies of each card id known to be in the hand, and face up in the
+      // discard pile
+      unsigned char held[Card::NUMBER_OF_IDS] = { 0 };
+      unsigned char faceUp[Card::NUMBER_OF_IDS] = { 0 };
+
+      bool tookDiscardLast = false;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>   // std::min
+#include <atomic>      // std::atomic
+#include <thread>      // std::thread
+#include <vector>
+
+// Number of threads to use when none is asked for: one per core
+inline unsigned defaultThreadCount()
+{
+   unsigned cores = std::thread::hardware_concurrency();
+   return cores == 0 ? 1 : cores;
+}
+
+// Call work(i) for every i from 0 to count - 1 spread across threads.
+// Each thread takes the next index from a shared counter so uneven work
+// stays balanced. work must be safe to call from several threads at once.
+template <typename Work>
+void parallelFor(size_t count, Work work, unsigned threads = 0)
+{
+   if (threads == 0)
+   {
+      threads = defaultThreadCount();
+   }
+   threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+
+   std::atomic<size_t> next(0);
+   auto worker = [&]()
+   {
+      for (size_t i = next++; i < count; i = next++)
+      {
+         work(i);
+      }
+   };
+
+   // Run on this thread when there's nothing to split
+   if (threads <= 1)
+   {
+      worker();
+      return;
+   }
+
+   std::vector<std::thread> pool;
+   pool.reserve(threads - 1);
+   for (unsigned i = 1; i < threads; i++)
+   {
+      pool.emplace_back(worker);
+   }
+   worker();
+
+   for (std::thread &thread : pool)
+   {
+      thread.join();
+   }
+}
+
+#endif
@@ -30,7 +30,7 @@ std::string Player::serialize() const
    
    // Add each card in the hand to the player string
    playerString += "   Hand: ";
-   for (Card card : hand)
+   for (const Card &card : hand)
    {
       playerString += card.toString() + " ";
    }
@@ -40,17 +40,32 @@ std::string Player::serialize() const
 
 /* *********************************************************************
 Function Name: setHand()
-Purpose: To add a specified card to the player's hand
+Purpose: To set the player's hand to the cards passed in
 Parameters:
-         None
+         const vector<Card> &cards, the cards to set the hand to
 Local Variables: None
 Algorithm:
-         1) Push the card passed in to the player's hand
+         1) Copy the cards passed in to the player's hand
 Assistance Received: none
 ********************************************************************* */
-void Player::setHand(std::vector<Card> cards)
+void Player::setHand(const std::vector<Card> &cards)
 {
-   this->hand = cards;
+   this->hand = Hand(cards);
+}
+
+/* *********************************************************************
+Function Name: setHand()
+Purpose: To set the player's hand to a copy of the hand passed in
+Parameters:
+         const Hand &hand, the hand to copy
+Local Variables: None
+Algorithm:
+         1) Copy the hand passed in to the player's hand
+Assistance Received: none
+********************************************************************* */
+void Player::setHand(const Hand &hand)
+{
+   this->hand = hand;
 }
 
 /* *********************************************************************
@@ -65,7 +80,7 @@ Assistance Received: none
 ********************************************************************* */
 void Player::addToHand(Card card)
 {
-   this->hand.push_back(card);
+   this->hand.add(card);
 }
 
 /* *********************************************************************
@@ -120,7 +135,7 @@ Assistance Received: none
 ********************************************************************* */
 void Player::printHand()
 {
-   for (size_t i = 0; i < this->hand.size(); i++)
+   for (int i = 0; i < this->hand.size(); i++)
    {
       std::cout << this->hand[i].toString() << " ";
    }
@@ -148,14 +163,14 @@ Function Name: getHand()
 Purpose: Returns player's current hand
 Parameters:
          none
-Return Value: a const vector<Card>, the cards in the player's hand
+Return Value: a const reference to Hand, the cards in the player's hand
 Local Variables:
          none
 Algorithm:
          1) Return the player's hand member variable
 Assistance Received: none
 ********************************************************************* */
-std::vector<Card> Player::getHand() const
+const Hand& Player::getHand() const
 {
    return this->hand;
 }
@@ -198,27 +213,25 @@ void Player::setTopOfDiscard(Card card)
 Function Name: findIndexInHand()
 Purpose: Find the index the card exists in
 Parameters:
-         string card, the card we are finding the index of
+         const string &card, the card we are finding the index of
 Return Value: an int, representing the index of where 
    the card passed in exists
 Local Variables:
-         none
+         int index, the index of the card in the hand
 Algorithm:
-         1) Set the topOfDiscard member variable to the card passed in
+         1) Convert the card to its id
+         2) Look up the index of the id in the hand
+         3) If it's not there, tell the player and return -1
 Assistance Received: none
 ********************************************************************* */
-int Player::findIndexInHand(std::string card)
+int Player::findIndexInHand(const std::string &card)
 {
-   for (size_t i = 0; i < this->hand.size(); i++)
-   {
-      std::string name = this->hand[i].toString();
-      
-      // If the card is found
-      if (card == name)
-      {
-         return i;
-      }
+   int index = this->hand.indexOf(Card::idFromString(card));
 
+   // If the card is found
+   if (index != -1)
+   {
+      return index;
    }
 
    // If not found
@@ -236,25 +249,23 @@ Return Value: a Card, the card that was discarded
 Local Variables:
          none
 Algorithm:
-         1) Get the card to discard by accessing the index in the hand
-         2) Erase the card at the index
-         3) Return the card we removed
+         1) Remove the card at the index from the hand; the last card
+            in the hand takes its place
+         2) Return the card we removed
 Assistance Received: none
 ********************************************************************* */
 Card Player::discardCard(int indexOfCard)
 {
    try
    {
-      Card discardCard = this->hand[indexOfCard];
-      this->hand.erase(this->hand.begin() + indexOfCard);
-
-      return discardCard;
+      return this->hand.removeAt(indexOfCard);
    }
    catch (const std::out_of_range& oor)
    {
       std::cerr << "Out of Range error: " << oor.what() << '\n';
    }
    
+   return Card();
 }
 
 /* *********************************************************************
@@ -313,25 +324,19 @@ void Player::setPlayerScore(int score)
 Function Name: updatePlayerScore()
 Purpose: Update (add to) player's score
 Parameters:
-         vector<Card> remainingCards, the cards remaining after creating
-            books and runs
+         const MeldResult &result, the arrangement of the hand after
+            creating books and runs
 Return Value: none
 Local Variables:
          int roundScore, the score for the current round
 Algorithm:
-         1) Loop through the remaining cards
-         2) Add each card's value to the score for the round
-         3) Add total to the player's member variable score
+         1) Get the value of the deadwood cards for the round
+         2) Add it to the player's member variable score
 Assistance Received: none
 ********************************************************************* */
-void Player::updatePlayerScore(std::vector<Card> remainingCards)
+void Player::updatePlayerScore(const MeldResult &result)
 {
-   int roundScore = 0;
-
-   for (Card card : remainingCards)
-   {
-      roundScore += card.getValue();
-   }
+   int roundScore = result.deadwoodScore;
 
    std::cout << this->toString() << "'s score for the round: " << roundScore << "\n";
    
@@ -379,68 +384,60 @@ std::vector<Card> Player::sortCards(std::vector<Card> cards)
 }
 
 /* *********************************************************************
-Function Name: bestOrder()
-Purpose: Find the best order to find combinations in
+Function Name: bestArrangement()
+Purpose: Find combinations in the best order and return the arrangement
 Parameters:
-         vector<Card> cards, the cards to sort
-Return Value: a CombinationFinder::order, an enum with the order we 
-   should create combinations
+         const vector<Card> &cards, the cards to make combinations from
+Return Value: a CombinationFinder, holding the books, runs, and remaining
+   cards made in the best order
 Local Variables:
-         CombinationFinder finderBooks, finds the single cards remaining
-            after making books first and then runs
-         CombinationFinder finderRuns, finds the single cards remaining
-            after making runs first and then books
-         int singlesWithBook, single cards remaining after making books first
-         int singlesWithRun, single cards remaining after making runs first
+         CombinationFinder finder, builds the table once and evaluates
+            both books first and runs first from it
 Algorithm:
-         1) Find books and then runs
-         2) Get single cards remaining
-         3) Find runs and then books
-         4) Get single cards remaining
-         5) Compare the number of single cards in both approaches
-         6) If there are less single cards using books first, 
-            return enum indicating to make books first
-         7) If there are more single cards using books first,
-            return enum indicating to make runs first
-         8) If they are equal, make runs first 
+         1) Build the table from the cards
+         2) Find combinations books first and runs first from the same
+            table, keeping the one with less single cards
+            (runs first if they are equal)
+         3) Return the finder holding that arrangement
 Assistance Received: none
 ********************************************************************* */
-CombinationFinder::Order Player::bestOrder(std::vector<Card> cards)
+CombinationFinder Player::bestArrangement(const std::vector<Card> &cards)
 {
-   // Make books first and get single cards
-   CombinationFinder finderBooks;
-   finderBooks.findCombinations(CombinationFinder::Order::BOOKS_FIRST);
-   int singlesWithBook = finderBooks.getNumberOfSingleCards();
-
-   // Make runs first and get single cards
-   CombinationFinder finderRuns;
-   finderRuns.findCombinations(CombinationFinder::Order::RUNS_FIRST);
-   int singlesWithRun = finderRuns.getNumberOfSingleCards();
-
-   // If there are less single cards with books than run, make books first
-   if (singlesWithBook < singlesWithRun)
-   {
-      return CombinationFinder::Order::BOOKS_FIRST;
-   }
-   // If there are more single cards with books than run, make runs first
-   else if (singlesWithBook > singlesWithRun)
-   {
-      return CombinationFinder::Order::RUNS_FIRST;
-   }
-   // If there are an equal number of single cards, choose runs
-   else
-   {
-      return CombinationFinder::Order::RUNS_FIRST;
-   }
+   CombinationFinder finder(cards);
+   finder.findBestCombinations();
+
+   return finder;
+}
+
+/* *********************************************************************
+Function Name: bestArrangement()
+Purpose: Find combinations in the best order for the cards in a hand
+Parameters:
+         const Hand &hand, the hand to make combinations from
+Return Value: a CombinationFinder, holding the books, runs, and remaining
+   cards made in the best order
+Local Variables:
+         CombinationFinder finder, builds the table once and evaluates
+            both books first and runs first from it
+Algorithm:
+         1) Build the table from the hand
+         2) Find combinations in the best order
+         3) Return the finder holding that arrangement
+Assistance Received: none
+********************************************************************* */
+CombinationFinder Player::bestArrangement(const Hand &hand)
+{
+   CombinationFinder finder(hand);
+   finder.findBestCombinations();
+
+   return finder;
 }
 
 // Check if player can go out
 // A player can go out if all the cards in the hand can be arranged in books and runs
 bool Player::goOut()
 {
-   CombinationFinder finder(this->hand);
-   CombinationFinder::Order order = bestOrder(this->hand);
-   finder.findCombinations(order);
+   CombinationFinder finder = bestArrangement(this->hand);
 
    //TEMP
    //std::vector<Card> wildCardsLeft = finder.getRemainingWilds();
@@ -449,8 +446,7 @@ bool Player::goOut()
    {
       std::cout << "\n";
       std::cout << this->toString() << " went out!\n";
-      this->books = finder.getBooks();
-      this->runs = finder.getRuns();
+      this->melds = finder.takeResult();
 
       std::cout << this->toString() << "'s books and runs:\n";
       displayBooksAndRuns();
@@ -476,28 +472,28 @@ void Player::resetGoneOutStatus()
 // Display all books and runs made after going out
 void Player::displayBooksAndRuns()
 {
-   if (this->books.size() > 0)
+   if (this->melds.books.size() > 0)
    {
       std::cout << "Books:\n";
    }
 
-   for (auto book : books)
+   for (const auto &book : this->melds.books)
    {
-      for (auto card : book)
+      for (const auto &card : book)
       {
          std::cout << card << " ";
       }
       std::cout << "\n";
    }
 
-   if (this->runs.size() > 0)
+   if (this->melds.runs.size() > 0)
    {
       std::cout << "Runs:\n";
    }
 
-   for (auto run : runs)
+   for (const auto &run : this->melds.runs)
    {
-      for (auto card : run)
+      for (const auto &card : run)
       {
          std::cout << card << " ";
       }
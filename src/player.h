@@ -3,6 +3,7 @@
 
 #include "card.h"
 #include "combinationFinder.h"
+#include "hand.h"
 #include <vector>
 #include <algorithm> // std::sort
 #include <iostream>
@@ -44,7 +45,10 @@ class Player
       friend std::ostream& operator<<(std::ostream& os, const Player& deck);
 
       // Set the player's hand
-      void setHand(std::vector<Card> cards);
+      void setHand(const std::vector<Card> &cards);
+
+      // Set the player's hand to a copy of the hand passed in
+      void setHand(const Hand &hand);
 
       // Add single card to player hand
       void addToHand(Card card);
@@ -62,7 +66,7 @@ class Player
       void printDiscard();
       
       // Get the players current hand
-      std::vector<Card> getHand() const;
+      const Hand& getHand() const;
 
       // Get the players top of discard card
       Card getDiscardCard() const;
@@ -72,7 +76,7 @@ class Player
 
       // Find whether or not the card exists in players hand and return the index
       // returns -1 if not found
-      int findIndexInHand(std::string card);
+      int findIndexInHand(const std::string &card);
 
       // Discard the card from hand and set it to the top of the discard pile
       Card discardCard(int card);
@@ -87,8 +91,8 @@ class Player
       // Set player's score
       void setPlayerScore(int score);
 
-      // Update (add to) player's score
-      void updatePlayerScore(std::vector<Card> remainingCards);
+      // Update (add to) player's score with the deadwood left after making combinations
+      void updatePlayerScore(const MeldResult &result);
 
       // Sort the cards passed in
       std::vector<Card> sortCards(std::vector<Card> cards);
@@ -103,21 +107,22 @@ class Player
       // Reset player's gone out status
       void resetGoneOutStatus();
 
-      // Returns an enum with the order we should create combinations 
-      CombinationFinder::Order bestOrder(std::vector<Card> cards);
+      // Find combinations in the best order (books or runs first) and
+      // return the finder holding that arrangement
+      static CombinationFinder bestArrangement(const std::vector<Card> &cards);
+
+      // Find combinations in the best order for the cards in a hand
+      static CombinationFinder bestArrangement(const Hand &hand);
 
       // Display all books and runs made after going out
       void displayBooksAndRuns();
 
    protected:
       // The cards in the players hand
-      std::vector<Card> hand;
+      Hand hand;
 
-      // The books the player made when going out
-      std::vector<std::vector<Card>> books;
-      
-      // The runs the player made when going out
-      std::vector<std::vector<Card>> runs;
+      // The books and runs the player made when going out
+      MeldResult melds;
 
       // The game options the players can make
       enum class gameOption {
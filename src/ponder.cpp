@@ -0,0 +1,209 @@
+#include "ponder.h"
+#include "computer.h"   // Computer::chooseDraw(), Computer::chooseDiscard()
+#include <algorithm>    // std::fill
+
+/* *********************************************************************
+Function Name: ~Ponder()
+Purpose: Stop the worker before the replies go away
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Stop the worker
+Assistance Received: none
+********************************************************************* */
+Ponder::~Ponder()
+{
+   stop();
+}
+
+/* *********************************************************************
+Function Name: start()
+Purpose: Start working out the computer's replies on a worker thread
+Parameters:
+         const Hand &hand, the computer's hand
+         int round, the round (to know the wild card)
+         Difficulty difficulty, how long to think about each reply
+         const Strategy &strategy, the parameters of the rule of thumb
+         const vector<int> &likelyCards, ids of the cards the human is
+            likely to discard
+         const OpponentModel &opponent, what the human is likely to hold
+Return Value: none
+Local Variables:
+         bool queued[], whether each card id is in the order yet
+Algorithm:
+         1) Stop any earlier search and forget its replies
+         2) Order the likely cards first, then every other card
+         3) Start the worker
+Assistance Received: none
+********************************************************************* */
+void Ponder::start(const Hand &hand, int round, Difficulty difficulty, const Strategy &strategy,
+   const std::vector<int> &likelyCards, const OpponentModel &opponent)
+{
+   stop();
+
+   this->hand = hand;
+   this->opponent = opponent;
+   this->round = round;
+   this->difficulty = difficulty;
+   this->strategy = strategy;
+   std::fill(std::begin(this->found), std::end(this->found), false);
+
+   bool queued[Card::NUMBER_OF_IDS] = { false };
+   this->order.clear();
+   for (int id : likelyCards)
+   {
+      if (id >= 0 && id < Card::NUMBER_OF_IDS && !queued[id])
+      {
+         queued[id] = true;
+         this->order.push_back(id);
+      }
+   }
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      if (!queued[id])
+      {
+         this->order.push_back(id);
+      }
+   }
+
+   this->stopping = false;
+   this->worker = std::thread(&Ponder::work, this);
+}
+
+/* *********************************************************************
+Function Name: stop()
+Purpose: Stop working out replies and wait for the worker
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Tell the worker to stop, it checks between cards
+         2) Wait for it to finish
+Assistance Received: none
+********************************************************************* */
+void Ponder::stop()
+{
+   this->stopping = true;
+   if (this->worker.joinable())
+   {
+      this->worker.join();
+   }
+}
+
+/* *********************************************************************
+Function Name: find()
+Purpose: Get the reply worked out for a hand and top of the discard pile
+Parameters:
+         const Hand &hand, the computer's hand
+         const Card &topOfDiscard, the card on top of the discard pile
+         PonderedReply &reply, set to the reply if it was found
+Return Value: a bool, true if the reply was worked out
+Local Variables:
+         int id, the id of the top of the discard pile
+Algorithm:
+         1) The hand must be the one the replies were worked out for
+         2) Look up the reply for the card
+Assistance Received: none
+********************************************************************* */
+bool Ponder::find(const Hand &hand, const Card &topOfDiscard, PonderedReply &reply) const
+{
+   int id = topOfDiscard.getId();
+   if (id < 0 || hand.size() != this->hand.size())
+   {
+      return false;
+   }
+
+   for (int i = 0; i < hand.size(); i++)
+   {
+      if (hand[i].getId() != this->hand[i].getId())
+      {
+         return false;
+      }
+   }
+
+   std::lock_guard<std::mutex> lock(this->mutex);
+   if (!this->found[id])
+   {
+      return false;
+   }
+
+   reply = this->replies[id];
+   return true;
+}
+
+/* *********************************************************************
+Function Name: work()
+Purpose: Work out the computer's reply to each card in order
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         Card top, the card on top of the discard pile
+         PonderedReply reply, the reply to it
+         pair<bool, string> drawAndReason, whether to draw it and why
+         Hand drawn, the hand after drawing it
+         OpponentModel model, what the human is likely to hold by then
+Algorithm:
+         1) Until told to stop, for each card (besides ones the hand
+            holds both copies of) decide whether the computer draws it,
+            the way Computer::move() does
+         2) If it does, find the card it would discard from the hand with
+            it, the way Computer::getCardToDiscard() does, with the model
+            updated as it would be if the human drew from the deck
+         3) Store the reply, unless it was cut short by stopping
+Assistance Received: none
+********************************************************************* */
+void Ponder::work()
+{
+   for (int id : this->order)
+   {
+      if (this->stopping)
+      {
+         return;
+      }
+
+      // Both copies of the card are in the hand, so it can't be discarded
+      if (this->hand.count(id) >= 2)
+      {
+         continue;
+      }
+
+      Card top = Card::fromId(id, this->round);
+      PonderedReply reply;
+      std::pair<bool, std::string> drawAndReason = Computer::chooseDraw(this->hand, top, this->difficulty, &this->stopping, this->strategy);
+      reply.drawDiscard = drawAndReason.first;
+      reply.drawReason = drawAndReason.second;
+
+      if (reply.drawDiscard)
+      {
+         Hand drawn = this->hand;
+         drawn.add(top);
+
+         // What the computer will know when it discards, if the human
+         // drew from the deck and threw the card away
+         OpponentModel model = this->opponent;
+         model.opponentDrewDeck();
+         model.opponentDiscarded(id);
+         model.tookDiscard(id);
+
+         // The card under it isn't known yet
+         std::pair<std::string, std::string> worstCardAndReason = Computer::chooseDiscard(drawn, Card(), this->difficulty, &this->stopping, &model);
+         reply.discard = worstCardAndReason.first;
+         reply.reason = worstCardAndReason.second;
+      }
+
+      if (this->stopping)
+      {
+         return;
+      }
+
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->replies[id] = reply;
+      this->found[id] = true;
+   }
+}
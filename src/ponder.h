@@ -0,0 +1,79 @@
+#ifndef PONDER_H
+#define PONDER_H
+
+#include "anytimeSearch.h"   // Difficulty
+#include "hand.h"
+#include "opponentModel.h"
+#include "strategy.h"
+#include <atomic>      // std::atomic
+#include <mutex>       // std::mutex
+#include <string>
+#include <thread>      // std::thread
+#include <vector>
+
+// The computer's reply to one card on top of the discard pile
+struct PonderedReply
+{
+   bool drawDiscard = false;
+   std::string drawReason;
+
+   // The card it discards after drawing from the discard pile, and why
+   // (empty when it draws from the deck, since that card isn't known yet)
+   std::string discard;
+   std::string reason;
+};
+
+// Works out the computer's replies on a worker thread while the human is
+// deciding, one for each card the human could leave on top of the discard
+// pile, so the computer's turn can be answered from them. The likely cards
+// are worked out first and the worker stops as soon as it is told to.
+class Ponder
+{
+   public:
+      Ponder() = default;
+
+      // Stops the worker
+      ~Ponder();
+
+      Ponder(const Ponder &) = delete;
+      Ponder& operator=(const Ponder &) = delete;
+
+      // Start working out replies for the hand at a difficulty (drawing by
+      // the strategy's rule of thumb when there's no budget), the cards in
+      // likelyCards (ids) first and then every other card. Discards count
+      // what opponent thinks the human holds once they've drawn from the deck
+      // and thrown the card away. Stops any earlier search
+      void start(const Hand &hand, int round, Difficulty difficulty, const Strategy &strategy,
+         const std::vector<int> &likelyCards, const OpponentModel &opponent);
+
+      // Stop working out replies and wait for the worker
+      void stop();
+
+      // Get the reply for the hand with the card on top of the discard pile
+      // Returns false if it wasn't worked out (or was for another hand)
+      bool find(const Hand &hand, const Card &topOfDiscard, PonderedReply &reply) const;
+
+   private:
+      // Work out replies in order until done or told to stop
+      void work();
+
+      std::thread worker;
+      std::atomic<bool> stopping{ false };
+
+      // Guards found and replies while the worker fills them
+      mutable std::mutex mutex;
+
+      // The hand and round the replies are for, and the cards to try in order
+      Hand hand;
+      int round = 0;
+      Difficulty difficulty = Difficulty::HEURISTIC;
+      Strategy strategy;
+      OpponentModel opponent;
+      std::vector<int> order;
+
+      // Whether the reply to each card id has been worked out, and the reply
+      bool found[Card::NUMBER_OF_IDS] = { false };
+      PonderedReply replies[Card::NUMBER_OF_IDS];
+};
+
+#endif
@@ -0,0 +1,132 @@
+/************************************************************
+* Replays recorded games (journals written by the game) through the
+* rules to check every action and score each round again.
+*
+* Usage: replay [-j threads] [-q] [-c cache] journal...
+*    -j threads   number of threads to use (default: one per core)
+*    -q           only print games that broke the rules or scored
+*                 differently, and the summary
+*    -c cache     save the hands evaluated that the evaluation cache
+*                 didn't have to cache, for cachemerge
+************************************************************/
+
+#include "replayEngine.h"
+#include "evaluationCache.h"
+#include "parallel.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+   unsigned threads = 0;
+   bool quiet = false;
+   std::string cacheFile;
+   std::vector<std::string> files;
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if (argument == "-j" && i + 1 < argc)
+      {
+         threads = std::atoi(argv[++i]);
+      }
+      else if (argument == "-q")
+      {
+         quiet = true;
+      }
+      else if (argument == "-c" && i + 1 < argc)
+      {
+         cacheFile = argv[++i];
+      }
+      else
+      {
+         files.push_back(argument);
+      }
+   }
+
+   if (files.empty())
+   {
+      std::cerr << "Usage: " << argv[0] << " [-j threads] [-q] [-c cache] journal...\n";
+      return EXIT_FAILURE;
+   }
+
+   EvaluationCache &cache = EvaluationCache::shared();
+   cache.setRecording(!cacheFile.empty());
+
+   // Replay every game, each thread with its own engine
+   std::vector<ReplayResult> results(files.size());
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+   parallelFor(files.size(), [&](size_t i)
+   {
+      // A journal the engine can't handle fails its game, not the run
+      try
+      {
+         ReplayEngine engine;
+         results[i] = engine.replayFile(files[i]);
+      }
+      catch (const std::exception &exception)
+      {
+         results[i] = ReplayResult();
+         results[i].legal = false;
+         results[i].error = std::string("replay failed: ") + exception.what();
+      }
+   }, threads);
+
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+   // Print each game and the totals
+   long long actions = 0;
+   int illegalGames = 0;
+   int rescoredGames = 0;
+   for (size_t i = 0; i < files.size(); i++)
+   {
+      const ReplayResult &result = results[i];
+      actions += result.actions;
+      illegalGames += !result.legal;
+      rescoredGames += result.scoreMismatches > 0;
+
+      if (quiet && result.legal && result.scoreMismatches == 0)
+      {
+         continue;
+      }
+
+      std::cout << files[i] << ": " << (result.legal ? "legal" : "ILLEGAL") << ", seed " << result.seed
+         << ", " << result.rounds << " rounds, " << result.actions << " actions, recorded "
+         << result.recordedScores[0] << "-" << result.recordedScores[1] << ", replayed "
+         << result.replayedScores[0] << "-" << result.replayedScores[1];
+
+      if (result.scoreMismatches > 0)
+      {
+         std::cout << ", " << result.scoreMismatches << " rounds scored differently";
+      }
+
+      if (!result.legal)
+      {
+         std::cout << "\n   " << result.error;
+      }
+
+      std::cout << "\n";
+   }
+
+   std::cout << files.size() << " games, " << actions << " actions, " << illegalGames << " illegal, "
+      << rescoredGames << " scored differently in " << elapsed.count() << " s ("
+      << (elapsed.count() > 0 ? actions / elapsed.count() : 0) << " actions/s)\n";
+
+   if (!cacheFile.empty())
+   {
+      if (cache.saveRecorded(cacheFile))
+      {
+         std::cerr << "Could not write " << cacheFile << "\n";
+         return EXIT_FAILURE;
+      }
+      std::cout << "Saved " << cache.recordedSize() << " evaluations to " << cacheFile << "\n";
+   }
+
+   return illegalGames == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
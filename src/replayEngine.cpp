@@ -0,0 +1,410 @@
+#include "replayEngine.h"
+#include "gameFile.h"
+#include <fstream>
+#include <sstream>
+
+/* *********************************************************************
+Function Name: replayGame()
+Purpose: Replay a recorded game through the rules
+Parameters:
+         string_view journal, the contents of the game's journal
+Return Value: a ReplayResult, whether the game was legal and its scores
+Local Variables:
+         JournalReader reader, decodes the records of the journal
+         Journal::Record type, the type of the current record
+         string_view payload, the bytes of the current record
+         bool fail, whether the current record broke the rules
+Algorithm:
+         1) Clear anything from the last game
+         2) Decode each record and apply it to the state, checking it
+            follows the rules
+         3) Stop at the first record that breaks the rules
+Assistance Received: none
+********************************************************************* */
+ReplayResult ReplayEngine::replayGame(std::string_view journal)
+{
+   *this = ReplayEngine();
+
+   JournalReader reader;
+   if (reader.load(journal))
+   {
+      illegal(reader.getError());
+      return this->result;
+   }
+
+   while (!reader.atEnd())
+   {
+      Journal::Record type;
+      std::string_view payload;
+      if (reader.readRecord(type, payload))
+      {
+         illegal(reader.getError());
+         break;
+      }
+
+      bool fail = false;
+      switch (type)
+      {
+         case Journal::Record::SEED:
+            this->result.seed = JournalReader::readNumber(payload, 0, 4);
+            break;
+
+         case Journal::Record::STATE:
+            fail = startRound(payload.substr(2));
+            break;
+
+         case Journal::Record::DRAW_DECK:
+            fail = drawDeck();
+            break;
+
+         case Journal::Record::DRAW_DISCARD:
+            fail = drawDiscard();
+            break;
+
+         case Journal::Record::DISCARD:
+            fail = discard(static_cast<unsigned char>(payload[0]));
+            break;
+
+         case Journal::Record::ROUND_END:
+            fail = endRound(JournalReader::readNumber(payload, 0, 2), JournalReader::readNumber(payload, 2, 2));
+            break;
+
+         default:
+            break;
+      }
+
+      if (fail)
+      {
+         break;
+      }
+   }
+
+   return this->result;
+}
+
+/* *********************************************************************
+Function Name: replayFile()
+Purpose: Read a journal file and replay it
+Parameters:
+         const string &fileName, the journal file
+Return Value: a ReplayResult, whether the game was legal and its scores
+Local Variables:
+         ifstream file, the journal file
+         ostringstream contents, the contents of the file
+Algorithm:
+         1) Read the whole file
+         2) Replay it
+Assistance Received: none
+********************************************************************* */
+ReplayResult ReplayEngine::replayFile(const std::string &fileName)
+{
+   std::ifstream file(fileName, std::ios::binary);
+   if (!file)
+   {
+      *this = ReplayEngine();
+      illegal("could not open " + fileName);
+      return this->result;
+   }
+
+   std::ostringstream contents;
+   contents << file.rdbuf();
+
+   return replayGame(contents.str());
+}
+
+/* *********************************************************************
+Function Name: startRound()
+Purpose: Start a round from the state recorded after the deal (or when
+   a game was loaded)
+Parameters:
+         string_view snapshot, the GameFile snapshot of the state
+Return Value: a bool, true if the state breaks the rules
+Local Variables:
+         GameFile state, the state in the snapshot
+         int copies[], the number of each card in the state
+         int recordedScores[], the scores in the state
+Algorithm:
+         1) The last round must have been scored
+         2) Load the snapshot
+         3) Make sure there are no more than two of any card
+         4) After the first state, the round must follow the last one,
+            each hand must hold round + 2 cards, and the scores must be
+            the recorded ones
+         5) Set the hands and piles
+Assistance Received: none
+********************************************************************* */
+bool ReplayEngine::startRound(std::string_view snapshot)
+{
+   if (this->inRound)
+   {
+      return illegal("new deal before round " + std::to_string(this->roundNumber) + " was scored");
+   }
+
+   GameFile state;
+   if (state.parseSnapshot(snapshot))
+   {
+      return illegal(state.getError());
+   }
+
+   int copies[Card::NUMBER_OF_IDS] = { 0 };
+   for (const Card &card : state.getComputerHand())
+   {
+      copies[card.getId()]++;
+   }
+   for (const Card &card : state.getHumanHand())
+   {
+      copies[card.getId()]++;
+   }
+   for (const Card &card : state.getDrawPile())
+   {
+      copies[card.getId()]++;
+   }
+   for (const Card &card : state.getDiscardPile())
+   {
+      copies[card.getId()]++;
+   }
+
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      if (copies[id] > COPIES_OF_EACH_CARD)
+      {
+         return illegal("more than two " + Card::fromId(id, state.getGameRound()).toString() + " in the deal");
+      }
+   }
+
+   int recordedScores[PLAYER_COUNT] = { state.getComputerScore(), state.getHumanScore() };
+
+   // The first state can be a loaded game, every other one is a new deal
+   if (this->roundNumber == 0)
+   {
+      this->result.replayedScores[0] = recordedScores[0];
+      this->result.replayedScores[1] = recordedScores[1];
+   }
+   else
+   {
+      if (state.getGameRound() != this->roundNumber + 1)
+      {
+         return illegal("round " + std::to_string(state.getGameRound()) + " dealt after round " + std::to_string(this->roundNumber));
+      }
+
+      if (state.getComputerHand().size() != state.getGameRound() + Card::getWildCardOffset()
+         || state.getHumanHand().size() != state.getGameRound() + Card::getWildCardOffset())
+      {
+         return illegal("wrong number of cards dealt in round " + std::to_string(state.getGameRound()));
+      }
+
+      if (recordedScores[0] != this->result.recordedScores[0] || recordedScores[1] != this->result.recordedScores[1])
+      {
+         return illegal("scores changed between rounds");
+      }
+   }
+
+   this->result.recordedScores[0] = recordedScores[0];
+   this->result.recordedScores[1] = recordedScores[1];
+
+   this->roundNumber = state.getGameRound();
+   this->playerToMove = state.getNextPlayer();
+   this->hands[0] = state.getComputerHand();
+   this->hands[1] = state.getHumanHand();
+   this->round = Round(state.getDrawPile(), state.getDiscardPile());
+
+   this->inRound = true;
+   this->hasDrawn = false;
+   this->goneOutCount = 0;
+   this->lastTurn = false;
+   this->roundOver = false;
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: drawDeck()
+Purpose: Draw the top of the deck for the player to move
+Parameters:
+         none
+Return Value: a bool, true if the draw breaks the rules
+Local Variables:
+         none
+Algorithm:
+         1) The round must be in play, the player must not have drawn,
+            the deck can't be empty, and the hand can't be full
+         2) Move the top of the deck to the player's hand
+Assistance Received: none
+********************************************************************* */
+bool ReplayEngine::drawDeck()
+{
+   if (!this->inRound || this->roundOver || this->hasDrawn)
+   {
+      return illegal("draw out of turn");
+   }
+
+   if (this->round.isDrawingPileEmpty())
+   {
+      return illegal("draw from an empty deck");
+   }
+
+   if (this->hands[this->playerToMove].size() >= Hand::MAX_CARDS)
+   {
+      return illegal("draw into a full hand");
+   }
+
+   this->hands[this->playerToMove].add(this->round.drawDeck());
+   this->hasDrawn = true;
+   this->result.actions++;
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: drawDiscard()
+Purpose: Draw the top of the discard pile for the player to move
+Parameters:
+         none
+Return Value: a bool, true if the draw breaks the rules
+Local Variables:
+         none
+Algorithm:
+         1) The round must be in play, the player must not have drawn,
+            the discard pile can't be empty, and the hand can't be full
+         2) Move the top of the discard pile to the player's hand
+Assistance Received: none
+********************************************************************* */
+bool ReplayEngine::drawDiscard()
+{
+   if (!this->inRound || this->roundOver || this->hasDrawn)
+   {
+      return illegal("draw out of turn");
+   }
+
+   if (this->round.getDiscardPile().empty())
+   {
+      return illegal("draw from an empty discard pile");
+   }
+
+   if (this->hands[this->playerToMove].size() >= Hand::MAX_CARDS)
+   {
+      return illegal("draw into a full hand");
+   }
+
+   this->hands[this->playerToMove].add(this->round.drawDiscard());
+   this->hasDrawn = true;
+   this->result.actions++;
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: discard()
+Purpose: Discard a card for the player to move and end their turn
+Parameters:
+         int id, the id of the card discarded
+Return Value: a bool, true if the discard breaks the rules
+Local Variables:
+         Hand &hand, the hand of the player to move
+         int index, where the card is in the hand
+         bool wentOut, whether every card left can be melded
+Algorithm:
+         1) The player must have drawn and hold the card
+         2) Move the card from the hand to the discard pile
+         3) Check if the player went out, like Game::movePlayer(): the
+            first two times a player goes out the next player gets a
+            last turn, otherwise a last turn ends the round
+         4) Pass the turn to the next player
+Assistance Received: none
+********************************************************************* */
+bool ReplayEngine::discard(int id)
+{
+   if (!this->inRound || this->roundOver || !this->hasDrawn)
+   {
+      return illegal("discard out of turn");
+   }
+
+   Hand &hand = this->hands[this->playerToMove];
+   int index = hand.indexOf(id);
+   if (index == -1)
+   {
+      return illegal("discard of a card not in the hand");
+   }
+
+   this->round.discardCard(hand.removeAt(index));
+   this->result.actions++;
+
+   bool wentOut = Player::bestArrangement(hand).getNumberOfRemainingCards() == 0;
+   if (wentOut && this->goneOutCount < PLAYER_COUNT)
+   {
+      this->goneOutCount++;
+      this->lastTurn = true;
+   }
+   else if (this->lastTurn)
+   {
+      this->roundOver = true;
+   }
+
+   this->playerToMove = (this->playerToMove + 1) % PLAYER_COUNT;
+   this->hasDrawn = false;
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: endRound()
+Purpose: Score the finished round again and compare it with the scores
+   recorded in the journal
+Parameters:
+         int computerScore, the computer's recorded score after the round
+         int humanScore, the human's recorded score after the round
+Return Value: a bool, true if the round wasn't over
+Local Variables:
+         none
+Algorithm:
+         1) The round must be over
+         2) Add the value of each player's cards left after their best
+            arrangement to their replayed score, the way Game does
+         3) Count the round if the scores differ from the recorded ones
+Assistance Received: none
+********************************************************************* */
+bool ReplayEngine::endRound(int computerScore, int humanScore)
+{
+   if (!this->inRound || !this->roundOver)
+   {
+      return illegal("round " + std::to_string(this->roundNumber) + " scored before it was over");
+   }
+
+   for (int player = 0; player < PLAYER_COUNT; player++)
+   {
+      this->result.replayedScores[player] += deadwoodScore(this->hands[player], this->roundNumber);
+   }
+
+   this->result.recordedScores[0] = computerScore;
+   this->result.recordedScores[1] = humanScore;
+
+   if (this->result.replayedScores[0] != computerScore || this->result.replayedScores[1] != humanScore)
+   {
+      this->result.scoreMismatches++;
+   }
+
+   this->result.rounds++;
+   this->inRound = false;
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: illegal()
+Purpose: Mark the game as breaking the rules
+Parameters:
+         const string &reason, what broke the rules
+Return Value: a bool, always true so callers can return it
+Local Variables:
+         none
+Algorithm:
+         1) Store the reason with the round it happened in
+Assistance Received: none
+********************************************************************* */
+bool ReplayEngine::illegal(const std::string &reason)
+{
+   this->result.legal = false;
+   this->result.error = "round " + std::to_string(this->roundNumber) + ", action " + std::to_string(this->result.actions) + ": " + reason;
+
+   return true;
+}
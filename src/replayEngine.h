@@ -0,0 +1,91 @@
+#ifndef REPLAYENGINE_H
+#define REPLAYENGINE_H
+
+#include "round.h"
+#include "hand.h"
+#include "player.h"
+#include "journalReader.h"
+#include <string>
+#include <string_view>
+
+// The outcome of replaying one recorded game
+struct ReplayResult
+{
+   // Whether every action followed the rules, and why not if it didn't
+   bool legal = true;
+   std::string error;
+
+   // Seed of the game, draws and discards replayed, and rounds finished
+   unsigned seed = 0;
+   long long actions = 0;
+   int rounds = 0;
+
+   // Scores recorded in the journal and the scores from scoring each
+   // finished round again with the current rules (0 for Computer, 1 for Human)
+   int recordedScores[2] = { 0 };
+   int replayedScores[2] = { 0 };
+
+   // Number of rounds where the scores differ
+   int scoreMismatches = 0;
+};
+
+// Replays a game journal through the rules, with no console I/O and no AI.
+// Each draw and discard is checked against the state (drawing once then
+// discarding a card in the hand each turn, and the last turns after a
+// player goes out), and each finished round is scored again with the meld
+// evaluator. An engine replays one game at a time, use one per thread.
+class ReplayEngine
+{
+   public:
+      ReplayEngine() = default;
+      ~ReplayEngine() = default;
+
+      // Replay a journal that is already in memory
+      ReplayResult replayGame(std::string_view journal);
+
+      // Read and replay a journal file
+      ReplayResult replayFile(const std::string &fileName);
+
+   private:
+      static const int PLAYER_COUNT = 2;
+
+      // Most copies of each card in the two decks
+      static const int COPIES_OF_EACH_CARD = 2;
+
+      Round round;
+      Hand hands[PLAYER_COUNT];
+      int roundNumber = 0;
+      int playerToMove = 0;
+
+      // Whether a round has been dealt and not yet scored
+      bool inRound = false;
+
+      // Whether the player to move has drawn this turn
+      bool hasDrawn = false;
+
+      // Players who went out this round, whether the current turn is a last turn
+      // after a player went out, and whether the round is over
+      int goneOutCount = 0;
+      bool lastTurn = false;
+      bool roundOver = false;
+
+      ReplayResult result;
+
+      // Start a round from a GameFile snapshot
+      bool startRound(std::string_view snapshot);
+
+      // Draw from the deck or discard pile for the player to move
+      bool drawDeck();
+      bool drawDiscard();
+
+      // Discard a card for the player to move and end their turn
+      bool discard(int id);
+
+      // Score the finished round and compare it with the recorded scores
+      bool endRound(int computerScore, int humanScore);
+
+      // Mark the game as breaking the rules, always returns true
+      bool illegal(const std::string &reason);
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include "rolloutEstimator.h"
+#include "parallel.h"    // parallelFor()
+#include <algorithm>     // std::swap
+#include <cmath>         // std::sqrt
+#include <random>        // std::mt19937, std::seed_seq
+#include <vector>
+
+/* *********************************************************************
+Function Name: RolloutEstimator()
+Purpose: Create an estimator that plays out hands in a round
+Parameters:
+         int round, the round (to know the wild card)
+         int horizon, the turns played out after the first draw
+         unsigned threads, the threads to play out samples on, 0 for one
+            per core
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the round and its evaluator, the solution table, the
+            horizon, and threads
+Assistance Received: none
+********************************************************************* */
+RolloutEstimator::RolloutEstimator(int round, int horizon, unsigned threads)
+   : round(round), evaluator(round), table(&SolutionTable::shared()), horizon(horizon), threads(threads)
+{
+}
+
+/* *********************************************************************
+Function Name: estimate()
+Purpose: Compare drawing the top of the discard pile with drawing from
+   the deck by playing out both
+Parameters:
+         const Hand &hand, the cards in the hand before drawing
+         const Card &topOfDiscard, the card on top of the discard pile
+         int samples, the number of samples to play out
+         unsigned seed, the seed each sample's generator is made from
+         steady_clock::time_point deadline, when to stop playing out
+         const atomic<bool> *cancel, stops early when set (may be null)
+Return Value: a RolloutEstimate, the average left by each draw, the
+   difference, and its confidence interval
+Local Variables:
+         unsigned char handIds[], the hand's card ids
+         unsigned char unseen[], a copy of every card the hand can't see
+         vector<int> discardLeft, deckLeft, the points left by each draw
+            in each sample, -1 if it wasn't played out
+         RolloutEstimate result, the estimate
+Algorithm:
+         1) List the cards the hand can't see
+         2) On each thread, for each sample until out of time: seed a
+            generator with the seed and the sample's number, deal the
+            next draws from the unseen cards, and play out both draws
+            with them
+         3) Average what each draw left over the samples played out and
+            find the 95% confidence interval of the difference from how
+            much the paired differences vary
+         4) Draw from the discard pile if it's expected to leave no more
+Assistance Received: none
+********************************************************************* */
+RolloutEstimate RolloutEstimator::estimate(const Hand &hand, const Card &topOfDiscard, int samples, unsigned seed,
+   std::chrono::steady_clock::time_point deadline, const std::atomic<bool> *cancel) const
+{
+   unsigned char handIds[Hand::MAX_CARDS];
+   int size = 0;
+   int copies[Card::NUMBER_OF_IDS];
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      copies[id] = COPIES_OF_EACH_CARD;
+   }
+
+   for (const Card &card : hand)
+   {
+      handIds[size++] = card.getId();
+      copies[card.getId()]--;
+   }
+
+   if (topOfDiscard.getId() >= 0)
+   {
+      copies[topOfDiscard.getId()]--;
+   }
+
+   unsigned char unseen[COPIES_OF_EACH_CARD * Card::NUMBER_OF_IDS];
+   int unseenCount = 0;
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      for (int copy = 0; copy < copies[id]; copy++)
+      {
+         unseen[unseenCount++] = id;
+      }
+   }
+
+   // The first draw from the deck and the draws after it
+   int drawCount = std::min(this->horizon + 1, unseenCount);
+
+   std::vector<int> discardLeft(samples, -1);
+   std::vector<int> deckLeft(samples, -1);
+   parallelFor(samples, [&](size_t sample)
+   {
+      if ((cancel != nullptr && *cancel) || std::chrono::steady_clock::now() >= deadline)
+      {
+         return;
+      }
+
+      std::seed_seq sequence{ seed, static_cast<unsigned>(sample) };
+      std::mt19937 generator(sequence);
+
+      // Deal the draws from the front of a shuffled copy
+      unsigned char deck[COPIES_OF_EACH_CARD * Card::NUMBER_OF_IDS];
+      std::copy(unseen, unseen + unseenCount, deck);
+      for (int i = 0; i < drawCount; i++)
+      {
+         std::swap(deck[i], deck[i + generator() % (unseenCount - i)]);
+      }
+
+      unsigned char ids[Hand::MAX_CARDS];
+      std::copy(handIds, handIds + size, ids);
+      discardLeft[sample] = playOut(ids, size, topOfDiscard.getId(), deck + 1, drawCount - 1);
+
+      std::copy(handIds, handIds + size, ids);
+      deckLeft[sample] = playOut(ids, size, deck[0], deck + 1, drawCount - 1);
+   }, this->threads);
+
+   RolloutEstimate result;
+   double differenceSquares = 0;
+   for (int sample = 0; sample < samples; sample++)
+   {
+      if (discardLeft[sample] < 0 || deckLeft[sample] < 0)
+      {
+         continue;
+      }
+
+      int difference = discardLeft[sample] - deckLeft[sample];
+      result.discardMean += discardLeft[sample];
+      result.deckMean += deckLeft[sample];
+      result.difference += difference;
+      differenceSquares += static_cast<double>(difference) * difference;
+      result.samples++;
+   }
+
+   if (result.samples == 0)
+   {
+      return result;
+   }
+
+   result.discardMean /= result.samples;
+   result.deckMean /= result.samples;
+   result.difference /= result.samples;
+   if (result.samples > 1)
+   {
+      double variance = (differenceSquares - result.samples * result.difference * result.difference) / (result.samples - 1);
+      result.halfWidth = 1.96 * std::sqrt(std::max(variance, 0.0) / result.samples);
+   }
+   result.drawDiscard = result.difference <= 0;
+
+   return result;
+}
+
+/* *********************************************************************
+Function Name: playOut()
+Purpose: Play out a hand greedily after drawing a card
+Parameters:
+         unsigned char ids[], the card ids of the hand before drawing,
+            with room for one more card, changed as it's played out
+         int size, the number of cards in the hand
+         int firstCard, the id of the card drawn first
+         const unsigned char *draws, the ids of the cards drawn after it
+         int drawCount, the number of cards drawn after it
+Return Value: an int, the points left in the hand at the end
+Local Variables:
+         int left, the points left after the last discard
+Algorithm:
+         1) Add the first card and make the best discard
+         2) Until the hand can go out or the draws run out, add the next
+            draw and make the best discard
+Assistance Received: none
+********************************************************************* */
+int RolloutEstimator::playOut(unsigned char ids[], int size, int firstCard, const unsigned char *draws, int drawCount) const
+{
+   ids[size] = firstCard;
+   int left = discardBest(ids, size + 1);
+   for (int i = 0; i < drawCount && left > 0; i++)
+   {
+      ids[size] = draws[i];
+      left = discardBest(ids, size + 1);
+   }
+
+   return left;
+}
+
+/* *********************************************************************
+Function Name: discardBest()
+Purpose: Discard the card leaving the least from a hand
+Parameters:
+         unsigned char ids[], the card ids of the hand, the discard is
+            moved to the end
+         int size, the number of cards
+Return Value: an int, the points left in the rest of the hand
+Local Variables:
+         int best, the least left so far
+         int bestIndex, the index of the card leaving it
+Algorithm:
+         1) Look the hand up if the solution table covers it
+         2) Otherwise, for each card, swap it to the end and score the
+            rest, keeping the least and stopping early when a discard
+            goes out
+         3) Swap the best discard to the end
+Assistance Received: none
+********************************************************************* */
+int RolloutEstimator::discardBest(unsigned char ids[], int size) const
+{
+   int best = -1;
+   int bestIndex = size - 1;
+   if (this->table->bestDiscard(ids, size, this->round, bestIndex, best))
+   {
+      std::swap(ids[bestIndex], ids[size - 1]);
+      return best;
+   }
+
+   for (int i = 0; i < size && best != 0; i++)
+   {
+      // Another copy of a card already tried leaves the same
+      bool tried = false;
+      for (int j = 0; j < i && !tried; j++)
+      {
+         tried = ids[j] == ids[i];
+      }
+
+      if (tried)
+      {
+         continue;
+      }
+
+      std::swap(ids[i], ids[size - 1]);
+      int score = this->evaluator.deadwood(ids, size - 1);
+      std::swap(ids[i], ids[size - 1]);
+
+      if (best < 0 || score < best)
+      {
+         best = score;
+         bestIndex = i;
+      }
+   }
+
+   std::swap(ids[bestIndex], ids[size - 1]);
+   return best;
+}
@@ -0,0 +1,71 @@
+#ifndef ROLLOUTESTIMATOR_H
+#define ROLLOUTESTIMATOR_H
+
+#include "hand.h"
+#include "meldEvaluator.h"
+#include "solutionTable.h"
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::steady_clock
+
+// What playing out both draws left, on average over the samples
+struct RolloutEstimate
+{
+   // Average points left after drawing the top of the discard pile, and
+   // after drawing from the deck
+   double discardMean = 0;
+   double deckMean = 0;
+
+   // discardMean - deckMean, and half the width of its 95% confidence
+   // interval
+   double difference = 0;
+   double halfWidth = 0;
+
+   // Samples played out (fewer than asked if time ran out)
+   int samples = 0;
+
+   // Whether the discard pile should be drawn from
+   bool drawDiscard = false;
+};
+
+// Compares drawing the top of the discard pile with drawing from the deck by
+// playing out both. Each sample deals cards the hand can't see as the next
+// draws, and each draw is played out with the same cards: make the best
+// discard, then draw and discard greedily for a few turns or until the hand
+// can go out. The samples are spread across threads, and each is drawn from
+// its own generator seeded from the sample's number, so the estimate is the
+// same however many threads play it out.
+class RolloutEstimator
+{
+   public:
+      // Turns played out after the first draw when none is given
+      static const int DEFAULT_HORIZON = 4;
+
+      // Play out hands in a round for horizon turns after the first draw, on
+      // threads threads (0 for one per core)
+      explicit RolloutEstimator(int round, int horizon = DEFAULT_HORIZON, unsigned threads = 0);
+
+      // Play out samples samples for the hand before drawing, stopping at
+      // the deadline or when cancel is set (may be null)
+      RolloutEstimate estimate(const Hand &hand, const Card &topOfDiscard, int samples, unsigned seed,
+         std::chrono::steady_clock::time_point deadline, const std::atomic<bool> *cancel = nullptr) const;
+
+   private:
+      // Copies of each card in the two decks
+      static const int COPIES_OF_EACH_CARD = 2;
+
+      // Add the card to the hand and discard greedily until the draws run
+      // out or the hand can go out. Returns the points left
+      int playOut(unsigned char ids[], int size, int firstCard, const unsigned char *draws, int drawCount) const;
+
+      // Discard the card leaving the least from a hand of size cards, moving
+      // it to the end. Returns the points left
+      int discardBest(unsigned char ids[], int size) const;
+
+      int round;
+      MeldEvaluator evaluator;
+      const SolutionTable *table;
+      int horizon;
+      unsigned threads;
+};
+
+#endif
@@ -6,6 +6,7 @@ Purpose: Constructor for Round that takes the curent round to generate
    the deck
 Parameters:
          int currentRound, the current round of the game
+         unsigned seed, the seed of the game to shuffle the deck with
 Return Value: The Round object
 Local Variables:
          Deck deck, the deck for the current round
@@ -15,11 +16,11 @@ Algorithm:
          3) Shuffle the deck
 Assistance Received: none
 ********************************************************************* */
-Round::Round(int currentRound)
+Round::Round(int currentRound, unsigned seed)
 {
    Deck deck(currentRound);
    this->deck = deck;
-   this->deck.shuffleDeck();
+   this->deck.shuffleDeck(seed, currentRound);
 }
 
 /* *********************************************************************
@@ -84,29 +85,31 @@ Purpose: Returns the cards(hand) each player needs to begin the round
 Parameters:
          int round, the current game round
          int players, the number of players in the game
-Return Value: a vector<vector<Card>>, the cards for each player
+Return Value: a vector<Hand>, the cards for each player
 Local Variables:
          const int CARD_OFFSET, the offset from round number and cards
-         vector<vector<Card>> hands, all of the players hands
+         vector<Hand> hands, all of the players hands
 Algorithm:
          1) Loop through the number of players
-         2) Create each player's hand
+         2) Create each player's hand by drawing cards from the deck
          3) Return the hands created
 Assistance Received: none
 ********************************************************************* */
-std::vector<std::vector<Card>> Round::dealCards(int round, int players)
+std::vector<Hand> Round::dealCards(int round, int players)
 {
    // We deal round + 2 cards every round
    const int CARD_OFFSET = 2;
 
    // All the players hands
-   std::vector<std::vector<Card>> hands;
+   std::vector<Hand> hands(players);
 
    // Make each players hand
    for (int player = 0; player < players; player++)
    {
-      std::vector<Card> hand = deck.takeNCards(round + CARD_OFFSET);
-      hands.push_back(hand);
+      for (int i = 0; i < round + CARD_OFFSET; i++)
+      {
+         hands[player].add(deck.drawFromDeck());
+      }
    }
 
    return hands;
@@ -292,4 +295,38 @@ Algorithm:
 std::string Round::serializeDeck()
 {
    return this->deck.toString();
-}
\ No newline at end of file
+}
+
+/* *********************************************************************
+Function Name: getDrawPile()
+Purpose: Get the draw pile of the round's deck
+Parameters:
+         none
+Return Value: a const vector<Card>&, the draw pile, top of the pile first
+Local Variables:
+         none
+Algorithm:
+         1) Return the deck's draw pile
+Assistance Received: none
+********************************************************************* */
+const std::vector<Card>& Round::getDrawPile() const
+{
+   return this->deck.getDrawPile();
+}
+
+/* *********************************************************************
+Function Name: getDiscardPile()
+Purpose: Get the discard pile of the round's deck
+Parameters:
+         none
+Return Value: a const deque<Card>&, the discard pile, top of the pile first
+Local Variables:
+         none
+Algorithm:
+         1) Return the deck's discard pile
+Assistance Received: none
+********************************************************************* */
+const std::deque<Card>& Round::getDiscardPile() const
+{
+   return this->deck.getDiscardPile();
+}
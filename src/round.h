@@ -2,6 +2,7 @@
 #define ROUND_H
 
 #include "deck.h"
+#include "hand.h"
 
 class Round
 {
@@ -9,7 +10,8 @@ class Round
       Round() = default;
       ~Round() = default;
 
-      Round(int currentRound);
+      // Constructor for Round that creates the deck for the round and shuffles it with the game's seed
+      Round(int currentRound, unsigned seed);
 
       // Constructor for Round that is used when loading a game save file
       Round(std::vector<Card> drawingPile, std::deque<Card> discardPile);
@@ -21,7 +23,7 @@ class Round
       void setTurnNumber(int turn);
 
       // Deal cards to players
-      std::vector<std::vector<Card>> dealCards(int round, int players); 
+      std::vector<Hand> dealCards(int round, int players);
 
       // Take top of deck pile
       Card drawDeck();
@@ -53,6 +55,10 @@ class Round
       // Serialize and return the deck object to save the current game state
       std::string serializeDeck();
 
+      // Get the draw pile and discard pile, top of each pile first
+      const std::vector<Card>& getDrawPile() const;
+      const std::deque<Card>& getDiscardPile() const;
+
    private:
       Deck deck;                  // the full deck
       int turn = 0;               // the current turn of the round we're on
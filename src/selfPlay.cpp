@@ -0,0 +1,376 @@
+#include "selfPlay.h"
+#include "computer.h"
+#include "parallel.h"
+#include <algorithm>   // std::find, std::max
+#include <chrono>
+#include <cmath>       // std::sqrt
+#include <cstdlib>     // std::strtol
+#include <iostream>
+#include <sstream>     // std::istringstream
+#include <streambuf>
+
+namespace
+{
+   // Name of the difficulty in a setup's text
+   const std::string DIFFICULTY_NAME = "difficulty";
+
+   // Takes whatever is written to it and keeps none of it. With no buffer
+   // it holds no state, so every thread can write to it at once
+   class NullBuffer : public std::streambuf
+   {
+      protected:
+         virtual int overflow(int c) override { return c; }
+   };
+
+   // The hand of a player in a state
+   Hand handOf(const GameState &state, int player)
+   {
+      Hand hand;
+      for (int i = 0; i < state.handSizes[player]; i++)
+      {
+         hand.add(Card::fromId(state.hands[player][i], state.round));
+      }
+
+      return hand;
+   }
+}
+
+/* *********************************************************************
+Function Name: toString()
+Purpose: Write the setup so parse() can read it back
+Parameters:
+         none
+Return Value: a string, "difficulty=D,name=value,..."
+Local Variables:
+         none
+Algorithm:
+         1) Write the difficulty, then the strategy's parameters
+Assistance Received: none
+********************************************************************* */
+std::string ComputerSetup::toString() const
+{
+   return DIFFICULTY_NAME + "=" + std::to_string(static_cast<int>(this->difficulty)) + "," + this->strategy.toString();
+}
+
+/* *********************************************************************
+Function Name: parse()
+Purpose: Set the difficulty and parameters named in a string
+Parameters:
+         const string &text, "difficulty=D,name=value,..." in any order
+Return Value: a bool, true if text could not be read (nothing is set)
+Local Variables:
+         int level, the difficulty read
+         string parameters, the fields that aren't the difficulty
+         istringstream fields, the text split at commas
+         string field, one "name=value"
+         char *end, where the difficulty's number ends
+         Strategy strategy, the strategy with the parameters read
+Algorithm:
+         1) Split the text at commas, reading the difficulty from its field
+            (0 to 3, as the game's -d) and keeping the others
+         2) Read the others as the strategy's parameters
+         3) Keep the values only if every field was read
+Assistance Received: none
+********************************************************************* */
+bool ComputerSetup::parse(const std::string &text)
+{
+   int level = static_cast<int>(this->difficulty);
+   std::string parameters;
+   std::istringstream fields(text);
+   std::string field;
+   while (std::getline(fields, field, ','))
+   {
+      if (field.compare(0, DIFFICULTY_NAME.size() + 1, DIFFICULTY_NAME + "=") != 0)
+      {
+         parameters += (parameters.empty() ? "" : ",") + field;
+         continue;
+      }
+
+      const char *value = field.c_str() + DIFFICULTY_NAME.size() + 1;
+      char *end;
+      level = std::strtol(value, &end, 10);
+      if (end == value || *end != '\0' || level < static_cast<int>(Difficulty::HEURISTIC) || level > static_cast<int>(Difficulty::HARD))
+      {
+         return true;
+      }
+   }
+
+   Strategy strategy = this->strategy;
+   if (!parameters.empty() && strategy.parse(parameters))
+   {
+      return true;
+   }
+
+   this->strategy = strategy;
+   this->difficulty = static_cast<Difficulty>(level);
+   return false;
+}
+
+/* *********************************************************************
+Function Name: SelfPlay()
+Purpose: Create games between two computers
+Parameters:
+         const ComputerSetup &first, the first computer
+         const ComputerSetup &second, the second computer
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the setups
+Assistance Received: none
+********************************************************************* */
+SelfPlay::SelfPlay(const ComputerSetup &first, const ComputerSetup &second)
+   : setups{ first, second }
+{
+}
+
+/* *********************************************************************
+Function Name: playGame()
+Purpose: Play a whole game between the computers
+Parameters:
+         unsigned seed, the seed the game is dealt from
+         bool swapped, whether the second computer sits in the seat that
+            moves first in the first round
+Return Value: a GameResult, each computer's score
+Local Variables:
+         int setupOf[], the setup in each seat
+         Computer computers[], the computer in each seat
+         int scores[], each seat's score
+         int firstPlayer, the seat that moves first in the round
+         GameState state, the round being played
+         vector<int> discardPile, ids of the cards face up as it starts
+         UndoRecord record, what the last action changed
+         vector<unsigned long long> seen, the hashes of the turns that
+            drew from the discard pile since the last draw from the deck
+         int player, the seat to move
+         unsigned char goneOut, players out before the action
+         Card top, the card on top of the discard pile
+         Action action, the action made
+         bool fromDiscard, whether the draw was from the discard pile
+         Card card, the card drawn
+         int index, the index in the hand of the card discarded
+Algorithm:
+         1) Set up a Computer in each seat
+         2) Deal each round from the game's seed and the round, the way
+            Game deals from its seed, and let both computers see it start
+         3) Show the computer to move its hand, the top of the discard
+            pile, and the game, and ask it to draw (move()) or discard
+            (getCardToDiscard()) until the round is over, or score it as it
+            stands if the deck runs out. If a turn starts as one did
+            before, the players are passing cards back and forth, so draw
+            from the deck instead. Both computers see every draw and
+            discard, as in Game
+         4) The last player to go out moves first in the next round, as in
+            Game
+         5) Return the scores and the winner by computer
+Assistance Received: none
+********************************************************************* */
+SelfPlay::GameResult SelfPlay::playGame(unsigned seed, bool swapped) const
+{
+   int setupOf[GameState::PLAYER_COUNT] = { swapped ? 1 : 0, swapped ? 0 : 1 };
+   Computer computers[GameState::PLAYER_COUNT];
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      computers[player].setStrategy(this->setups[setupOf[player]].strategy);
+      computers[player].setDifficulty(this->setups[setupOf[player]].difficulty);
+   }
+
+   int scores[GameState::PLAYER_COUNT] = { 0, 0 };
+   int firstPlayer = 0;
+   std::vector<unsigned long long> seen;
+
+   for (int round = 1; round <= LAST_ROUND; round++)
+   {
+      GameState state = startRound(round, seed + round * 0x9e3779b9u, firstPlayer, scores[0], scores[1]);
+
+      std::vector<int> discardPile(state.discardPile, state.discardPile + state.discardSize);
+      for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+      {
+         computers[player].observeRoundStart(round, state.handSizes[1 - player], discardPile);
+      }
+
+      UndoRecord record;
+      seen.clear();
+      while (state.phase != GameState::Phase::ROUND_OVER
+         && !(state.phase == GameState::Phase::DRAW && state.drawSize == 0))
+      {
+         int player = state.playerToMove;
+         unsigned char goneOut = state.goneOutCount;
+         Computer &computer = computers[player];
+         Card top = state.discardSize == 0 ? Card() : Card::fromId(state.discardPile[state.discardSize - 1], state.round);
+
+         computer.setHand(handOf(state, player));
+         computer.setTopOfDiscard(top);
+         computer.setGameState(state);
+
+         Action action;
+         if (state.phase == GameState::Phase::DRAW)
+         {
+            // Players passing cards back and forth through the discard pile
+            // would never end the round, so draw from the deck once a turn
+            // starts as one did before. Drawing from the deck changes the
+            // state for good, so only turns since the last one can repeat
+            action = { Action::Type::DRAW_DECK, 0 };
+            if (state.discardSize > 0 && std::find(seen.begin(), seen.end(), state.hash) == seen.end()
+               && computer.move() == static_cast<int>(Player::moveOption::DRAW_DISCARD))
+            {
+               action.type = Action::Type::DRAW_DISCARD;
+            }
+
+            bool fromDiscard = action.type == Action::Type::DRAW_DISCARD;
+            Card card = fromDiscard ? top : Card::fromId(state.drawPile[state.drawSize - 1], state.round);
+            if (fromDiscard)
+            {
+               seen.push_back(state.hash);
+            }
+            else
+            {
+               seen.clear();
+            }
+
+            applyInPlace(state, action, record);
+            for (int other = 0; other < GameState::PLAYER_COUNT; other++)
+            {
+               computers[other].observeDraw(other == player, fromDiscard, card);
+            }
+         }
+         else
+         {
+            int index = computer.findIndexInHand(computer.getCardToDiscard().second);
+            if (index == -1)
+            {
+               int deadwood;
+               index = bestDiscard(state.hands[player], state.handSizes[player], state.round, deadwood);
+            }
+            action = { Action::Type::DISCARD, state.hands[player][index] };
+
+            applyInPlace(state, action, record);
+            for (int other = 0; other < GameState::PLAYER_COUNT; other++)
+            {
+               computers[other].observeDiscard(other == player, Card::fromId(action.card, round));
+            }
+         }
+
+         if (state.goneOutCount > goneOut)
+         {
+            firstPlayer = player;
+         }
+      }
+
+      if (state.phase == GameState::Phase::ROUND_OVER)
+      {
+         scores[0] = state.scores[0];
+         scores[1] = state.scores[1];
+      }
+      else
+      {
+         for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+         {
+            scores[player] += deadwoodScore(state.hands[player], state.handSizes[player], state.round);
+         }
+      }
+   }
+
+   GameResult result;
+   result.scores[setupOf[0]] = scores[0];
+   result.scores[setupOf[1]] = scores[1];
+
+   int winner = winnerOf(scores);
+   result.winner = winner == -1 ? -1 : setupOf[winner];
+
+   return result;
+}
+
+/* *********************************************************************
+Function Name: playMatch()
+Purpose: Play pairs of games between the computers
+Parameters:
+         int pairs, the number of deals, each played from both seats
+         unsigned seed, the seed the deals' seeds are drawn from
+         unsigned threads, the number of threads (0 for one per core)
+Return Value: a MatchResult, the outcome from the first computer's side
+Local Variables:
+         steady_clock::time_point start, when the match started
+         NullBuffer nothing, takes the computers' messages
+         streambuf *console, where std::cout wrote before the match
+         vector<unsigned> seeds, the seed of each deal
+         vector<GameResult> results, each game's result, two per deal
+         double sum, double squares, the sum of the pairs' differences
+            and of their squares
+Algorithm:
+         1) Draw a seed for each deal
+         2) Play every game across the threads, each deal from both seats,
+            with std::cout thrown away
+         3) Count wins, losses, and draws of the first computer
+         4) Average each pair's score difference, and find the standard
+            error of the mean over the pairs
+Assistance Received: none
+********************************************************************* */
+SelfPlay::MatchResult SelfPlay::playMatch(int pairs, unsigned seed, unsigned threads) const
+{
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+   std::mt19937 generator(seed);
+   std::vector<unsigned> seeds(pairs);
+   for (unsigned &deal : seeds)
+   {
+      deal = generator();
+   }
+
+   // Every thread writes to it at once, which only a buffer with no state allows
+   NullBuffer nothing;
+   std::streambuf *console = std::cout.rdbuf(&nothing);
+
+   std::vector<GameResult> results(2 * pairs);
+   parallelFor(results.size(), [&](size_t i)
+   {
+      results[i] = playGame(seeds[i / 2], i % 2 == 1);
+   }, threads);
+
+   std::cout.rdbuf(console);
+
+   MatchResult match;
+   double sum = 0;
+   double squares = 0;
+   for (int i = 0; i < pairs; i++)
+   {
+      double difference = 0;
+      for (int j = 0; j < 2; j++)
+      {
+         const GameResult &game = results[2 * i + j];
+         match.games++;
+         if (game.winner == 0)
+         {
+            match.wins++;
+         }
+         else if (game.winner == 1)
+         {
+            match.losses++;
+         }
+         else
+         {
+            match.draws++;
+         }
+         difference += (game.scores[0] - game.scores[1]) / 2.0;
+      }
+
+      match.pairDifferences.push_back(difference);
+      sum += difference;
+      squares += difference * difference;
+   }
+
+   if (pairs > 0)
+   {
+      match.meanDifference = sum / pairs;
+   }
+   if (pairs > 1)
+   {
+      double variance = (squares - sum * sum / pairs) / (pairs - 1);
+      match.standardError = std::sqrt(std::max(variance, 0.0) / pairs);
+   }
+
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+   match.seconds = elapsed.count();
+
+   return match;
+}
@@ -0,0 +1,93 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include "anytimeSearch.h"   // Difficulty
+#include "gameState.h"
+#include "strategy.h"
+#include <string>
+#include <vector>
+
+// A computer as the game can be set up to play: the parameters of its rule
+// of thumb (the game's -p) and how long it thinks (the game's -d)
+struct ComputerSetup
+{
+   Strategy strategy;
+   Difficulty difficulty = Difficulty::HEURISTIC;
+
+   // The setup as "difficulty=D,name=value,..."
+   std::string toString() const;
+
+   // Set the difficulty and parameters named in text, as written by
+   // toString() (any left out keep their value). Returns true if text could
+   // not be read
+   bool parse(const std::string &text);
+};
+
+// Whole games between two computers set up as the game sets them up, on a
+// GameState, so many can be played at once (see tune.cpp). Each seat is a
+// Computer that decides every draw with Computer::move() and every discard
+// with Computer::getCardToDiscard(), seeing the game and keeping track of
+// the other seat's hand as in Game, so a match measures the computer the
+// game ships. Players that pass a card back and forth through the discard
+// pile, which the rule of thumb can do forever, draw from the deck instead,
+// and a round whose deck runs out (which Game has no rule for) is scored as
+// it stands.
+// Matches play every deal twice, with the computers swapping seats, so the
+// luck of the deal mostly cancels out. At Difficulty::HEURISTIC the
+// computers decide the same way every time; above it they think until a
+// deadline, so a match also depends on how busy the machine is.
+class SelfPlay
+{
+   public:
+      // The last round of a game
+      static const int LAST_ROUND = 11;
+
+      // What a game ended with, by computer rather than by seat: each one's
+      // score, and the one that won by the game's rules (see winnerOf()),
+      // or -1 for a tie
+      struct GameResult
+      {
+         int scores[2] = { 0, 0 };
+         int winner = -1;
+      };
+
+      // What a match ended with, from the first computer's side
+      struct MatchResult
+      {
+         int games = 0;
+         int wins = 0;
+         int losses = 0;
+         int draws = 0;
+
+         // Mean of the first computer's score less the second's (below 0
+         // when the first does better), and its standard error, over the
+         // pairs of games
+         double meanDifference = 0;
+         double standardError = 0;
+
+         // How long the match took
+         double seconds = 0;
+
+         // The first computer's score less the second's averaged over each
+         // pair of games, in the order of the deals
+         std::vector<double> pairDifferences;
+      };
+
+      // Play first against second
+      SelfPlay(const ComputerSetup &first, const ComputerSetup &second);
+
+      // Play a whole game dealt from seed. The first computer sits in the
+      // seat that moves first in the first round unless swapped. The
+      // computers' messages go to std::cout
+      GameResult playGame(unsigned seed, bool swapped) const;
+
+      // Play pairs of games, each dealt from its own seed drawn from seed
+      // and played from both seats, across threads (0 for one per core),
+      // throwing the computers' messages away
+      MatchResult playMatch(int pairs, unsigned seed, unsigned threads = 0) const;
+
+   private:
+      ComputerSetup setups[2];
+};
+
+#endif
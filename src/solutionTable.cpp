@@ -0,0 +1,679 @@
+#include "solutionTable.h"
+#include "meldEvaluator.h"
+#include "parallel.h"
+#include <algorithm>   // std::lower_bound, std::sort
+#include <cstring>     // std::memcpy
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#include <utility>     // std::pair
+#include <vector>
+
+const char SolutionTable::MAGIC[4] = { 'F', 'C', 'S', 'T' };
+const std::string SolutionTable::DEFAULT_FILE_NAME = "fivecrowns.tbl";
+
+/* *********************************************************************
+Function Name: ~SolutionTable()
+Purpose: Release the mapped file
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Unmap the file if one is mapped
+Assistance Received: none
+********************************************************************* */
+SolutionTable::~SolutionTable()
+{
+   close();
+}
+
+/* *********************************************************************
+Function Name: open()
+Purpose: Map a table file into memory
+Parameters:
+         const string &fileName, the file to map
+Return Value: a bool, true if it could not be opened or is not a valid
+   table
+Local Variables:
+         int file, the open file
+         struct stat status, its size
+         const unsigned char *bytes, the mapped file
+         uint32_t count, the hands in a section
+         uint32_t offset, where the section starts
+Algorithm:
+         1) Map the whole file read only, the file can be closed after
+         2) Check the magic, version, and last round
+         3) Check that each section is aligned and inside the file, and
+            point it at its keys and entries
+         4) Unmap the file if anything is wrong
+Assistance Received: none
+********************************************************************* */
+bool SolutionTable::open(const std::string &fileName)
+{
+   close();
+
+   int file = ::open(fileName.c_str(), O_RDONLY);
+   if (file == -1)
+   {
+      return true;
+   }
+
+   struct stat status;
+   if (fstat(file, &status) == -1 || status.st_size < HEADER_SIZE)
+   {
+      ::close(file);
+      return true;
+   }
+
+   this->length = static_cast<size_t>(status.st_size);
+   this->data = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, file, 0);
+   ::close(file);
+
+   if (this->data == MAP_FAILED)
+   {
+      this->data = nullptr;
+      this->length = 0;
+      return true;
+   }
+
+   const unsigned char *bytes = static_cast<const unsigned char *>(this->data);
+   if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || bytes[4] != VERSION || bytes[5] != LAST_ROUND)
+   {
+      close();
+      return true;
+   }
+
+   for (int round = 0; round < LAST_ROUND; round++)
+   {
+      for (int size = 0; size < SIZES; size++)
+      {
+         std::uint32_t count;
+         std::uint32_t offset;
+         std::memcpy(&count, bytes + 8 + (round * SIZES + size) * 8, sizeof(count));
+         std::memcpy(&offset, bytes + 12 + (round * SIZES + size) * 8, sizeof(offset));
+
+         if (offset % sizeof(std::uint64_t) != 0 || offset > this->length
+            || (this->length - offset) / (sizeof(std::uint64_t) + sizeof(std::uint16_t)) < count)
+         {
+            close();
+            return true;
+         }
+
+         Section &section = this->sections[round][size];
+         section.keys = reinterpret_cast<const std::uint64_t *>(bytes + offset);
+         section.entries = reinterpret_cast<const std::uint16_t *>(bytes + offset + count * sizeof(std::uint64_t));
+         section.count = count;
+      }
+   }
+
+   return false;
+}
+
+/* *********************************************************************
+Function Name: covers()
+Purpose: Check if a table is open and covers a round
+Parameters:
+         int round, the round
+Return Value: a bool, true if hands of the round can be looked up
+Local Variables:
+         none
+Algorithm:
+         1) Check that a file is mapped and the round is one of the first
+Assistance Received: none
+********************************************************************* */
+bool SolutionTable::covers(int round) const
+{
+   return this->data != nullptr && round >= 1 && round <= LAST_ROUND;
+}
+
+/* *********************************************************************
+Function Name: deadwood()
+Purpose: Look up the value of the cards a hand is left with after its
+   best arrangement
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards (round + 2)
+         int round, the round
+         int &deadwood, set to the value left
+Return Value: a bool, false if the table doesn't cover the hand
+Local Variables:
+         unsigned char order[], the cards in canonical order
+         uint16_t entry, the hand's entry
+Algorithm:
+         1) Find the hand's entry and take the value from its low bits
+Assistance Received: none
+********************************************************************* */
+bool SolutionTable::deadwood(const unsigned char *ids, int size, int round, int &deadwood) const
+{
+   unsigned char order[MAX_CARDS];
+   std::uint16_t entry;
+   if (size != round + 2 || !find(ids, size, round, order, entry))
+   {
+      return false;
+   }
+
+   deadwood = entry & ((1 << DEADWOOD_BITS) - 1);
+   return true;
+}
+
+/* *********************************************************************
+Function Name: deadwood()
+Purpose: Look up the value of the cards a hand is left with after its
+   best arrangement
+Parameters:
+         const Hand &hand, the hand (round + 2 cards)
+         int round, the round
+         int &deadwood, set to the value left
+Return Value: a bool, false if the table doesn't cover the hand
+Local Variables:
+         unsigned char ids[], the hand's card ids
+         int size, the number of cards
+Algorithm:
+         1) Copy the ids and look them up
+Assistance Received: none
+********************************************************************* */
+bool SolutionTable::deadwood(const Hand &hand, int round, int &deadwood) const
+{
+   if (hand.size() > MAX_CARDS)
+   {
+      return false;
+   }
+
+   unsigned char ids[MAX_CARDS];
+   int size = 0;
+   for (const Card &card : hand)
+   {
+      ids[size++] = card.getId();
+   }
+
+   return this->deadwood(ids, size, round, deadwood);
+}
+
+/* *********************************************************************
+Function Name: bestDiscard()
+Purpose: Look up the best card for a hand to discard
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards (round + 3)
+         int round, the round
+         int &index, set to the index in ids of the card to discard
+         int &deadwood, set to the value the rest is left with
+Return Value: a bool, false if the table doesn't cover the hand
+Local Variables:
+         unsigned char order[], the cards in canonical order
+         uint16_t entry, the hand's entry
+Algorithm:
+         1) Find the hand's entry
+         2) Its high bits are the discard's position in canonical order,
+            which order turns back into an index in ids
+Assistance Received: none
+********************************************************************* */
+bool SolutionTable::bestDiscard(const unsigned char *ids, int size, int round, int &index, int &deadwood) const
+{
+   unsigned char order[MAX_CARDS];
+   std::uint16_t entry;
+   if (size != round + 3 || !find(ids, size, round, order, entry))
+   {
+      return false;
+   }
+
+   index = order[entry >> DEADWOOD_BITS];
+   deadwood = entry & ((1 << DEADWOOD_BITS) - 1);
+   return true;
+}
+
+/* *********************************************************************
+Function Name: bestDiscard()
+Purpose: Look up the best card for a hand to discard
+Parameters:
+         const Hand &hand, the hand (round + 3 cards)
+         int round, the round
+         int &index, set to the index in the hand of the card to discard
+         int &deadwood, set to the value the rest is left with
+Return Value: a bool, false if the table doesn't cover the hand
+Local Variables:
+         unsigned char ids[], the hand's card ids
+         int size, the number of cards
+Algorithm:
+         1) Copy the ids and look them up, they're in the hand's order
+Assistance Received: none
+********************************************************************* */
+bool SolutionTable::bestDiscard(const Hand &hand, int round, int &index, int &deadwood) const
+{
+   if (hand.size() > MAX_CARDS)
+   {
+      return false;
+   }
+
+   unsigned char ids[MAX_CARDS];
+   int size = 0;
+   for (const Card &card : hand)
+   {
+      ids[size++] = card.getId();
+   }
+
+   return bestDiscard(ids, size, round, index, deadwood);
+}
+
+/* *********************************************************************
+Function Name: generate()
+Purpose: Solve every hand of the rounds covered and build the table file
+Parameters:
+         unsigned threads, the number of threads to use (0 for one per
+            core)
+Return Value: a string, the table file
+Local Variables:
+         string file, the file being built
+         string keys, string entries, one section's keys and entries
+         uint32_t count, uint32_t offset, the section's place in the file
+Algorithm:
+         1) Write the header
+         2) Solve each section and append it at the next multiple of 8
+            bytes, so its keys can be read in place once mapped, filling
+            in its count and offset in the header
+Assistance Received: none
+********************************************************************* */
+std::string SolutionTable::generate(unsigned threads)
+{
+   std::string file(HEADER_SIZE, '\0');
+   std::memcpy(&file[0], MAGIC, sizeof(MAGIC));
+   file[4] = static_cast<char>(VERSION);
+   file[5] = static_cast<char>(LAST_ROUND);
+
+   for (int round = 1; round <= LAST_ROUND; round++)
+   {
+      for (int size = 0; size < SIZES; size++)
+      {
+         std::string keys;
+         std::string entries;
+         solveSection(round, round + 2 + size, threads, keys, entries);
+
+         file.resize((file.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) * sizeof(std::uint64_t), '\0');
+
+         std::uint32_t count = static_cast<std::uint32_t>(keys.size() / sizeof(std::uint64_t));
+         std::uint32_t offset = static_cast<std::uint32_t>(file.size());
+         std::memcpy(&file[8 + ((round - 1) * SIZES + size) * 8], &count, sizeof(count));
+         std::memcpy(&file[12 + ((round - 1) * SIZES + size) * 8], &offset, sizeof(offset));
+
+         file += keys;
+         file += entries;
+      }
+   }
+
+   return file;
+}
+
+/* *********************************************************************
+Function Name: shared()
+Purpose: Get the table the game and the computer look hands up in
+Parameters:
+         none
+Return Value: a const SolutionTable&, the table, empty if there is no
+   table file
+Local Variables:
+         SolutionTable table, the table, mapped once
+         bool opened, whether it has been mapped
+Algorithm:
+         1) Map DEFAULT_FILE_NAME the first time, a missing file leaves
+            the table empty and everything is searched instead
+Assistance Received: none
+********************************************************************* */
+const SolutionTable &SolutionTable::shared()
+{
+   static SolutionTable table;
+   static bool opened = !table.open(DEFAULT_FILE_NAME);
+   (void)opened;
+
+   return table;
+}
+
+/* *********************************************************************
+Function Name: canonicalKey()
+Purpose: Put a hand in canonical form
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+         int round, the round (to know the wild card)
+         unsigned char order[], set to the index in ids of each card in
+            the order of the key
+Return Value: a uint64_t, the key of the hand
+Local Variables:
+         uint32_t pattern[], two bits for each number a suit holds
+         int suits[], the suits ordered by their pattern
+         int name[], the new name of each suit
+         int codes[], each card's code in canonical form
+Algorithm:
+         1) Find the numbers each suit holds, and order the suits by them,
+            so hands that only differ in which suit is which get the same
+            names
+         2) Code each card: a natural card by its new suit and number, and
+            the wild cards and jokers by one code each
+         3) Order the cards by code and pack the codes into the key
+Assistance Received: none
+********************************************************************* */
+std::uint64_t SolutionTable::canonicalKey(const unsigned char *ids, int size, int round, unsigned char order[])
+{
+   MeldEvaluator evaluator(round);
+
+   std::uint32_t pattern[Card::NUMBER_OF_SUITS] = { 0 };
+   for (int i = 0; i < size; i++)
+   {
+      if (!evaluator.isWild(ids[i]))
+      {
+         pattern[ids[i] / Card::NUMBER_OF_NUMBERS] += 1u << (2 * (ids[i] % Card::NUMBER_OF_NUMBERS));
+      }
+   }
+
+   int suits[Card::NUMBER_OF_SUITS];
+   for (int i = 0; i < Card::NUMBER_OF_SUITS; i++)
+   {
+      int j = i;
+      for (; j > 0 && pattern[suits[j - 1]] < pattern[i]; j--)
+      {
+         suits[j] = suits[j - 1];
+      }
+      suits[j] = i;
+   }
+
+   int name[Card::NUMBER_OF_SUITS];
+   for (int i = 0; i < Card::NUMBER_OF_SUITS; i++)
+   {
+      name[suits[i]] = i;
+   }
+
+   int codes[MAX_CARDS];
+   for (int i = 0; i < size; i++)
+   {
+      if (ids[i] >= Card::FIRST_JOKER_ID)
+      {
+         codes[i] = JOKER_CODE;
+      }
+      else if (evaluator.isWild(ids[i]))
+      {
+         codes[i] = WILD_CODE;
+      }
+      else
+      {
+         codes[i] = name[ids[i] / Card::NUMBER_OF_NUMBERS] * Card::NUMBER_OF_NUMBERS + ids[i] % Card::NUMBER_OF_NUMBERS;
+      }
+
+      int j = i;
+      for (; j > 0 && codes[order[j - 1]] > codes[i]; j--)
+      {
+         order[j] = order[j - 1];
+      }
+      order[j] = static_cast<unsigned char>(i);
+   }
+
+   std::uint64_t key = 0;
+   for (int i = 0; i < size; i++)
+   {
+      key = key << CODE_BITS | codes[order[i]];
+   }
+
+   return key;
+}
+
+/* *********************************************************************
+Function Name: solveSection()
+Purpose: Solve every canonical hand of a size in a round
+Parameters:
+         int round, the round
+         int size, the number of cards in a hand
+         unsigned threads, the number of threads to use
+         string &keys, set to the sorted keys
+         string &entries, set to their entries
+Return Value: none
+Local Variables:
+         vector<pair<uint32_t, int>> patterns, every way a suit can hold up to size
+            natural cards, largest first
+         vector<Canonical> hands, each canonical hand's key and its
+            cards in canonical order
+         vector<uint16_t> solved, each hand's entry
+Algorithm:
+         1) List the patterns a suit can hold, two bits for each number
+            other than the wild one
+         2) For every number of jokers and wild cards, give the suits the
+            rest of the natural cards in patterns that never grow from one
+            suit to the next. That is the canonical order of the suits, so
+            each hand is made once
+         3) Sort the hands by key and solve each with MeldEvaluator:
+            hands after discarding by what they're left with, hands after
+            drawing by the best card to discard (the first on a tie)
+Assistance Received: none
+********************************************************************* */
+void SolutionTable::solveSection(int round, int size, unsigned threads, std::string &keys, std::string &entries)
+{
+   const int numbers = Card::NUMBER_OF_NUMBERS;
+   const int wildNumber = round + Card::getWildCardOffset() - 3;
+   const int copies = 2;
+
+   // Every pattern of up to size natural cards, with how many cards it holds
+   std::vector<std::pair<std::uint32_t, int>> patterns = { { 0, 0 } };
+   for (int number = 0; number < numbers; number++)
+   {
+      if (number == wildNumber)
+      {
+         continue;
+      }
+
+      size_t before = patterns.size();
+      for (size_t i = 0; i < before; i++)
+      {
+         for (int count = 1; count <= copies && patterns[i].second + count <= size; count++)
+         {
+            patterns.push_back({ patterns[i].first + (static_cast<std::uint32_t>(count) << (2 * number)), patterns[i].second + count });
+         }
+      }
+   }
+   std::sort(patterns.begin(), patterns.end(), [](const std::pair<std::uint32_t, int> &a, const std::pair<std::uint32_t, int> &b)
+   {
+      return a.first > b.first;
+   });
+
+   struct Canonical
+   {
+      std::uint64_t key;
+      unsigned char ids[MAX_CARDS];
+   };
+   std::vector<Canonical> hands;
+
+   unsigned char ids[MAX_CARDS];
+   int chosen[Card::NUMBER_OF_SUITS];
+
+   // Give suit the natural cards left, in a pattern no larger than the last suit's
+   auto fill = [&](auto &self, int suit, size_t first, int left, int wildCards) -> void
+   {
+      if (suit == Card::NUMBER_OF_SUITS)
+      {
+         if (left != 0)
+         {
+            return;
+         }
+
+         int count = wildCards;
+         for (int s = 0; s < Card::NUMBER_OF_SUITS; s++)
+         {
+            std::uint32_t pattern = patterns[chosen[s]].first;
+            for (int number = 0; number < numbers; number++)
+            {
+               for (std::uint32_t copy = 0; copy < (pattern >> (2 * number) & 3); copy++)
+               {
+                  ids[count++] = static_cast<unsigned char>(s * numbers + number);
+               }
+            }
+         }
+
+         Canonical hand;
+         unsigned char order[MAX_CARDS];
+         hand.key = canonicalKey(ids, size, round, order);
+         for (int i = 0; i < size; i++)
+         {
+            hand.ids[i] = ids[order[i]];
+         }
+         hands.push_back(hand);
+         return;
+      }
+
+      for (size_t i = first; i < patterns.size(); i++)
+      {
+         if (patterns[i].second <= left)
+         {
+            chosen[suit] = static_cast<int>(i);
+            self(self, suit + 1, i, left - patterns[i].second, wildCards);
+         }
+      }
+   };
+
+   // Jokers first, then the wild cards of each suit
+   for (int jokers = 0; jokers <= std::min(size, 3 * copies); jokers++)
+   {
+      for (int wild = 0; wild <= std::min(size - jokers, Card::NUMBER_OF_SUITS * copies); wild++)
+      {
+         for (int i = 0; i < jokers; i++)
+         {
+            ids[i] = static_cast<unsigned char>(Card::FIRST_JOKER_ID + i / copies);
+         }
+         for (int i = 0; i < wild; i++)
+         {
+            ids[jokers + i] = static_cast<unsigned char>(i / copies * numbers + wildNumber);
+         }
+
+         fill(fill, 0, 0, size - jokers - wild, jokers + wild);
+      }
+   }
+
+   std::sort(hands.begin(), hands.end(), [](const Canonical &a, const Canonical &b)
+   {
+      return a.key < b.key;
+   });
+
+   // Solve the hands
+   std::vector<std::uint16_t> solved(hands.size());
+   bool afterDrawing = size == round + 3;
+   MeldEvaluator evaluator(round);
+
+   parallelFor(hands.size(), [&](size_t h)
+   {
+      const Canonical &hand = hands[h];
+      if (!afterDrawing)
+      {
+         solved[h] = static_cast<std::uint16_t>(evaluator.deadwood(hand.ids, size) | NO_DISCARD << DEADWOOD_BITS);
+         return;
+      }
+
+      int best = -1;
+      int bestDeadwood = 0;
+      unsigned char rest[MAX_CARDS];
+      for (int discard = 0; discard < size; discard++)
+      {
+         // Discarding either copy, or any wild card or joker, is the same
+         int code = hand.key >> (CODE_BITS * (size - 1 - discard)) & ((1 << CODE_BITS) - 1);
+         if (discard > 0 && code == static_cast<int>(hand.key >> (CODE_BITS * (size - discard)) & ((1 << CODE_BITS) - 1)))
+         {
+            continue;
+         }
+
+         int count = 0;
+         for (int i = 0; i < size; i++)
+         {
+            if (i != discard)
+            {
+               rest[count++] = hand.ids[i];
+            }
+         }
+
+         int left = evaluator.deadwood(rest, count);
+         if (best == -1 || left < bestDeadwood)
+         {
+            best = discard;
+            bestDeadwood = left;
+         }
+      }
+
+      solved[h] = static_cast<std::uint16_t>(bestDeadwood | best << DEADWOOD_BITS);
+   }, threads);
+
+   keys.resize(hands.size() * sizeof(std::uint64_t));
+   entries.resize(hands.size() * sizeof(std::uint16_t));
+   for (size_t h = 0; h < hands.size(); h++)
+   {
+      std::memcpy(&keys[h * sizeof(std::uint64_t)], &hands[h].key, sizeof(std::uint64_t));
+   }
+   if (!solved.empty())
+   {
+      std::memcpy(&entries[0], solved.data(), entries.size());
+   }
+}
+
+/* *********************************************************************
+Function Name: find()
+Purpose: Find a hand's entry
+Parameters:
+         const unsigned char *ids, the card ids of the hand
+         int size, the number of cards
+         int round, the round
+         unsigned char order[], set to the cards in canonical order
+         uint16_t &entry, set to the hand's entry
+Return Value: a bool, false if the table doesn't cover the hand
+Local Variables:
+         const Section &section, the section of the hand's size
+         uint64_t key, the hand's key
+         const uint64_t *found, where the key is in the section
+Algorithm:
+         1) Pick the section by round and size
+         2) Put the hand in canonical form and binary search its key
+Assistance Received: none
+********************************************************************* */
+bool SolutionTable::find(const unsigned char *ids, int size, int round, unsigned char order[], std::uint16_t &entry) const
+{
+   if (!covers(round) || size < round + 2 || size >= round + 2 + SIZES)
+   {
+      return false;
+   }
+
+   const Section &section = this->sections[round - 1][size - round - 2];
+   std::uint64_t key = canonicalKey(ids, size, round, order);
+
+   const std::uint64_t *found = std::lower_bound(section.keys, section.keys + section.count, key);
+   if (found == section.keys + section.count || *found != key)
+   {
+      return false;
+   }
+
+   entry = section.entries[found - section.keys];
+   return true;
+}
+
+/* *********************************************************************
+Function Name: close()
+Purpose: Release the mapped file
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Unmap the file and empty every section
+Assistance Received: none
+********************************************************************* */
+void SolutionTable::close()
+{
+   if (this->data != nullptr)
+   {
+      munmap(this->data, this->length);
+   }
+
+   this->data = nullptr;
+   this->length = 0;
+   for (int round = 0; round < LAST_ROUND; round++)
+   {
+      for (int size = 0; size < SIZES; size++)
+      {
+         this->sections[round][size] = Section();
+      }
+   }
+}
@@ -0,0 +1,121 @@
+#ifndef SOLUTIONTABLE_H
+#define SOLUTIONTABLE_H
+
+#include "card.h"
+#include "hand.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Every hand of the first rounds solved ahead of time by the tablegen tool
+// (see tablegen.cpp) and read from a file mapped into memory, so the computer
+// gets the least a hand can be left with, and the best card to discard, with
+// one lookup instead of a search. Rounds are scored without it (see
+// deadwoodScore() in gameState.h), so scores don't depend on the file.
+// Hands are put in a canonical form first: which suit is which doesn't change
+// how a hand can be arranged, so the suits are renamed in order of the cards
+// they hold, and every wild card of the round is the same, as is every joker.
+// Each round has two sections, hands of round + 2 cards (after discarding)
+// and of round + 3 (after drawing), each a sorted list of canonical hands
+// that is binary searched.
+class SolutionTable
+{
+   public:
+      // Last round the table covers, with 3 to 6 cards in a hand
+      static const int LAST_ROUND = 3;
+
+      // File the computer reads the table from
+      static const std::string DEFAULT_FILE_NAME;
+
+      // File format, all numbers in the byte order of the machine that made it:
+      //   0  magic "FCST"   4  version   5  last round   6  unused
+      //   8  for each round and then each hand size: count, offset (4 bytes each)
+      //   then each section at its offset: its keys (8 bytes each) and then
+      //   their entries (2 bytes each)
+      static const char MAGIC[4];
+      static const unsigned char VERSION = 1;
+      static const int HEADER_SIZE = 8 + LAST_ROUND * 2 * 8;
+
+      SolutionTable() = default;
+      ~SolutionTable();
+
+      SolutionTable(const SolutionTable &) = delete;
+      SolutionTable &operator=(const SolutionTable &) = delete;
+
+      // Map a table file into memory. Returns true if it could not be opened
+      // or is not a valid table (the table is then empty)
+      bool open(const std::string &fileName);
+
+      // Check if a table is open and covers a round
+      bool covers(int round) const;
+
+      // Find the value of the cards a hand of round + 2 cards is left with
+      // after its best arrangement. Returns false if the table doesn't cover it
+      bool deadwood(const unsigned char *ids, int size, int round, int &deadwood) const;
+
+      // Find the value of the cards a hand is left with, as above
+      bool deadwood(const Hand &hand, int round, int &deadwood) const;
+
+      // Find the card (index in ids) a hand of round + 3 cards does best to
+      // discard and what the rest is left with. Returns false if the table
+      // doesn't cover it
+      bool bestDiscard(const unsigned char *ids, int size, int round, int &index, int &deadwood) const;
+
+      // Find the card (index in the hand) a hand does best to discard, as above
+      bool bestDiscard(const Hand &hand, int round, int &index, int &deadwood) const;
+
+      // Solve every hand of the rounds covered and return the table file.
+      // threads is the number of threads to use (0 for one per core)
+      static std::string generate(unsigned threads = 0);
+
+      // The table read from DEFAULT_FILE_NAME the first time it's asked for,
+      // empty if there is no such file
+      static const SolutionTable &shared();
+
+   private:
+      // Most cards in a hand the table covers
+      static const int MAX_CARDS = LAST_ROUND + 3;
+
+      // Cards in the canonical form: natural cards keep their number and
+      // take their suit's new name, wild cards and jokers each get one code
+      static const int WILD_CODE = Card::FIRST_JOKER_ID;
+      static const int JOKER_CODE = WILD_CODE + 1;
+      static const int CODE_BITS = 6;
+
+      // An entry holds the value left in its low bits and, for hands after
+      // drawing, the position of the best discard in the canonical form above
+      static const int DEADWOOD_BITS = 12;
+      static const std::uint16_t NO_DISCARD = 15;
+
+      // The first and the last hand size of a round
+      static const int SIZES = 2;
+
+      // One section of the table
+      struct Section
+      {
+         const std::uint64_t *keys = nullptr;
+         const std::uint16_t *entries = nullptr;
+         std::uint32_t count = 0;
+      };
+
+      // Put a hand in canonical form: its key, and the index in ids of each
+      // card in the order of the key
+      static std::uint64_t canonicalKey(const unsigned char *ids, int size, int round, unsigned char order[]);
+
+      // Solve every canonical hand of size cards in a round into one section
+      static void solveSection(int round, int size, unsigned threads, std::string &keys, std::string &entries);
+
+      // Find a hand's entry. Returns false if the table doesn't cover it
+      bool find(const unsigned char *ids, int size, int round, unsigned char order[], std::uint16_t &entry) const;
+
+      // Release the mapped file
+      void close();
+
+      Section sections[LAST_ROUND][SIZES];
+
+      // The mapped file
+      void *data = nullptr;
+      size_t length = 0;
+};
+
+#endif
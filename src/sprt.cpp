@@ -0,0 +1,198 @@
+#include "sprt.h"
+#include <algorithm>   // std::max
+#include <cmath>       // std::log, std::sqrt
+
+/* *********************************************************************
+Function Name: Sprt()
+Purpose: Create a test for a margin and error rates
+Parameters:
+         double margin, the points a game the first strategy must score
+            less by to be better
+         double alpha, the chance of wrongly finding it better
+         double beta, the chance of wrongly finding it no better
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Store the margin
+         2) Set Wald's bounds: log(beta / (1 - alpha)) and
+            log((1 - beta) / alpha)
+Assistance Received: none
+********************************************************************* */
+Sprt::Sprt(double margin, double alpha, double beta)
+   : margin(margin), lower(std::log(beta / (1 - alpha))), upper(std::log((1 - beta) / alpha))
+{
+}
+
+/* *********************************************************************
+Function Name: add()
+Purpose: Add the score difference of a pair of games
+Parameters:
+         double difference, the first strategy's score less the second's
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Add it to the count, the sum, and the sum of squares
+Assistance Received: none
+********************************************************************* */
+void Sprt::add(double difference)
+{
+   this->pairs++;
+   this->sum += difference;
+   this->squares += difference * difference;
+}
+
+/* *********************************************************************
+Function Name: decide()
+Purpose: Find what the test has found so far
+Parameters:
+         none
+Return Value: a Decision, whether to keep playing or which hypothesis
+   holds
+Local Variables:
+         double ratio, the log likelihood ratio
+Algorithm:
+         1) Keep playing until MIN_PAIRS pairs are in
+         2) Accept H1 above the upper bound and H0 below the lower one
+Assistance Received: none
+********************************************************************* */
+Sprt::Decision Sprt::decide() const
+{
+   if (this->pairs < MIN_PAIRS)
+   {
+      return Decision::CONTINUE;
+   }
+
+   double ratio = logLikelihoodRatio();
+   if (ratio >= this->upper)
+   {
+      return Decision::ACCEPT_H1;
+   }
+   if (ratio <= this->lower)
+   {
+      return Decision::ACCEPT_H0;
+   }
+
+   return Decision::CONTINUE;
+}
+
+/* *********************************************************************
+Function Name: logLikelihoodRatio()
+Purpose: Find the log likelihood ratio of H1 over H0
+Parameters:
+         none
+Return Value: a double, the ratio (0 before there's a variance)
+Local Variables:
+         double deviation, the standard deviation of the differences
+         double variance, its square
+         double mu, the mean difference under H1 (-margin; 0 under H0)
+Algorithm:
+         1) For normal differences with the same variance, the ratio
+            sums to mu / variance * (sum - pairs * mu / 2)
+Assistance Received: none
+********************************************************************* */
+double Sprt::logLikelihoodRatio() const
+{
+   double deviation = standardDeviation();
+   if (deviation <= 0)
+   {
+      return 0;
+   }
+
+   double variance = deviation * deviation;
+   double mu = -this->margin;
+   return mu / variance * (this->sum - this->pairs * mu / 2);
+}
+
+/* *********************************************************************
+Function Name: lowerBound()
+Purpose: Get the ratio below which H0 is accepted
+Parameters:
+         none
+Return Value: a double, the bound
+Local Variables:
+         none
+Algorithm:
+         1) Return the bound
+Assistance Received: none
+********************************************************************* */
+double Sprt::lowerBound() const
+{
+   return this->lower;
+}
+
+/* *********************************************************************
+Function Name: upperBound()
+Purpose: Get the ratio above which H1 is accepted
+Parameters:
+         none
+Return Value: a double, the bound
+Local Variables:
+         none
+Algorithm:
+         1) Return the bound
+Assistance Received: none
+********************************************************************* */
+double Sprt::upperBound() const
+{
+   return this->upper;
+}
+
+/* *********************************************************************
+Function Name: count()
+Purpose: Get the number of pairs added
+Parameters:
+         none
+Return Value: an int, the pairs
+Local Variables:
+         none
+Algorithm:
+         1) Return the count
+Assistance Received: none
+********************************************************************* */
+int Sprt::count() const
+{
+   return this->pairs;
+}
+
+/* *********************************************************************
+Function Name: mean()
+Purpose: Get the mean score difference
+Parameters:
+         none
+Return Value: a double, the mean (0 before any pair)
+Local Variables:
+         none
+Algorithm:
+         1) Divide the sum by the count
+Assistance Received: none
+********************************************************************* */
+double Sprt::mean() const
+{
+   return this->pairs == 0 ? 0 : this->sum / this->pairs;
+}
+
+/* *********************************************************************
+Function Name: standardDeviation()
+Purpose: Get the standard deviation of the score differences
+Parameters:
+         none
+Return Value: a double, the sample standard deviation (0 before two
+   pairs)
+Local Variables:
+         double variance, the sample variance
+Algorithm:
+         1) Find the sample variance from the sums, and its square root
+Assistance Received: none
+********************************************************************* */
+double Sprt::standardDeviation() const
+{
+   if (this->pairs < 2)
+   {
+      return 0;
+   }
+
+   double variance = (this->squares - this->sum * this->sum / this->pairs) / (this->pairs - 1);
+   return std::sqrt(std::max(variance, 0.0));
+}
@@ -0,0 +1,63 @@
+#ifndef SPRT_H
+#define SPRT_H
+
+// Sequential probability ratio test on the score differences of pairs of
+// games (see SelfPlay::MatchResult::pairDifferences), so a match can stop as
+// soon as it's clear whether one strategy is better than another.
+// It tests whether the first strategy scores margin points a game less than
+// the second (H1) against scoring the same (H0), taking the differences as
+// normal with the variance seen so far. The log likelihood ratio is compared
+// with bounds set by the error rates wanted, as Wald's test does.
+class Sprt
+{
+   public:
+      // What the test has found
+      enum class Decision {
+         // Keep playing
+         CONTINUE = 0,
+
+         // The first strategy is no better by the margin
+         ACCEPT_H0,
+
+         // The first strategy is better by the margin
+         ACCEPT_H1
+      };
+
+      // Pairs played before the test decides anything, so the variance
+      // has something to go on
+      static const int MIN_PAIRS = 20;
+
+      // Test for margin points a game, wrongly finding the first strategy
+      // better at most alpha of the time and wrongly finding it no better
+      // at most beta of the time
+      Sprt(double margin, double alpha, double beta);
+
+      // Add the score difference (first less second) of a pair of games
+      void add(double difference);
+
+      // What the test has found so far
+      Decision decide() const;
+
+      // The log likelihood ratio of H1 over H0 so far
+      double logLikelihoodRatio() const;
+
+      // The ratio below which H0 is accepted, and above which H1 is
+      double lowerBound() const;
+      double upperBound() const;
+
+      // The pairs added, and the mean and standard deviation of their differences
+      int count() const;
+      double mean() const;
+      double standardDeviation() const;
+
+   private:
+      double margin;
+      double lower;
+      double upper;
+
+      int pairs = 0;
+      double sum = 0;
+      double squares = 0;
+};
+
+#endif
@@ -0,0 +1,277 @@
+#include "strategy.h"
+#include <algorithm>   // std::min, std::max
+#include <cstdlib>     // std::abs, std::strtof
+#include <sstream>     // std::ostringstream, std::istringstream
+
+const Strategy::Range Strategy::RANGES[Strategy::SIZE] = {
+   { "drawSlack", 0.0f, -2.0f, 2.0f, 0.5f },
+   { "remainingWeight", 0.0f, 0.0f, 1.0f, 0.25f },
+   { "booksFirstBias", 0.0f, -2.0f, 2.0f, 0.5f }
+};
+
+namespace
+{
+   // Furthest apart two cards of a suit can be and still be part of a run
+   // without wild cards (a partial run waiting for the card between them)
+   const int RUN_GAP = 2;
+
+   // Check if a card can only be a single card in a hand's arrangement: it
+   // isn't wild, the hand holds no wild cards to build around it, and it
+   // makes no book or run, or even the start of one, with any card in the
+   // hand. Adding it then leaves one more single and remaining card
+   bool onlyAddsSingle(const Hand &hand, const Card &card)
+   {
+      if (card.isWild())
+      {
+         return false;
+      }
+
+      int number = card.getId() % Card::NUMBER_OF_NUMBERS;
+      int suit = card.getId() / Card::NUMBER_OF_NUMBERS;
+      for (const Card &held : hand)
+      {
+         int heldNumber = held.getId() % Card::NUMBER_OF_NUMBERS;
+         if (held.isWild() || heldNumber == number
+            || (held.getId() / Card::NUMBER_OF_NUMBERS == suit && std::abs(heldNumber - number) <= RUN_GAP))
+         {
+            return false;
+         }
+      }
+
+      return true;
+   }
+}
+
+/* *********************************************************************
+Function Name: Strategy()
+Purpose: Create a strategy that plays like the computer always has
+Parameters:
+         none
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Set every parameter to its default
+Assistance Received: none
+********************************************************************* */
+Strategy::Strategy()
+{
+   for (int i = 0; i < SIZE; i++)
+   {
+      this->values[i] = RANGES[i].defaultValue;
+   }
+}
+
+/* *********************************************************************
+Function Name: get()
+Purpose: Get a parameter
+Parameters:
+         int parameter, which one (see Parameter)
+Return Value: a float, its value
+Local Variables:
+         none
+Algorithm:
+         1) Return the value
+Assistance Received: none
+********************************************************************* */
+float Strategy::get(int parameter) const
+{
+   return this->values[parameter];
+}
+
+/* *********************************************************************
+Function Name: set()
+Purpose: Set a parameter, kept in its range
+Parameters:
+         int parameter, which one (see Parameter)
+         float value, its new value
+Return Value: none
+Local Variables:
+         none
+Algorithm:
+         1) Clamp the value to the parameter's range and store it
+Assistance Received: none
+********************************************************************* */
+void Strategy::set(int parameter, float value)
+{
+   this->values[parameter] = std::min(std::max(value, RANGES[parameter].minimum), RANGES[parameter].maximum);
+}
+
+/* *********************************************************************
+Function Name: toString()
+Purpose: Write the parameters so parse() can read them back
+Parameters:
+         none
+Return Value: a string, "name=value,name=value,..."
+Local Variables:
+         ostringstream text, the parameters written so far
+Algorithm:
+         1) Write each parameter's name and value, separated by commas
+Assistance Received: none
+********************************************************************* */
+std::string Strategy::toString() const
+{
+   std::ostringstream text;
+   for (int i = 0; i < SIZE; i++)
+   {
+      text << (i == 0 ? "" : ",") << RANGES[i].name << "=" << this->values[i];
+   }
+
+   return text.str();
+}
+
+/* *********************************************************************
+Function Name: parse()
+Purpose: Set the parameters named in a string
+Parameters:
+         const string &text, "name=value,name=value,..."
+Return Value: a bool, true if text could not be read (nothing is set)
+Local Variables:
+         Strategy parsed, the strategy with the values read so far
+         istringstream fields, the text split at commas
+         string field, one "name=value"
+         size_t equals, where the name ends
+         int parameter, the parameter named
+Algorithm:
+         1) Split the text at commas, and each field at its equals sign
+         2) Find the parameter by its name and read its value
+         3) Fail on an unknown name or a value that isn't a number
+         4) Keep the values only if every field was read
+Assistance Received: none
+********************************************************************* */
+bool Strategy::parse(const std::string &text)
+{
+   Strategy parsed = *this;
+   std::istringstream fields(text);
+   std::string field;
+   while (std::getline(fields, field, ','))
+   {
+      size_t equals = field.find('=');
+      if (equals == std::string::npos)
+      {
+         return true;
+      }
+
+      int parameter = 0;
+      while (parameter < SIZE && field.compare(0, equals, RANGES[parameter].name) != 0)
+      {
+         parameter++;
+      }
+
+      const char *value = field.c_str() + equals + 1;
+      char *end;
+      float number = std::strtof(value, &end);
+      if (parameter == SIZE || end == value || *end != '\0')
+      {
+         return true;
+      }
+
+      parsed.set(parameter, number);
+   }
+
+   *this = parsed;
+   return false;
+}
+
+/* *********************************************************************
+Function Name: arrange()
+Purpose: Make combinations from cards in the order the strategy prefers
+Parameters:
+         const vector<Card> &cards, the cards
+Return Value: a CombinationFinder, holding the books, runs, and remaining
+   cards
+Local Variables:
+         CombinationFinder finder, makes the combinations
+Algorithm:
+         1) Make combinations books first and runs first, keeping books
+            first if it leaves the bias fewer single cards
+Assistance Received: none
+********************************************************************* */
+CombinationFinder Strategy::arrange(const std::vector<Card> &cards) const
+{
+   CombinationFinder finder(cards);
+   finder.findBestCombinations(this->values[BOOKS_FIRST_BIAS]);
+
+   return finder;
+}
+
+/* *********************************************************************
+Function Name: shouldDrawFromDiscard()
+Purpose: Check if a hand should draw the top of the discard pile
+Parameters:
+         const Hand &hand, the cards in the hand
+         const Card &topOfDiscard, the card on top of the discard pile
+Return Value: a bool, true if the discard pile should be drawn from
+Local Variables:
+         vector<Card> cards, the hand
+         CombinationFinder finder, the hand arranged
+         float current, what the hand leaves
+         float withDiscard, what the hand plus the discard card leaves
+Algorithm:
+         1) Arrange the hand
+         2) If the discard card can only be a single card, it leaves one
+            more single and remaining card. Otherwise arrange the hand
+            with it
+         3) Draw it if it doesn't leave more than the slack more cards
+            (by default, if it doesn't leave more single cards)
+Assistance Received: none
+********************************************************************* */
+bool Strategy::shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard) const
+{
+   std::vector<Card> cards(hand.begin(), hand.end());
+   CombinationFinder finder = arrange(cards);
+   float current = leftOver(finder.getNumberOfSingleCards(), finder.getNumberOfRemainingCards());
+
+   float withDiscard;
+   if (onlyAddsSingle(hand, topOfDiscard))
+   {
+      withDiscard = leftOver(finder.getNumberOfSingleCards() + 1, finder.getNumberOfRemainingCards() + 1);
+   }
+   else
+   {
+      cards.insert(cards.begin(), topOfDiscard);
+      CombinationFinder withFinder = arrange(cards);
+      withDiscard = leftOver(withFinder.getNumberOfSingleCards(), withFinder.getNumberOfRemainingCards());
+   }
+
+   return withDiscard <= current + this->values[DRAW_SLACK];
+}
+
+/* *********************************************************************
+Function Name: worstCard()
+Purpose: Find the card a hand should discard
+Parameters:
+         const Hand &hand, the cards in the hand
+Return Value: a pair<string, string>, the card and the reason for it
+Local Variables:
+         CombinationFinder finder, the hand arranged
+Algorithm:
+         1) Arrange the hand
+         2) Return its worst card
+Assistance Received: none
+********************************************************************* */
+std::pair<std::string, std::string> Strategy::worstCard(const Hand &hand) const
+{
+   CombinationFinder finder = arrange(std::vector<Card>(hand.begin(), hand.end()));
+   return finder.findWorstCard();
+}
+
+/* *********************************************************************
+Function Name: leftOver()
+Purpose: Count how many cards an arrangement leaves from its counts
+Parameters:
+         int singleCards, the single cards it leaves
+         int remainingCards, the cards it leaves in no book or run
+Return Value: a float, the single cards and the remaining cards weighed
+   by REMAINING_WEIGHT
+Local Variables:
+         float weight, the weight of the remaining cards
+Algorithm:
+         1) Blend the two counts
+Assistance Received: none
+********************************************************************* */
+float Strategy::leftOver(int singleCards, int remainingCards) const
+{
+   float weight = this->values[REMAINING_WEIGHT];
+   return (1 - weight) * singleCards + weight * remainingCards;
+}
@@ -0,0 +1,80 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include "combinationFinder.h"
+#include "hand.h"
+#include <string>
+#include <utility>         // std::pair
+
+// The knobs of the computer's rule of thumb for drawing (see
+// Computer::chooseDraw(), which uses it at Difficulty::HEURISTIC and when
+// there's no time to search) as a vector of numbers, so the tune tool (see
+// tune.cpp) can search for better ones by self-play (see SelfPlay). Discards
+// are chosen by DiscardScorer and the searches, which have no knobs here.
+// The defaults draw as the computer always has, and are what the human's
+// hints use (see Computer::findHint()).
+class Strategy
+{
+   public:
+      // The parameters, in the order of the vector
+      enum Parameter {
+         // Single cards the discard card may add and still be drawn
+         DRAW_SLACK = 0,
+
+         // How much the draw is decided by the cards left that no wild card
+         // can use (1) rather than by the single cards (0)
+         REMAINING_WEIGHT,
+
+         // How many fewer single cards books first must leave to be kept
+         // over runs first (see CombinationFinder::findBestCombinations())
+         BOOKS_FIRST_BIAS,
+
+         SIZE
+      };
+
+      // Name, default, range, and the step the tuner starts from, of each parameter
+      struct Range
+      {
+         const char *name;
+         float defaultValue;
+         float minimum;
+         float maximum;
+         float step;
+      };
+
+      static const Range RANGES[SIZE];
+
+      // A strategy with every parameter at its default
+      Strategy();
+
+      // Get a parameter
+      float get(int parameter) const;
+
+      // Set a parameter, kept in its range
+      void set(int parameter, float value);
+
+      // The parameters as "name=value,name=value,..."
+      std::string toString() const;
+
+      // Set the parameters named in text, as written by toString() (any left
+      // out keep their value). Returns true if text could not be read
+      bool parse(const std::string &text);
+
+      // Make combinations from the cards in the order the strategy prefers
+      CombinationFinder arrange(const std::vector<Card> &cards) const;
+
+      // Check if a hand should draw the top of the discard pile
+      bool shouldDrawFromDiscard(const Hand &hand, const Card &topOfDiscard) const;
+
+      // Find the card a hand should discard and why
+      std::pair<std::string, std::string> worstCard(const Hand &hand) const;
+
+   private:
+      // How many cards an arrangement with these single and remaining cards
+      // leaves, weighing them by REMAINING_WEIGHT
+      float leftOver(int singleCards, int remainingCards) const;
+
+      float values[SIZE];
+};
+
+#endif
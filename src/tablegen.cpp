@@ -0,0 +1,66 @@
+/************************************************************
+* Solves every hand of the first rounds and writes the table the
+* computer looks them up in (see solutionTable.h).
+*
+* Usage: tablegen [-j threads] [file]
+*    -j threads   number of threads to use (default: one per core)
+*    file         where to write the table (default: fivecrowns.tbl,
+*                 which is where the computer looks for it)
+************************************************************/
+
+#include "solutionTable.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+   unsigned threads = 0;
+   std::string fileName = SolutionTable::DEFAULT_FILE_NAME;
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if (argument == "-j" && i + 1 < argc)
+      {
+         threads = std::atoi(argv[++i]);
+      }
+      else if (argument[0] == '-')
+      {
+         std::cerr << "Usage: " << argv[0] << " [-j threads] [file]\n";
+         return EXIT_FAILURE;
+      }
+      else
+      {
+         fileName = argument;
+      }
+   }
+
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   std::string table = SolutionTable::generate(threads);
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+   std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+   if (!file.write(table.data(), table.size()))
+   {
+      std::cerr << "Could not write " << fileName << "\n";
+      return EXIT_FAILURE;
+   }
+   file.close();
+
+   // Read it back the way the game will
+   SolutionTable check;
+   if (check.open(fileName))
+   {
+      std::cerr << fileName << " was written but could not be read back\n";
+      return EXIT_FAILURE;
+   }
+
+   std::cout << "Wrote " << fileName << ": rounds 1-" << SolutionTable::LAST_ROUND << ", " << table.size() << " bytes in "
+      << elapsed.count() << " s\n";
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/************************************************************
+* Tunes the parameters of the computer's rule of thumb (see strategy.h)
+* by self-play with SPSA (simultaneous perturbation stochastic
+* approximation): each iteration nudges every parameter up or down at
+* random, plays the computer with the strategy nudged one way against the
+* one with it nudged the other way on the same deals (see selfPlay.h), and
+* moves the parameters against the score difference. Finally the tuned
+* computer plays the defaults, and the parameters are printed for the
+* game's -p option.
+*
+* Usage: tune [-i iterations] [-g pairs] [-v pairs] [-a gain] [-s seed]
+*             [-j threads] [-p parameters] [-d difficulty]
+*    -i iterations   SPSA iterations (default: 50)
+*    -g pairs        deals per iteration, each played from both seats
+*                    (default: 50)
+*    -v pairs        deals the tuned strategy plays the defaults on
+*                    (default: 200)
+*    -a gain         steps a parameter moves per point of score
+*                    difference in the first iteration (default: 0.2)
+*    -s seed         seed of the deals and the nudges (default: 1)
+*    -j threads      number of threads to use (default: one per core)
+*    -p parameters   where to start, "name=value,..." (default: the
+*                    computer's parameters)
+*    -d difficulty   how long both computers think, 0 to 3 as the game's
+*                    -d (default: 0). The strategy decides every draw at 0,
+*                    and only those there's no time to search above it
+************************************************************/
+
+#include "selfPlay.h"
+#include "strategy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+// SPSA's usual decay exponents of the gain and of the nudge
+static const double GAIN_DECAY = 0.602;
+static const double NUDGE_DECAY = 0.101;
+
+// Most steps a parameter moves in one iteration, so one lucky match
+// can't throw it across its range
+static const double MAX_MOVE = 1.0;
+
+int main(int argc, char *argv[])
+{
+   int iterations = 50;
+   int pairs = 50;
+   int verifyPairs = 200;
+   double gain = 0.2;
+   unsigned seed = 1;
+   unsigned threads = 0;
+   Strategy strategy;
+   Difficulty difficulty = Difficulty::HEURISTIC;
+
+   for (int i = 1; i < argc; i++)
+   {
+      std::string argument = argv[i];
+      if (argument == "-i" && i + 1 < argc)
+      {
+         iterations = std::atoi(argv[++i]);
+      }
+      else if (argument == "-g" && i + 1 < argc)
+      {
+         pairs = std::max(1, std::atoi(argv[++i]));
+      }
+      else if (argument == "-v" && i + 1 < argc)
+      {
+         verifyPairs = std::atoi(argv[++i]);
+      }
+      else if (argument == "-a" && i + 1 < argc)
+      {
+         gain = std::atof(argv[++i]);
+      }
+      else if (argument == "-s" && i + 1 < argc)
+      {
+         seed = std::strtoul(argv[++i], nullptr, 10);
+      }
+      else if (argument == "-j" && i + 1 < argc)
+      {
+         threads = std::atoi(argv[++i]);
+      }
+      else if (argument == "-p" && i + 1 < argc && !strategy.parse(argv[i + 1]))
+      {
+         i++;
+      }
+      else if (argument == "-d" && i + 1 < argc && std::atoi(argv[i + 1]) >= static_cast<int>(Difficulty::HEURISTIC)
+         && std::atoi(argv[i + 1]) <= static_cast<int>(Difficulty::HARD))
+      {
+         difficulty = static_cast<Difficulty>(std::atoi(argv[++i]));
+      }
+      else
+      {
+         std::cerr << "Usage: " << argv[0] << " [-i iterations] [-g pairs] [-v pairs] [-a gain] [-s seed] [-j threads] [-p parameters]"
+            << " [-d difficulty]\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   std::cout << "start: " << strategy.toString() << "\n";
+
+   // Parameters are moved in units of their step, so one gain suits them all
+   std::mt19937 generator(seed);
+   std::bernoulli_distribution coin(0.5);
+   double stability = iterations / 10.0;
+   for (int k = 0; k < iterations; k++)
+   {
+      double gainK = gain / std::pow(k + 1 + stability, GAIN_DECAY) * std::pow(1 + stability, GAIN_DECAY);
+      double nudgeK = 1.0 / std::pow(k + 1, NUDGE_DECAY);
+
+      // Nudge every parameter at once
+      int signs[Strategy::SIZE];
+      Strategy plus = strategy;
+      Strategy minus = strategy;
+      for (int p = 0; p < Strategy::SIZE; p++)
+      {
+         signs[p] = coin(generator) ? 1 : -1;
+         float nudge = nudgeK * signs[p] * Strategy::RANGES[p].step;
+         plus.set(p, strategy.get(p) + nudge);
+         minus.set(p, strategy.get(p) - nudge);
+      }
+
+      // Both play the same deals, so the difference is mostly the nudge's
+      SelfPlay::MatchResult match = SelfPlay({ plus, difficulty }, { minus, difficulty }).playMatch(pairs, generator(), threads);
+
+      // Lower scores are better, so move against the difference
+      for (int p = 0; p < Strategy::SIZE; p++)
+      {
+         double gradient = match.meanDifference / (2 * nudgeK * signs[p]);
+         double move = std::max(-MAX_MOVE, std::min(MAX_MOVE, gainK * gradient));
+         strategy.set(p, strategy.get(p) - move * Strategy::RANGES[p].step);
+      }
+
+      std::cout << std::fixed << std::setprecision(2) << "iteration " << k + 1 << ": difference " << match.meanDifference
+         << " +/- " << match.standardError << ", " << match.games / match.seconds << " games/s, "
+         << std::defaultfloat << strategy.toString() << "\n";
+   }
+
+   if (verifyPairs > 0)
+   {
+      SelfPlay::MatchResult match = SelfPlay({ strategy, difficulty }, { Strategy(), difficulty }).playMatch(verifyPairs, generator(), threads);
+      std::cout << std::fixed << std::setprecision(2) << "against the defaults over " << match.games << " games: "
+         << match.wins << " won, " << match.losses << " lost, " << match.draws << " drawn, "
+         << match.meanDifference << " +/- " << match.standardError << " points a game ("
+         << match.games / match.seconds << " games/s)\n";
+   }
+
+   std::cout << "tuned: " << strategy.toString() << "\n";
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+#include "zobrist.h"
+
+/* *********************************************************************
+Function Name: makeKeys()
+Purpose: Create every key from a fixed seed
+Parameters:
+         none
+Return Value: a Keys, the keys
+Local Variables:
+         Keys keys, the keys being created
+         unsigned long long state, the generator's state
+         auto next, returns the next random number
+Algorithm:
+         1) Step a splitmix64 generator once for each key (it's simple
+            enough to run at compile time and its numbers are well mixed)
+Assistance Received: none
+********************************************************************* */
+constexpr Zobrist::Keys Zobrist::makeKeys()
+{
+   Keys keys = Keys();
+   unsigned long long state = 0x46495645435257ULL;
+
+   auto next = [&state]()
+   {
+      state += 0x9E3779B97F4A7C15ULL;
+      unsigned long long value = state;
+      value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+      return value ^ (value >> 31);
+   };
+
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+      {
+         for (int copy = 0; copy < MAX_COPIES; copy++)
+         {
+            keys.hand[player][id][copy] = next();
+         }
+      }
+   }
+
+   for (int id = 0; id < Card::NUMBER_OF_IDS; id++)
+   {
+      keys.discardTop[id] = next();
+   }
+
+   for (int round = 0; round < ROUNDS; round++)
+   {
+      keys.round[round] = next();
+   }
+
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      keys.playerToMove[player] = next();
+   }
+
+   for (int phase = 0; phase < PHASES; phase++)
+   {
+      keys.phase[phase] = next();
+   }
+
+   keys.lastTurn = next();
+
+   return keys;
+}
+
+const Zobrist::Keys Zobrist::KEYS = Zobrist::makeKeys();
+
+/* *********************************************************************
+Function Name: hash()
+Purpose: Hash a whole state from scratch
+Parameters:
+         const GameState &state, the state
+Return Value: an unsigned long long, the hash
+Local Variables:
+         unsigned long long hash, the hash so far
+         int copies[], how many of each card were seen in the hand so far
+Algorithm:
+         1) Start with the keys of the round, the turn, and the top of the
+            discard pile
+         2) Add the key of each card in each hand, the first copy of a
+            card taking the first key and the second the second
+Assistance Received: none
+********************************************************************* */
+unsigned long long Zobrist::hash(const GameState &state)
+{
+   unsigned long long hash = roundKey(state.round) ^ turnKey(state) ^ discardTopKey(state);
+
+   for (int player = 0; player < GameState::PLAYER_COUNT; player++)
+   {
+      int copies[Card::NUMBER_OF_IDS] = { 0 };
+      for (int i = 0; i < state.handSizes[player]; i++)
+      {
+         int id = state.hands[player][i];
+         hash ^= handKey(player, id, copies[id]++);
+      }
+   }
+
+   return hash;
+}
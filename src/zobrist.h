@@ -0,0 +1,67 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "gameState.h"
+
+// Random 64-bit keys for hashing a GameState. The hash of a state is the XOR
+// of the keys of each card in each hand, the top of the discard pile, the
+// round, and the turn, so it can be updated as cards move instead of being
+// computed again. The draw pile and the discard pile under its top are hidden
+// from the players and left out, so positions that look the same to them
+// hash the same.
+class Zobrist
+{
+   public:
+      // A hand holds at most two of a card, each copy has its own key so
+      // both copies don't cancel out
+      static const int MAX_COPIES = 2;
+
+      // Hash a whole state from scratch
+      static unsigned long long hash(const GameState &state);
+
+      // Key of the copy-th copy (0 or 1) of card id in a player's hand
+      static unsigned long long handKey(int player, int id, int copy)
+      {
+         return KEYS.hand[player][id][copy];
+      }
+
+      // Key of the top of the discard pile, 0 when the pile is empty
+      static unsigned long long discardTopKey(const GameState &state)
+      {
+         return state.discardSize == 0 ? 0 : KEYS.discardTop[state.discardPile[state.discardSize - 1]];
+      }
+
+      // Key of the player to move, the phase, and whether it's a last turn
+      static unsigned long long turnKey(const GameState &state)
+      {
+         return KEYS.playerToMove[state.playerToMove] ^ KEYS.phase[static_cast<int>(state.phase)] ^ (state.lastTurn ? KEYS.lastTurn : 0);
+      }
+
+      // Key of the round, which also sets the wild card
+      static unsigned long long roundKey(int round)
+      {
+         return KEYS.round[round];
+      }
+
+   private:
+      static const int ROUNDS = 12;
+      static const int PHASES = 3;
+
+      struct Keys
+      {
+         unsigned long long hand[GameState::PLAYER_COUNT][Card::NUMBER_OF_IDS][MAX_COPIES];
+         unsigned long long discardTop[Card::NUMBER_OF_IDS];
+         unsigned long long round[ROUNDS];
+         unsigned long long playerToMove[GameState::PLAYER_COUNT];
+         unsigned long long phase[PHASES];
+         unsigned long long lastTurn;
+      };
+
+      // Fill the keys at compile time from a fixed seed, so hashes are the
+      // same from run to run and can be stored
+      static constexpr Keys makeKeys();
+
+      static const Keys KEYS;
+};
+
+#endif